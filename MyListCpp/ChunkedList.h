@@ -0,0 +1,525 @@
+/**
+ *  Summary: Class that represents an immutable list of items stored in fixed size chunks (unrolled linked list).
+ *  Same persistent semantics as ImmutableList, but consecutive items are contiguous in memory so scans run over arrays.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include<atomic>
+#include<iterator>
+#include<memory>
+#include<type_traits>
+#include<vector>
+
+#include "IEnumerable.h"
+#include "Pipeline.h"
+#include "Enumerator/IEnumerator.h"
+#include "Exception/MyExceptions.h"
+#include "Memory/RawBuffer.h"
+#include "Memory/Reclaimer.h"
+
+#define CHUNK_BYTES 256
+
+namespace MyList{
+	using namespace Enumerator;
+
+	template<class T>
+	class IEnumerable;
+
+	template<class TStage>
+	class Pipeline;
+
+	/**
+	 * \brief Class that represents an immutable list of items stored in fixed size chunks.
+	 * A chunk fills from its end towards its start. Prepend writes into the free slot in front of the head when no other
+	 * list has claimed it yet, otherwise starts a new chunk pointing at the old one, so prepend stays O(1) and tails are shared.
+	 * \tparam T Type of item to be stored in list.
+	 */
+	template<class T>
+	class ChunkedList : public IEnumerable < T >
+	{
+	private:
+		class Chunk;
+		class ChunkStage;
+
+	public:
+		/**
+		 * \brief Instantiates an empty list;
+		 */
+		ChunkedList() : mLength(0), mChunk(nullptr), mOffset(0) {}
+
+		/**
+		 * \brief Initializes new list from array of values.
+		 * \param input pointer to input array
+		 * \param length length of input array
+		 */
+		ChunkedList(const T * input, int length);
+
+		/**
+		 * \brief Initializes new list from another IEnumerable
+		 * \param list pointer to IEnumerable
+		 */
+		ChunkedList(const IEnumerable<T> * list);
+
+		/**
+		 * \brief Initializes new list from a head and tail list
+		 * \param head of the new list
+		 * \param tail of the new list
+		 */
+		ChunkedList(T head, const ChunkedList & tail);
+
+		/**
+		 * \brief Get the tail of the list.
+		 * \return New ChunkedList pointing to tail, copy of this if list is empty
+		 */
+		ChunkedList getTail() const;
+
+		/**
+		 * \brief get the head of the list
+		 * \return the head
+		 */
+		T getHead() const;
+
+		/**
+		 * \brief get the length of the list
+		 * \return integer length
+		 */
+		int getLength() const { return mLength; }
+
+		/**
+		 * \brief Gets enumerator for the list
+		 * \return IEnumerator
+		 */
+		std::shared_ptr<IEnumerator<T> > getEnumerator() const override;
+
+		/**
+		 * \brief Prepend value to list
+		 * \param value of new head
+		 * \return New ChunkedList
+		 */
+		inline ChunkedList prepend(T value) const{
+			return ChunkedList(value, *this);
+		}
+
+		/**
+		 * \brief Reverse the list
+		 * \return New ChunkedList
+		 */
+		ChunkedList reverse() const;
+
+		/**
+		 * \brief Map this list to another, evaluated as a fused pipeline.
+		 * \tparam TDest Type of item destination list
+		 * \tparam TFunc Type of map callable, any function, lambda or functor taking T.
+		 * \param func Map callable
+		 * \return Pipeline of mapped values.
+		 */
+		template<typename TDest, typename TFunc>
+		Pipeline<Stage::MapStage<ChunkStage, TDest, TFunc> > map(TFunc func) const
+		{
+			return pipeline().template map<TDest>(func);
+		}
+
+		/**
+		 * \brief Filter list, evaluated as a fused pipeline.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate used to filter items
+		 * \return Pipeline of filtered values.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::FilterStage<ChunkStage, TPredicate> > filter(TPredicate predicate) const
+		{
+			return pipeline().filter(predicate);
+		}
+
+		/**
+		 * \brief Take the first count items, evaluated as a fused pipeline.
+		 * \param count Maximum number of items
+		 * \return Pipeline of at most count items.
+		 */
+		Pipeline<Stage::TakeStage<ChunkStage> > take(int count) const
+		{
+			return pipeline().take(count);
+		}
+
+		/**
+		 * \brief Take leading items while they satisfy a predicate, evaluated as a fused pipeline.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate items must satisfy
+		 * \return Pipeline of the leading items satisfying predicate.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::TakeWhileStage<ChunkStage, TPredicate> > takeWhile(TPredicate predicate) const
+		{
+			return pipeline().takeWhile(predicate);
+		}
+
+		/**
+		 * \brief Drop the first count items, evaluated as a fused pipeline.
+		 * \param count Number of items to drop
+		 * \return Pipeline of the items after the first count.
+		 */
+		Pipeline<Stage::SkipStage<ChunkStage> > skip(int count) const
+		{
+			return pipeline().skip(count);
+		}
+
+		/**
+		 * \brief Aggregate values in the list without going through an enumerator.
+		 * \tparam TDest Aggregate value type
+		 * \tparam TFunc Type of aggregate callable taking (TDest, T).
+		 * \param initial Initial value
+		 * \param func Aggregate callable
+		 * \return Aggregate value
+		 */
+		template<typename TDest, typename TFunc>
+		TDest foldLeft(TDest initial, TFunc func) const
+		{
+			return pipeline().foldLeft(std::move(initial), func);
+		}
+
+	private:
+		int mLength;
+
+		/**
+		 * \brief Chunk holding the head, nullptr for empty list.
+		 */
+		std::shared_ptr<Chunk> mChunk;
+
+		/**
+		 * \brief Slot of the head in mChunk.
+		 */
+		int mOffset;
+
+		/**
+		 * \brief Initialize new ChunkedList from internal chunk.
+		 * \param chunk Chunk holding the head
+		 * \param offset Slot of the head
+		 * \param length of list starting at that slot
+		 */
+		ChunkedList(const std::shared_ptr<Chunk> & chunk, int offset, int length) : mLength(length), mChunk(chunk), mOffset(offset){}
+
+		/**
+		 * \brief Get pipeline with this list as its source.
+		 * \return Pipeline<ChunkStage>
+		 */
+		Pipeline<ChunkStage> pipeline() const
+		{
+			return Pipeline<ChunkStage>(ChunkStage(mChunk, mOffset, mLength));
+		}
+
+		/**
+		 * \brief Collect every item of an enumerator, trivially copyable items a block at a time through uninitialized slots.
+		 * \param enumerator Source
+		 * \param values Vector to append to
+		 */
+		static void collect(IEnumerator<T> & enumerator, std::vector<T> & values, std::true_type);
+
+		/**
+		 * \brief Collect every item of an enumerator one at a time, so T needs no default constructor.
+		 * \param enumerator Source
+		 * \param values Vector to append to
+		 */
+		static void collect(IEnumerator<T> & enumerator, std::vector<T> & values, std::false_type);
+
+		/**
+		 * \brief Put value in front of the list given by chunk and offset, and point them at it.
+		 * \param chunk Chunk holding the head, replaced if a new chunk is needed.
+		 * \param offset Slot of the head, updated.
+		 * \param value Value of new head
+		 */
+		static void pushFront(std::shared_ptr<Chunk> & chunk, int & offset, const T & value);
+
+		/**
+		 * \brief Build new list from values in list order.
+		 * \param values Items, first item becomes the head.
+		 * \param length Number of items
+		 * \return New ChunkedList
+		 */
+		static ChunkedList fromArray(const T * values, int length);
+
+		/**
+		 * \brief Fixed size block of items, filled from the last slot towards the first.
+		 */
+		class Chunk
+		{
+		public:
+			/**
+			 * \brief Number of slots, about CHUNK_BYTES of items.
+			 */
+			enum { Capacity = sizeof(T) * 4 >= CHUNK_BYTES ? 4 : CHUNK_BYTES / sizeof(T) };
+
+			/**
+			 * \brief Initializes empty chunk in front of a tail.
+			 * \param tail Chunk holding the rest of the list
+			 * \param tailOffset Slot of the first item of the rest in tail
+			 */
+			Chunk(const std::shared_ptr<Chunk> & tail, int tailOffset) : first(Capacity), tail(tail), tailOffset(tailOffset){}
+
+			/**
+			 * \brief Destroy items, then unlink uniquely owned tails one at a time like ImmutableList nodes.
+			 */
+			~Chunk()
+			{
+				T * values = items();
+				for (int i = first; i < Capacity; ++i)
+				{
+					values[i].~T();
+				}
+
+				std::shared_ptr<Chunk> next(std::move(tail));
+				if (next.use_count() != 1) return;
+
+				Memory::Reclaimer & reclaimer = Memory::Reclaimer::getDefault();
+				const int inlineLimit = reclaimer.getInlineLimit();
+				int freed = 0;
+				while (next.use_count() == 1)
+				{
+					freed += Capacity;
+					if (inlineLimit > 0 && freed >= inlineLimit && reclaimer.tryDefer(next)) return;
+					next = std::move(next->tail);
+				}
+			}
+
+			/**
+			 * \brief Get slots as items.
+			 * \return Pointer to slot 0
+			 */
+			T * items()
+			{
+				return reinterpret_cast<T *>(mStorage);
+			}
+
+			/**
+			 * \brief Claim the free slot in front of offset, if nobody has claimed it yet.
+			 * \param offset Slot of the current head, must be greater than 0.
+			 * \return True if slot offset - 1 now belongs to the caller.
+			 */
+			bool tryClaim(int offset)
+			{
+				int expected = offset;
+				return first.compare_exchange_strong(expected, offset - 1);
+			}
+
+			/**
+			 * \brief First used slot, slots [first, Capacity) hold items.
+			 */
+			std::atomic<int> first;
+
+			std::shared_ptr<Chunk> tail;
+
+			int tailOffset;
+
+		private:
+			Chunk(const Chunk & other);
+			Chunk & operator=(const Chunk & other);
+
+			typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type mStorage[Capacity];
+		};
+
+		/**
+		 * \brief Pipeline source stage over the chunks, runs a plain array loop over every chunk.
+		 * The root pointer keeps every chunk alive.
+		 */
+		class ChunkStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef T value_type;
+
+			/**
+			 * \brief Items are read in place
+			 */
+			typedef const T & reference;
+
+			/**
+			 * \brief Type of source stage at the start of the chain
+			 */
+			typedef ChunkStage origin_type;
+
+			/**
+			 * \brief Length is known, chunks are only reached by walking
+			 */
+			typedef Stage::SizedTag capability_type;
+
+			/**
+			 * \brief Initializes new ChunkStage starting from a slot.
+			 * \param chunk Chunk holding the head
+			 * \param offset Slot of the head
+			 * \param length Number of items from the head
+			 */
+			ChunkStage(const std::shared_ptr<Chunk> & chunk, int offset, int length) : mRoot(chunk), mNext(chunk.get()), mIndex(offset), mCurrent(nullptr), mRemaining(length) {}
+
+			/**
+			 * \brief Move to stage to next position
+			 * \return False if stage at end of list, Otherwise True
+			 */
+			bool moveNext()
+			{
+				if (!mNext) return false;
+				mCurrent = mNext->items() + mIndex;
+				advance(1);
+				return true;
+			}
+
+			/**
+			 * \brief Get value at current position.
+			 * \return Reference into the current chunk if stage is valid, otherwise throw exception.
+			 */
+			const T & getCurrent()
+			{
+				if (!mCurrent) throw Exception::InvalidEnumerator();
+				return *mCurrent;
+			}
+
+			/**
+			 * \brief Push every remaining item to sink, one array loop per chunk.
+			 * \param sink Callable taking T, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				while (mNext)
+				{
+					const T * values = mNext->items();
+					for (int i = mIndex; i < Chunk::Capacity; ++i)
+					{
+						if (!sink(values[i]))
+						{
+							mCurrent = mNext->items() + i;
+							advance(i + 1 - mIndex);
+							return false;
+						}
+					}
+					advance(Chunk::Capacity - mIndex);
+				}
+				return true;
+			}
+
+			/**
+			 * \brief Get number of items left.
+			 * \return Exact SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return Enumerator::SizeHint::exact(mRemaining);
+			}
+
+			/**
+			 * \brief Get source stage at the start of the chain.
+			 * \return Reference to this
+			 */
+			ChunkStage & getOrigin()
+			{
+				return *this;
+			}
+
+		private:
+			/**
+			 * \brief Move next position forward by count slots, within the current chunk.
+			 */
+			void advance(int count)
+			{
+				mIndex += count;
+				mRemaining -= count;
+				if (mIndex == Chunk::Capacity)
+				{
+					mIndex = mNext->tailOffset;
+					mNext = mNext->tail.get();
+				}
+			}
+
+			std::shared_ptr<Chunk> mRoot;
+			Chunk * mNext;
+			int mIndex;
+			T * mCurrent;
+			int mRemaining;
+		};
+
+		/**
+		 * \brief Enumerator for internal chunks, walks raw pointers while the root keeps every chunk alive.
+		 */
+		class ChunkEnumerator : public IEnumerator < T >
+		{
+		public:
+			/**
+			 * \brief Initializes new ChunkEnumerator starting from a slot.
+			 * \param chunk Chunk holding the head
+			 * \param offset Slot of the head
+			 * \param length Number of items from the head
+			 */
+			ChunkEnumerator(const std::shared_ptr<Chunk> & chunk, int offset, int length) : mStage(chunk, offset, length) {}
+
+			/**
+			 * \brief Move to enumerator to next position
+			 * \return False if enumerator at end of list, Otherwise True
+			 */
+			bool moveNext() override
+			{
+				return mStage.moveNext();
+			}
+
+			/**
+			 * \brief Copy the items of the next block, a chunk run at a time.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items copied, 0 if at end of list.
+			 */
+			int nextBatch(T * out, int max) override
+			{
+				if (max <= 0) return 0;
+				int count = 0;
+				mStage.forEach([out, max, &count](const T & value){
+					out[count++] = value;
+					return count < max;
+				});
+				return count;
+			}
+
+			/**
+			 * \brief Get value at current position.
+			 * \return Reference into the current chunk if Enumerator is valid, otherwise throw exception.
+			 */
+			const T & getCurrent() override
+			{
+				return mStage.getCurrent();
+			}
+
+			/**
+			 * \brief Get number of items left.
+			 * \return Exact SizeHint
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return mStage.getSizeHint();
+			}
+
+			/**
+			 * \brief Items are read from the chunks.
+			 * \return True
+			 */
+			bool isMaterialized() const override
+			{
+				return true;
+			}
+
+			/**
+			 * \brief Clone enumerator.
+			 * \return std::shared_ptr<IEnumerator<T> >
+			 */
+			std::shared_ptr<IEnumerator<T> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<T> >(new ChunkEnumerator(*this));
+			}
+
+		private:
+			ChunkStage mStage;
+		};
+	};
+}
+
+#include "ChunkedList.tpp"
@@ -0,0 +1,121 @@
+#include "ChunkedList.h"
+
+namespace MyList
+{
+	template <typename T>
+	ChunkedList<T>::ChunkedList(const T * input, int length) : ChunkedList(fromArray(input, length))
+	{
+	}
+
+	template <typename T>
+	ChunkedList<T>::ChunkedList(const IEnumerable<T> * list) : ChunkedList()
+	{
+		// Chunks fill from the back, so collect the items first, all at once only if the source knows how many.
+		std::vector<T> values;
+		auto enumerator = list->getEnumerator();
+		SizeHint hint = enumerator->getSizeHint();
+		if (hint.getKind() == SizeHint::Exact) values.reserve(hint.getCount());
+		collect(*enumerator, values, typename Memory::RawBuffer<T>::IsTrivial());
+		*this = fromArray(values.data(), static_cast<int>(values.size()));
+	}
+
+	template <typename T>
+	void ChunkedList<T>::collect(IEnumerator<T> & enumerator, std::vector<T> & values, std::true_type)
+	{
+		std::shared_ptr<T> batch = Memory::RawBuffer<T>::allocate(DEFAULT_BATCH_SIZE);
+		int count;
+		while ((count = enumerator.nextBatch(batch.get(), DEFAULT_BATCH_SIZE)) > 0)
+		{
+			values.insert(values.end(), batch.get(), batch.get() + count);
+		}
+	}
+
+	template <typename T>
+	void ChunkedList<T>::collect(IEnumerator<T> & enumerator, std::vector<T> & values, std::false_type)
+	{
+		while (enumerator.moveNext())
+		{
+			values.push_back(enumerator.getCurrent());
+		}
+	}
+
+	template <typename T>
+	ChunkedList<T>::ChunkedList(T head, const ChunkedList & tail) : mLength(tail.mLength + 1), mChunk(tail.mChunk), mOffset(tail.mOffset)
+	{
+		pushFront(mChunk, mOffset, head);
+	}
+
+	template <typename T>
+	ChunkedList<T> ChunkedList<T>::getTail() const
+	{
+		if (!mChunk) return ChunkedList(*this);
+		if (mOffset + 1 < Chunk::Capacity) return ChunkedList(mChunk, mOffset + 1, mLength - 1);
+		return ChunkedList(mChunk->tail, mChunk->tailOffset, mLength - 1);
+	}
+
+	template <typename T>
+	T ChunkedList<T>::getHead() const
+	{
+		if (!mChunk) throw Exception::EmptyListException();
+		return mChunk->items()[mOffset];
+	}
+
+	template <typename T>
+	std::shared_ptr<Enumerator::IEnumerator<T> > ChunkedList<T>::getEnumerator() const
+	{
+		// Create new enumerator pointing to head slot.
+		return std::shared_ptr<IEnumerator<T> >(new ChunkEnumerator(mChunk, mOffset, mLength));
+	}
+
+	template <typename T>
+	ChunkedList<T> ChunkedList<T>::reverse() const
+	{
+		// Prepending every item in list order gives the reversed list.
+		std::shared_ptr<Chunk> chunk;
+		int offset = 0;
+		ChunkStage stage(mChunk, mOffset, mLength);
+		stage.forEach([&chunk, &offset](const T & value){
+			pushFront(chunk, offset, value);
+			return true;
+		});
+		return ChunkedList(chunk, offset, mLength);
+	}
+
+	template <typename T>
+	void ChunkedList<T>::pushFront(std::shared_ptr<Chunk> & chunk, int & offset, const T & value)
+	{
+		// Take the free slot in front of the head unless another list got there first.
+		if (!chunk || offset == 0 || !chunk->tryClaim(offset))
+		{
+			chunk = std::make_shared<Chunk>(chunk, offset);
+			offset = Chunk::Capacity;
+			chunk->tryClaim(offset);
+		}
+
+		try
+		{
+			new (chunk->items() + offset - 1) T(value);
+		}
+		catch (...)
+		{
+			// Nobody can have claimed further yet, the slot is only reachable through the list being built.
+			chunk->first = offset;
+			throw;
+		}
+		--offset;
+	}
+
+	template <typename T>
+	ChunkedList<T> ChunkedList<T>::fromArray(const T * values, int length)
+	{
+		// Push the last item first, filling each chunk from its end.
+		std::shared_ptr<Chunk> chunk;
+		int offset = 0;
+		for (int i = length - 1; i >= 0; --i)
+		{
+			pushFront(chunk, offset, values[i]);
+		}
+		return ChunkedList(chunk, offset, length);
+	}
+
+}
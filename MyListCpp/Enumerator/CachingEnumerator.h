@@ -0,0 +1,216 @@
+/**
+ *  Summary: Enumerator that records the items of its input the first time they are produced, so every clone reads
+ *  the recording instead of evaluating the input again.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "IEnumerator.h"
+#include "../Exception/MyExceptions.h"
+#include "../Memory/RawBuffer.h"
+
+#define CACHE_CHUNK_ITEMS 1024
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator that records the items of its input the first time they are produced.
+		 * The recording lives in fixed size chunks shared by every clone, so recorded items never move and clones on
+		 * other threads read them without locking. Only the enumerator that reaches the end of the recording takes the lock
+		 * and evaluates the input further, one item at a time so nothing is evaluated before it is asked for. Materialized
+		 * inputs cost nothing to read ahead, so they are recorded a batch at a time. The input is released once exhausted.
+		 * \tparam T Type of item, must be copy constructible.
+		 */
+		template<class T>
+		class CachingEnumerator : public IEnumerator < T >
+		{
+		public:
+			/**
+			 * \brief Instantiates a new CachingEnumerator taking ownership of an input enumerator.
+			 * \param input Enumerator to record, must not be advanced by anyone else.
+			 */
+			CachingEnumerator(const std::shared_ptr<IEnumerator<T> > & input) : mCache(std::make_shared<Cache>(input)), mIndex(-1){ }
+
+			/**
+			 * \brief Copy constructor, shares the recording and copies the position.
+			 * \param other CachingEnumerator
+			 */
+			CachingEnumerator(const CachingEnumerator & other) : mCache(other.mCache), mChunk(other.mChunk), mIndex(other.mIndex){ }
+
+			/**
+			 * \brief Move enumerator to next position, evaluating the input if nobody has recorded that item yet.
+			 * \return False if at end of list, True otherwise
+			 */
+			bool moveNext() override
+			{
+				const int next = mIndex + 1;
+				if (next % CACHE_CHUNK_ITEMS == 0 || next >= mCache->getCount())
+				{
+					std::shared_ptr<T> chunk = mCache->fetch(next);
+					if (!chunk) return false;
+					mChunk = chunk;
+				}
+				mIndex = next;
+				return true;
+			}
+
+			/**
+			 * \brief Get recorded item at current position.
+			 * \return Reference into the recording if Enumerator is valid, otherwise throw exception.
+			 */
+			const T & getCurrent() override
+			{
+				if (mIndex < 0) throw Exception::InvalidEnumerator();
+				return mChunk.get()[mIndex % CACHE_CHUNK_ITEMS];
+			}
+
+			/**
+			 * \brief Get number of items left, recorded ones plus what the input still expects.
+			 * \return SizeHint of the input plus the recorded items ahead, exact once the input is exhausted.
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return mCache->getSizeHint(mIndex + 1);
+			}
+
+			/**
+			 * \brief Clone enumerator, the clone shares the recording.
+			 * \return std::shared_ptr<IEnumerator<T> >
+			 */
+			std::shared_ptr<IEnumerator<T> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<T> >(new CachingEnumerator(*this));
+			}
+
+		private:
+			typedef Memory::RawBuffer<T> Buffer;
+
+			/**
+			 * \brief Recording shared by every clone.
+			 */
+			class Cache
+			{
+			public:
+				Cache(const std::shared_ptr<IEnumerator<T> > & input)
+					: mInput(input), mReadAhead(input->isMaterialized() ? DEFAULT_BATCH_SIZE : 1), mCount(0){ }
+
+				/**
+				 * \brief Get number of recorded items. Items below it can be read without the lock.
+				 * \return Count
+				 */
+				int getCount() const
+				{
+					return mCount.load(std::memory_order_acquire);
+				}
+
+				/**
+				 * \brief Get chunk holding an item, recording items of the input until it is there.
+				 * \param index Item index
+				 * \return Chunk, null if the input ends before the item.
+				 */
+				std::shared_ptr<T> fetch(int index)
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+
+					// Record up to the item, or a batch past it if that evaluates nothing, so readers take the lock once per batch.
+					const int count = mCount.load(std::memory_order_relaxed);
+					if (index >= count && mInput)
+					{
+						record(count, index + mReadAhead);
+					}
+					if (index >= mCount.load(std::memory_order_relaxed)) return std::shared_ptr<T>();
+					return mChunks[index / CACHE_CHUNK_ITEMS];
+				}
+
+				/**
+				 * \brief Get number of items from an index to the end.
+				 * \param index Item index
+				 * \return SizeHint
+				 */
+				SizeHint getSizeHint(int index) const
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+
+					const int ahead = mCount.load(std::memory_order_relaxed) - index;
+					if (!mInput) return SizeHint::exact(ahead);
+					SizeHint input = mInput->getSizeHint();
+					switch (input.getKind())
+					{
+					case SizeHint::Exact:
+						return SizeHint::exact(ahead + input.getCount());
+					case SizeHint::UpperBound:
+						return SizeHint::upperBound(ahead + input.getCount());
+					default:
+						return input;
+					}
+				}
+
+			private:
+				/**
+				 * \brief Record items of the input until end items are recorded or the input is exhausted.
+				 * \param count Number of recorded items
+				 * \param end Number of items wanted
+				 */
+				void record(int count, int end)
+				{
+					while (count < end)
+					{
+						if (!mInput->moveNext())
+						{
+							// Nothing reads the input again, release the chain and whatever it holds.
+							mInput.reset();
+							return;
+						}
+
+						const int slot = count % CACHE_CHUNK_ITEMS;
+						if (mChunks.size() <= static_cast<size_t>(count / CACHE_CHUNK_ITEMS)) mChunks.push_back(Buffer::allocate(CACHE_CHUNK_ITEMS));
+						T * chunk = mChunks.back().get();
+						::new (static_cast<void *>(chunk + slot)) T(mInput->getCurrent());
+						Buffer::getCount(chunk) = slot + 1;
+
+						// Publish the item, readers acquire the count before reading the slot.
+						mCount.store(++count, std::memory_order_release);
+					}
+				}
+
+				std::shared_ptr<IEnumerator<T> > mInput;
+
+				/**
+				 * \brief Number of items recorded from the one asked for, 1 unless the input is materialized.
+				 */
+				const int mReadAhead;
+
+				/**
+				 * \brief Chunks of CACHE_CHUNK_ITEMS slots, each a Memory::RawBuffer that destroys the items recorded in it.
+				 */
+				std::vector<std::shared_ptr<T> > mChunks;
+
+				/**
+				 * \brief Number of recorded items.
+				 */
+				std::atomic<int> mCount;
+
+				/**
+				 * \brief Held while recording and while reading mChunks or mInput.
+				 */
+				mutable std::mutex mMutex;
+			};
+
+			std::shared_ptr<Cache> mCache;
+
+			/**
+			 * \brief Chunk holding the current item, kept by the enumerator so reading it needs no lock.
+			 */
+			std::shared_ptr<T> mChunk;
+
+			int mIndex;
+		};
+	}
+}
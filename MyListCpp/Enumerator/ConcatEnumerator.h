@@ -0,0 +1,112 @@
+/**
+ *  Summary: Enumerator reading every item of one enumerator, then every item of another.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include "IEnumerator.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator reading every item of one enumerator, then every item of another.
+		 * Items and blocks are handed on from whichever input is current, nothing is copied on the way.
+		 * \tparam T Type of item
+		 */
+		template<class T>
+		class ConcatEnumerator : public IEnumerator < T >
+		{
+		public:
+			/**
+			 * \brief Instantiates new ConcatEnumerator from two input enumerators.
+			 * \param first Enumerator read first
+			 * \param second Enumerator read once first is at its end
+			 */
+			ConcatEnumerator(const std::shared_ptr<IEnumerator<T> > & first, const std::shared_ptr<IEnumerator<T> > & second)
+				: mFirst(first), mSecond(second), mInSecond(false){ }
+
+			/**
+			 * \brief Copy constructor, clones both inputs and stays in the same one.
+			 * \param other ConcatEnumerator
+			 */
+			ConcatEnumerator(const ConcatEnumerator & other) : mFirst(other.mFirst->clone()), mSecond(other.mSecond->clone()), mInSecond(other.mInSecond){ }
+
+			/**
+			 * \brief Move to the next item of the first input, or of the second once the first is at its end.
+			 * \return False if both inputs are at their end, True otherwise
+			 */
+			bool moveNext() override
+			{
+				if (!mInSecond)
+				{
+					if (mFirst->moveNext()) return true;
+					mInSecond = true;
+				}
+				return mSecond->moveNext();
+			}
+
+			/**
+			 * \brief Get current item of the current input.
+			 * \return Reference to the item
+			 */
+			const T & getCurrent() override
+			{
+				return mInSecond ? mSecond->getCurrent() : mFirst->getCurrent();
+			}
+
+			/**
+			 * \brief Pass on a block of the current input.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items written, 0 if both inputs are at their end.
+			 */
+			int nextBatch(T * out, int max) override
+			{
+				if (!mInSecond)
+				{
+					int count = mFirst->nextBatch(out, max);
+					if (count > 0) return count;
+					mInSecond = true;
+				}
+				return mSecond->nextBatch(out, max);
+			}
+
+			/**
+			 * \brief Get number of items left in both inputs.
+			 * \return Sum of the input hints, unknown if either is unknown.
+			 */
+			SizeHint getSizeHint() const override
+			{
+				const SizeHint second = mSecond->getSizeHint();
+				if (mInSecond) return second;
+				const SizeHint first = mFirst->getSizeHint();
+				if (first.getKind() == SizeHint::Unknown || second.getKind() == SizeHint::Unknown) return SizeHint::unknown();
+				const int count = first.getCount() + second.getCount();
+				if (first.getKind() == SizeHint::Exact && second.getKind() == SizeHint::Exact) return SizeHint::exact(count);
+				return SizeHint::upperBound(count);
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<T> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<T> >(new ConcatEnumerator(*this));
+			}
+
+		private:
+			std::shared_ptr<IEnumerator<T> > mFirst;
+
+			std::shared_ptr<IEnumerator<T> > mSecond;
+
+			/**
+			 * \brief Set once the first input reported its end, so it is never moved past it.
+			 */
+			bool mInSecond;
+		};
+	}
+}
@@ -0,0 +1,78 @@
+/**
+ *  Summary: Enumerator that can be shared between threads. Hands out items in batches so the lock is taken once per batch.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include "IEnumerator.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator that can be shared between threads.
+		 * Every consumer takes batches of items under a single lock and works through them on its own.
+		 * \tparam T Type of item
+		 */
+		template<class T>
+		class ConcurrentEnumerator
+		{
+		public:
+			/**
+			 * \brief Instantiates a new ConcurrentEnumerator taking ownership of an input enumerator.
+			 * \param input Enumerator to share, must not be advanced by anyone else.
+			 */
+			ConcurrentEnumerator(const std::shared_ptr<IEnumerator<T> > & input) : mInputEnumerator(input), mFinished(false){ }
+
+			/**
+			 * \brief Move up to max items of the input into out, as one atomic transaction.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items to take.
+			 * \return Number of items written, 0 once the input is exhausted.
+			 */
+			int tryGetBatch(T * out, int max)
+			{
+				// Lock the mutex (unlocked when lock goes out of scope, exception safe).
+				std::unique_lock<std::mutex> lock(mMutex);
+
+				int count = 0;
+				while (!mFinished && count < max)
+				{
+					int read = mInputEnumerator->nextBatch(out + count, max - count);
+					if (read == 0)
+					{
+						mFinished = true;
+					}
+					count += read;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Get next item as atomic transaction. Prefer tryGetBatch, this takes the lock for every item.
+			 * \param out Reference for output value.
+			 * \return False if enumerator at end of list, True otherwise.
+			 */
+			bool tryGetNext(T & out)
+			{
+				return tryGetBatch(&out, 1) == 1;
+			}
+
+		private:
+			ConcurrentEnumerator(const ConcurrentEnumerator & other);
+			ConcurrentEnumerator & operator=(const ConcurrentEnumerator & other);
+
+			std::shared_ptr<IEnumerator<T> > mInputEnumerator;
+
+			/**
+			 * \brief Set once the input reported its end, so it is never moved past it.
+			 */
+			bool mFinished;
+
+			std::mutex mMutex;
+		};
+	}
+}
@@ -0,0 +1,94 @@
+/**
+ *  Summary: Enumerator pairing every item of an input with its position, counted from 0.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include <utility>
+#include "IEnumerator.h"
+#include "../Exception/MyExceptions.h"
+#include "../Memory/Slot.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator pairing every item of an input with its position, counted from 0.
+		 * \tparam T Type of items of the input
+		 */
+		template<class T>
+		class EnumerateEnumerator : public IEnumerator < std::pair<int, T> >
+		{
+		public:
+			typedef std::pair<int, T> value_type;
+
+			/**
+			 * \brief Instantiates new EnumerateEnumerator from an input enumerator.
+			 * \param input Pointer to input enumerator, its next item gets position 0.
+			 */
+			EnumerateEnumerator(const std::shared_ptr<IEnumerator<T> > & input) : mInputEnumerator(input), mIndex(-1){ }
+
+			/**
+			 * \brief Copy constructor, counts on from the same position as the input clone.
+			 * \param other EnumerateEnumerator
+			 */
+			EnumerateEnumerator(const EnumerateEnumerator & other) : mInputEnumerator(other.mInputEnumerator->clone()), mIndex(other.mIndex){ }
+
+			/**
+			 * \brief Move enumerator to next position.
+			 * \return False if at end of list, True otherwise
+			 */
+			bool moveNext() override
+			{
+				mCurrent.reset();
+				if (!mInputEnumerator->moveNext()) return false;
+				++mIndex;
+				return true;
+			}
+
+			/**
+			 * \brief Pair up the position and the current item of the input, once per position.
+			 * \return Reference to the pair, kept until the enumerator moves.
+			 */
+			const value_type & getCurrent() override
+			{
+				if (mIndex < 0) throw Exception::InvalidEnumerator();
+				if (!mCurrent.isSet()) mCurrent.set(value_type(mIndex, mInputEnumerator->getCurrent()));
+				return mCurrent.get();
+			}
+
+			/**
+			 * \brief Every item is kept, pass the input hint through.
+			 * \return SizeHint of input
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return mInputEnumerator->getSizeHint();
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<value_type> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<value_type> >(new EnumerateEnumerator(*this));
+			}
+
+		private:
+			std::shared_ptr<IEnumerator<T> > mInputEnumerator;
+
+			/**
+			 * \brief Position of the current item.
+			 */
+			int mIndex;
+
+			/**
+			 * \brief Pair at the current position, made on first getCurrent.
+			 */
+			Memory::Slot<value_type> mCurrent;
+		};
+	}
+}
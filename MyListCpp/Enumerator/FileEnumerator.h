@@ -0,0 +1,320 @@
+/**
+ *  Summary: Enumerator streaming the items of a file, read ahead in large blocks on a background thread.
+ *  Items are fixed size records (RecordFormat) or lines of text (LineFormat), so pipelines can run over files larger than memory.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "IEnumerator.h"
+#include "../Exception/MyExceptions.h"
+#include "../Io/PrefetchReader.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Reads the bytes of a file in order, one PrefetchReader block after the other.
+		 * Opens the file on first use, so unused enumerators hold no thread or buffers.
+		 */
+		class FileCursor
+		{
+		public:
+			FileCursor(const std::string & path, long long offset, int blockBytes, int depth)
+				: mPath(path), mOffset(offset), mBlockBytes(blockBytes), mDepth(depth), mBlock(nullptr), mSize(0), mPosition(0){}
+
+			/**
+			 * \brief Get position of the next byte in the file.
+			 * \return Offset from the start of the file
+			 */
+			long long getOffset() const
+			{
+				return mOffset;
+			}
+
+			/**
+			 * \brief Get the unread bytes of the current block, reading the next block if it is used up.
+			 * \param size Set to the number of bytes available, 0 at end of file.
+			 * \return First unread byte
+			 */
+			const char * peek(int & size)
+			{
+				if (mPosition == mSize)
+				{
+					if (!mReader) mReader.reset(new Io::PrefetchReader(mPath, mOffset, mBlockBytes, mDepth));
+					mBlock = mReader->next(mSize);
+					mPosition = 0;
+				}
+				size = mSize - mPosition;
+				return mBlock + mPosition;
+			}
+
+			/**
+			 * \brief Move past bytes returned by peek.
+			 * \param count Number of bytes, at most the size peek returned.
+			 */
+			void skip(int count)
+			{
+				mPosition += count;
+				mOffset += count;
+			}
+
+			/**
+			 * \brief Copy bytes out of the file, across blocks if needed.
+			 * \param out Buffer for count bytes
+			 * \param count Number of bytes wanted
+			 * \return Number of bytes copied, less than count only at end of file.
+			 */
+			int read(char * out, int count)
+			{
+				int copied = 0;
+				int size;
+				while (copied < count)
+				{
+					const char * bytes = peek(size);
+					if (size == 0) break;
+					const int part = std::min(size, count - copied);
+					memcpy(out + copied, bytes, part);
+					skip(part);
+					copied += part;
+				}
+				return copied;
+			}
+
+		private:
+			FileCursor(const FileCursor & other);
+			FileCursor & operator=(const FileCursor & other);
+
+			std::string mPath;
+
+			long long mOffset;
+
+			int mBlockBytes;
+
+			int mDepth;
+
+			std::unique_ptr<Io::PrefetchReader> mReader;
+
+			/**
+			 * \brief Current block, mSize bytes of which mPosition are read.
+			 */
+			const char * mBlock;
+
+			int mSize;
+
+			int mPosition;
+		};
+
+		/**
+		 * \brief Format of files holding raw items of a trivially copyable type, back to back with no header.
+		 * \tparam T Type of item
+		 */
+		template<class T>
+		struct RecordFormat
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable items can be read as raw bytes");
+
+			/**
+			 * \brief Read next item.
+			 * \param in Cursor
+			 * \param out Item
+			 * \return False at end of file. Throws Exception::InvalidFileFormat if the file ends inside an item.
+			 */
+			static bool read(FileCursor & in, T & out)
+			{
+				return readBatch(in, &out, 1) == 1;
+			}
+
+			/**
+			 * \brief Read up to max items straight into out.
+			 * \return Number of items read, 0 at end of file.
+			 */
+			static int readBatch(FileCursor & in, T * out, int max)
+			{
+				// Callers may offer a whole presized list, read no more than an int of bytes at a time.
+				max = std::min(max, INT_MAX / static_cast<int>(sizeof(T)));
+				const int bytes = in.read(reinterpret_cast<char *>(out), max * static_cast<int>(sizeof(T)));
+				if (bytes % sizeof(T) != 0) throw Exception::InvalidFileFormat();
+				return bytes / static_cast<int>(sizeof(T));
+			}
+
+			/**
+			 * \brief Get number of items between an offset and the end of the file.
+			 * \param bytes Bytes left in the file
+			 * \return Exact SizeHint
+			 */
+			static SizeHint getSizeHint(long long bytes)
+			{
+				const long long count = bytes / static_cast<long long>(sizeof(T));
+				return SizeHint::exact(count > INT_MAX ? INT_MAX : static_cast<int>(count));
+			}
+		};
+
+		/**
+		 * \brief Format of text files, one item per line. Lines end with "\n" or "\r\n", neither is part of the item.
+		 * The last line needs no line end.
+		 */
+		struct LineFormat
+		{
+			/**
+			 * \brief Read next line.
+			 * \param in Cursor
+			 * \param out Line, its capacity is reused.
+			 * \return False at end of file.
+			 */
+			static bool read(FileCursor & in, std::string & out)
+			{
+				out.clear();
+				bool any = false;
+				int size;
+				while (true)
+				{
+					const char * bytes = in.peek(size);
+					if (size == 0) break;
+					any = true;
+					const char * end = static_cast<const char *>(memchr(bytes, '\n', size));
+					if (end)
+					{
+						out.append(bytes, end);
+						in.skip(static_cast<int>(end - bytes) + 1);
+						if (!out.empty() && out[out.size() - 1] == '\r') out.erase(out.size() - 1);
+						return true;
+					}
+
+					// The line goes on in the next block.
+					out.append(bytes, size);
+					in.skip(size);
+				}
+				if (!out.empty() && out[out.size() - 1] == '\r') out.erase(out.size() - 1);
+				return any;
+			}
+
+			static int readBatch(FileCursor & in, std::string * out, int max)
+			{
+				int count = 0;
+				while (count < max && read(in, out[count])) ++count;
+				return count;
+			}
+
+			/**
+			 * \brief The number of lines is not known without reading them.
+			 * \return Unknown SizeHint
+			 */
+			static SizeHint getSizeHint(long long)
+			{
+				return SizeHint::unknown();
+			}
+		};
+
+		/**
+		 * \brief Enumerator streaming the items of a file. Reads blocks of FILE_BLOCK_BYTES a few blocks ahead on a background
+		 * thread (see Io::PrefetchReader), so memory stays bounded and pipelines wait on the disk rather than on system calls.
+		 * The file is opened on the first moveNext, so a LazyList over it costs nothing until it is enumerated.
+		 * The file must not change while enumerated.
+		 * \tparam T Type of item, default constructible.
+		 * \tparam TFormat How items are laid out: RecordFormat<T> (default) or LineFormat for T = std::string.
+		 */
+		template<class T, class TFormat = RecordFormat<T> >
+		class FileEnumerator : public IEnumerator < T >
+		{
+		public:
+			/**
+			 * \brief Instantiates a new FileEnumerator.
+			 * \param path File name. Throws Exception::FileException if it cannot be opened.
+			 * \param offset Position of the first item, e.g. past a header.
+			 * \param blockBytes Size of a read
+			 * \param depth Number of blocks read ahead, including the one being consumed.
+			 */
+			FileEnumerator(const std::string & path, long long offset = 0, int blockBytes = FILE_BLOCK_BYTES, int depth = FILE_READ_AHEAD)
+				: mPath(path), mFileSize(getFileSize(path)), mBlockBytes(blockBytes), mDepth(depth), mCursor(path, offset, blockBytes, depth), mValid(false){ }
+
+			/**
+			 * \brief Copy constructor, reads on from the position of other with a reader of its own.
+			 * \param other FileEnumerator
+			 */
+			FileEnumerator(const FileEnumerator & other)
+				: mPath(other.mPath), mFileSize(other.mFileSize), mBlockBytes(other.mBlockBytes), mDepth(other.mDepth),
+				mCursor(other.mPath, other.mCursor.getOffset(), other.mBlockBytes, other.mDepth), mCurrent(other.mCurrent), mValid(other.mValid){ }
+
+			/**
+			 * \brief Move enumerator to next item, waiting for the block holding it if it is not read yet.
+			 * \return False if at end of file, True otherwise
+			 */
+			bool moveNext() override
+			{
+				mValid = TFormat::read(mCursor, mCurrent);
+				return mValid;
+			}
+
+			/**
+			 * \brief Get item at current position.
+			 * \return Reference to the item if Enumerator is valid, otherwise throw exception.
+			 */
+			const T & getCurrent() override
+			{
+				if (!mValid) throw Exception::InvalidEnumerator();
+				return mCurrent;
+			}
+
+			/**
+			 * \brief Read up to max items straight into out, records are copied out of the blocks in one go.
+			 * Leaves no current item, getCurrent throws until the next moveNext.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items read, 0 if at end of file.
+			 */
+			int nextBatch(T * out, int max) override
+			{
+				mValid = false;
+				return TFormat::readBatch(mCursor, out, max);
+			}
+
+			/**
+			 * \brief Get number of items left.
+			 * \return Exact SizeHint for records, unknown for lines.
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return TFormat::getSizeHint(std::max(mFileSize - mCursor.getOffset(), 0LL));
+			}
+
+			/**
+			 * \brief Clone enumerator, the clone opens the file again at the same position.
+			 * \return std::shared_ptr<IEnumerator<T> >
+			 */
+			std::shared_ptr<IEnumerator<T> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<T> >(new FileEnumerator(*this));
+			}
+
+		private:
+			static long long getFileSize(const std::string & path)
+			{
+				std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+				if (!file) throw Exception::FileException();
+				return static_cast<long long>(file.tellg());
+			}
+
+			std::string mPath;
+
+			long long mFileSize;
+
+			int mBlockBytes;
+
+			int mDepth;
+
+			FileCursor mCursor;
+
+			T mCurrent;
+
+			bool mValid;
+		};
+	}
+}
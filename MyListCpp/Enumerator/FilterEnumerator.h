@@ -1,38 +1,111 @@
+/**
+ *  Summary: Enumerator for lazily evaluating a filter. Wraps existing enumerator returning only items that satisfy the filter.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
 #pragma once
 
+#include <memory>
+#include <utility>
 #include "IEnumerator.h"
+
 namespace MyList
 {
 	namespace Enumerator
 	{
-		template<class TSource>
+		/**
+		 * \brief Enumerator for lazily evaluating a filter.
+		 * \tparam TSource 
+		 * \tparam TPredicate Type of predicate callable, stored by value.
+		 */
+		template<class TSource, class TPredicate = bool(*)(TSource)>
 		class FilterEnumerator : public IEnumerator < TSource >
 		{
-		private:
-			bool(*mPredicate)(TSource);
-
-			std::shared_ptr<IEnumerator<TSource>> mInputEnumerator;
-
 		public:
-			FilterEnumerator(const std::shared_ptr<IEnumerator<TSource> > & input, bool(*predicate)(TSource)) : mPredicate(predicate), mInputEnumerator(input){ }
-			FilterEnumerator(const FilterEnumerator & other){
-				mPredicate = other.mPredicate;
-				mInputEnumerator = other.mInputEnumerator->clone();
+			/**
+			 * \brief Instantiates a new FilterEnumerator from an input enumerator and predicate
+			 * \param input Pointer to input enumerator
+			 * \param predicate Filter function
+			 */
+			FilterEnumerator(const std::shared_ptr<IEnumerator<TSource> > & input, const TPredicate & predicate) : mPredicate(predicate), mInputEnumerator(input){ }
+
+			/**
+			 * \brief Copy constructor
+			 * \param other FilterEnumerator
+			 */
+			FilterEnumerator(const FilterEnumerator & other) : mPredicate(other.mPredicate), mInputEnumerator(other.mInputEnumerator->clone()){
 			}
 
-			bool moveNext(){
+			/**
+			 * \brief Move enumerator to next position in collection that satisfies the filter.
+			 * \return False if enumerator at end of collection, True otherwise.
+			 */
+			bool moveNext() override
+			{
 				bool hasValue = false;
 				while ((hasValue = mInputEnumerator->moveNext()) && !mPredicate(mInputEnumerator->getCurrent()));
 				return hasValue;
 			}
 
-			TSource getCurrent(){
+			/**
+			 * \brief Gets the current value pointed to.
+			 * \return Reference to the current item of the input
+			 */
+			const TSource & getCurrent() override
+			{
 				return mInputEnumerator->getCurrent();
 			}
 
-			std::shared_ptr<IEnumerator<TSource>> clone(){
+			/**
+			 * \brief Pull blocks from the input straight into out and compact the items that satisfy the filter.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items written, 0 if at end of collection.
+			 */
+			int nextBatch(TSource * out, int max) override
+			{
+				int count = 0;
+				while (count < max)
+				{
+					int read = mInputEnumerator->nextBatch(out + count, max - count);
+					if (read == 0) break;
+
+					// Items before count are already kept, so count never overtakes i.
+					for (int i = count, end = count + read; i < end; ++i)
+					{
+						if (!mPredicate(out[i])) continue;
+						if (i != count) out[count] = std::move(out[i]);
+						++count;
+					}
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Filter may drop any item, so the input hint becomes an upper bound.
+			 * \return SizeHint
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return mInputEnumerator->getSizeHint().atMost();
+			}
+
+			/**
+			 * \brief Clones this enumerator by invoking copy constructor.
+			 * \return std::shared_ptr<IEnumerator<TSource>
+			 */
+			std::shared_ptr<IEnumerator<TSource>> clone() override
+			{
 				return std::shared_ptr<IEnumerator<TSource>>(new FilterEnumerator(*this));
 			}
+
+		private:
+			/**
+			 * \brief Predicate filter callable
+			 */
+			TPredicate mPredicate;
+
+			std::shared_ptr<IEnumerator<TSource>> mInputEnumerator;
 		};
 	}
-}
\ No newline at end of file
+}
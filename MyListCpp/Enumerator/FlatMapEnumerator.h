@@ -0,0 +1,121 @@
+/**
+ *  Summary: Enumerator expanding every item of an input into a list of items, read one after the other.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include "IEnumerator.h"
+#include "../Exception/MyExceptions.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator expanding every item of an input into a list of items, read one after the other.
+		 * Only the enumerator of the current expansion is kept, so nothing is gathered in between.
+		 * \tparam TSource Source type
+		 * \tparam TOut Type of items of the expansions
+		 * \tparam TFunc Type of callable taking TSource and returning any IEnumerable<TOut> by value, e.g. a LazyList.
+		 * Only the enumerator of the returned list is kept, the list itself may go.
+		 */
+		template<class TSource, class TOut, class TFunc>
+		class FlatMapEnumerator : public IEnumerator < TOut >
+		{
+		public:
+			/**
+			 * \brief Instantiates new FlatMapEnumerator from an input enumerator and expanding function.
+			 * \param input Pointer to input enumerator.
+			 * \param func Expanding callable.
+			 */
+			FlatMapEnumerator(const std::shared_ptr<IEnumerator<TSource> > & input, const TFunc & func) : mFunc(func), mInputEnumerator(input){ }
+
+			/**
+			 * \brief Copy constructor, clones the input and the enumerator of the current expansion.
+			 * \param other FlatMapEnumerator
+			 */
+			FlatMapEnumerator(const FlatMapEnumerator & other) : mFunc(other.mFunc), mInputEnumerator(other.mInputEnumerator->clone()),
+				mInner(other.mInner ? other.mInner->clone() : other.mInner){ }
+
+			/**
+			 * \brief Move to the next item of the current expansion, expanding further input items while they come up empty.
+			 * \return False once the input is at its end, True otherwise
+			 */
+			bool moveNext() override
+			{
+				while (!mInner || !mInner->moveNext())
+				{
+					mInner.reset();
+					if (!mInputEnumerator->moveNext()) return false;
+					mInner = mFunc(mInputEnumerator->getCurrent()).getEnumerator();
+				}
+				return true;
+			}
+
+			/**
+			 * \brief Get current item of the current expansion.
+			 * \return Reference to the item, kept until the enumerator moves.
+			 */
+			const TOut & getCurrent() override
+			{
+				if (!mInner) throw Exception::InvalidEnumerator();
+				return mInner->getCurrent();
+			}
+
+			/**
+			 * \brief Pass on a block of the current expansion, expanding further input items if it is used up.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items written, 0 if at end of list.
+			 */
+			int nextBatch(TOut * out, int max) override
+			{
+				while (true)
+				{
+					if (mInner)
+					{
+						int count = mInner->nextBatch(out, max);
+						if (count > 0) return count;
+						mInner.reset();
+					}
+					if (!mInputEnumerator->moveNext()) return 0;
+					mInner = mFunc(mInputEnumerator->getCurrent()).getEnumerator();
+				}
+			}
+
+			/**
+			 * \brief The number of items is only known once the input is used up, then the current expansion has them all.
+			 * \return SizeHint of the current expansion if the input is at its end, unknown otherwise.
+			 */
+			SizeHint getSizeHint() const override
+			{
+				const SizeHint input = mInputEnumerator->getSizeHint();
+				if (input.getKind() != SizeHint::Exact || input.getCount() > 0) return SizeHint::unknown();
+				return mInner ? mInner->getSizeHint() : SizeHint::exact(0);
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<TOut> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<TOut> >(new FlatMapEnumerator(*this));
+			}
+
+		private:
+			/**
+			 * \brief Expanding callable.
+			 */
+			TFunc mFunc;
+
+			std::shared_ptr<IEnumerator<TSource> > mInputEnumerator;
+
+			/**
+			 * \brief Enumerator of the expansion of the current input item, null before the first and after the last.
+			 */
+			std::shared_ptr<IEnumerator<TOut> > mInner;
+		};
+	}
+}
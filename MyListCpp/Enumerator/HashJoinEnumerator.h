@@ -0,0 +1,237 @@
+/**
+ *  Summary: Enumerator joining the items of an input with those of a build side of equal key, through a hash table.
+ *  The build side is read once into a flat table, the input is streamed against it.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "IEnumerator.h"
+#include "../Exception/MyExceptions.h"
+#include "../Memory/HashIndex.h"
+#include "../Memory/Slot.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator joining every item of an input with every item of a build side of equal key, in input order.
+		 * On first use the build side is read into a table shared by every clone: a Memory::HashIndex over the distinct keys,
+		 * and the items grouped by key in one block, so the matches of a key are read one after the other.
+		 * \tparam TSource Type of items of the input (probe side)
+		 * \tparam TOther Type of items of the build side, copy constructible.
+		 * \tparam TKey Type of key, hashed with std::hash and compared with ==.
+		 * \tparam TDest Type of joined items
+		 * \tparam TKeyFunc Type of callable taking TSource and returning TKey.
+		 * \tparam TOtherKeyFunc Type of callable taking TOther and returning TKey.
+		 * \tparam TCombine Type of callable taking (TSource, TOther) and returning TDest.
+		 */
+		template<class TSource, class TOther, class TKey, class TDest, class TKeyFunc, class TOtherKeyFunc, class TCombine>
+		class HashJoinEnumerator : public IEnumerator < TDest >
+		{
+		public:
+			/**
+			 * \brief Instantiates new HashJoinEnumerator. Nothing is read until the first moveNext.
+			 * \param input Enumerator of the probe side, streamed.
+			 * \param build Enumerator of the build side, read whole into the table.
+			 * \param key Key callable of the probe side
+			 * \param otherKey Key callable of the build side
+			 * \param combine Callable joining two items of equal key
+			 */
+			HashJoinEnumerator(const std::shared_ptr<IEnumerator<TSource> > & input, const std::shared_ptr<IEnumerator<TOther> > & build,
+				const TKeyFunc & key, const TOtherKeyFunc & otherKey, const TCombine & combine)
+				: mInputEnumerator(input), mTable(std::make_shared<Table>(build, otherKey)), mKeyFunc(key), mCombine(combine), mMatch(0), mMatchEnd(0){ }
+
+			/**
+			 * \brief Copy constructor, clones the input and shares the table, going on from the same match.
+			 * \param other HashJoinEnumerator
+			 */
+			HashJoinEnumerator(const HashJoinEnumerator & other) : mInputEnumerator(other.mInputEnumerator->clone()), mTable(other.mTable),
+				mKeyFunc(other.mKeyFunc), mCombine(other.mCombine), mMatch(other.mMatch), mMatchEnd(other.mMatchEnd){ }
+
+			/**
+			 * \brief Move to the next match of the current input item, or on to the next input item with any.
+			 * \return False if at end of input, True otherwise
+			 */
+			bool moveNext() override
+			{
+				mCurrent.reset();
+				if (mMatch + 1 < mMatchEnd)
+				{
+					++mMatch;
+					return true;
+				}
+
+				const Table & table = mTable->get();
+				while (mInputEnumerator->moveNext())
+				{
+					const int key = table.find(mKeyFunc(mInputEnumerator->getCurrent()));
+					if (key >= 0)
+					{
+						mMatch = table.getBegin(key);
+						mMatchEnd = table.getBegin(key + 1);
+						return true;
+					}
+				}
+				mMatch = mMatchEnd = 0;
+				return false;
+			}
+
+			/**
+			 * \brief Join the current input item and its current match, once per position.
+			 * \return Reference to the joined item, kept until the enumerator moves.
+			 */
+			const TDest & getCurrent() override
+			{
+				if (mMatch >= mMatchEnd) throw Exception::InvalidEnumerator();
+				if (!mCurrent.isSet()) mCurrent.set(mCombine(mInputEnumerator->getCurrent(), mTable->getItem(mMatch)));
+				return mCurrent.get();
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<TDest> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<TDest> >(new HashJoinEnumerator(*this));
+			}
+
+		private:
+			/**
+			 * \brief Build side grouped by key, built once by whichever clone needs it first and read-only after.
+			 */
+			class Table
+			{
+			public:
+				Table(const std::shared_ptr<IEnumerator<TOther> > & input, const TOtherKeyFunc & key) : mInput(input), mKeyFunc(key), mBuilt(false){ }
+
+				/**
+				 * \brief Get the table, building it first if nobody has yet.
+				 * \return Reference to this
+				 */
+				const Table & get()
+				{
+					if (!mBuilt.load(std::memory_order_acquire))
+					{
+						std::unique_lock<std::mutex> lock(mMutex);
+						if (!mBuilt.load(std::memory_order_relaxed))
+						{
+							build();
+							mBuilt.store(true, std::memory_order_release);
+						}
+					}
+					return *this;
+				}
+
+				/**
+				 * \brief Find a key.
+				 * \param key Key
+				 * \return Key number, -1 if no item of the build side has the key.
+				 */
+				int find(const TKey & key) const
+				{
+					return mIndex.find(mHash(key), [this, &key](int i){ return mKeys[i] == key; });
+				}
+
+				/**
+				 * \brief Get position of the first item of a key, that of key + 1 is one past its last.
+				 * \param key Key number, up to the number of keys.
+				 * \return Item position
+				 */
+				int getBegin(int key) const
+				{
+					return mBegins[key];
+				}
+
+				const TOther & getItem(int i) const
+				{
+					return mItems[i];
+				}
+
+			private:
+				void build()
+				{
+					// Number every distinct key and note the key number of every item.
+					std::vector<TOther> items;
+					std::vector<int> keys;
+					while (mInput->moveNext())
+					{
+						const TOther & item = mInput->getCurrent();
+						const TKey key = mKeyFunc(item);
+						bool added;
+						const int entry = mIndex.insert(mHash(key), [this, &key](int i){ return mKeys[i] == key; }, added);
+						if (added) mKeys.push_back(key);
+						keys.push_back(entry);
+						items.push_back(item);
+					}
+					mInput.reset();
+
+					// Counting sort by key number, items of a key end up next to each other in input order.
+					mBegins.assign(mKeys.size() + 1, 0);
+					for (size_t i = 0; i < keys.size(); ++i) ++mBegins[keys[i] + 1];
+					for (size_t key = 1; key < mBegins.size(); ++key) mBegins[key] += mBegins[key - 1];
+					std::vector<int> order(items.size());
+					std::vector<int> next(mBegins.begin(), mBegins.end() - 1);
+					for (size_t i = 0; i < keys.size(); ++i) order[next[keys[i]]++] = static_cast<int>(i);
+
+					mItems.reserve(items.size());
+					for (size_t i = 0; i < order.size(); ++i) mItems.push_back(std::move(items[order[i]]));
+				}
+
+				std::shared_ptr<IEnumerator<TOther> > mInput;
+
+				TOtherKeyFunc mKeyFunc;
+
+				std::hash<TKey> mHash;
+
+				Memory::HashIndex mIndex;
+
+				/**
+				 * \brief Distinct keys by key number of mIndex.
+				 */
+				std::vector<TKey> mKeys;
+
+				/**
+				 * \brief Position in mItems of the first item of every key number, plus the number of items.
+				 */
+				std::vector<int> mBegins;
+
+				/**
+				 * \brief Items of the build side, grouped by key number.
+				 */
+				std::vector<TOther> mItems;
+
+				std::atomic<bool> mBuilt;
+
+				std::mutex mMutex;
+			};
+
+			std::shared_ptr<IEnumerator<TSource> > mInputEnumerator;
+
+			std::shared_ptr<Table> mTable;
+
+			TKeyFunc mKeyFunc;
+
+			TCombine mCombine;
+
+			/**
+			 * \brief Position of the current match in the table, and one past the last match of the current input item.
+			 */
+			int mMatch;
+
+			int mMatchEnd;
+
+			/**
+			 * \brief Joined item at the current position, made on first getCurrent.
+			 */
+			Memory::Slot<TDest> mCurrent;
+		};
+	}
+}
@@ -1,22 +1,84 @@
+/**
+ *  Summary: Interface for enumerating over a list
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
 #pragma once
-#include<mutex>
+#include <memory>
+#include "SizeHint.h"
+
+#define DEFAULT_BATCH_SIZE 256
 
 namespace MyList{
 	namespace Enumerator{
 
+		/**
+		 * \brief Interface for enumerating over a list
+		 * \tparam T 
+		 */
 		template<class T>
 		class IEnumerator
 		{
-		private:
-			std::mutex mMutex;
-
 		public:
+			/**
+			 * \brief Move enumerator to next position in list.
+			 * \return False if at end of list, True otherwise.
+			 */
 			virtual bool moveNext() = 0;
-			virtual T getCurrent() = 0;
 
+			/**
+			 * \brief Get current item the enumerator is pointing to, without copying it.
+			 * \return Reference to the item, valid until the enumerator moves or is destroyed.
+			 */
+			virtual const T & getCurrent() = 0;
+
+			/**
+			 * \brief Move past up to max items, copying them into out. Amortizes the virtual calls over a whole block.
+			 * Leaves no current item, whatever the enumerator: getCurrent is only valid again after the next call to moveNext,
+			 * which moves to the first item not copied. Overrides need not keep the last item copied at hand.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items to copy.
+			 * \return Number of items copied, 0 only if enumerator at end of list.
+			 */
+			virtual int nextBatch(T * out, int max);
+
+			/**
+			 * \brief Move to next item and get it. Not synchronised, an enumerator belongs to a single consumer,
+			 * use ConcurrentEnumerator to share one between threads.
+			 * \param out Reference for output value.
+			 * \return False if enumerator at end of list, True otherwise.
+			 */
 			bool tryGetNext(T & out);
 
+			/**
+			 * \brief Get how many items are left after the current position.
+			 * \return SizeHint, unknown unless the enumerator knows better.
+			 */
+			virtual SizeHint getSizeHint() const
+			{
+				return SizeHint::unknown();
+			}
+
+			/**
+			 * \brief Check whether items are read from storage, so reading ahead of the consumer evaluates nothing.
+			 * \return False unless the enumerator knows better.
+			 */
+			virtual bool isMaterialized() const
+			{
+				return false;
+			}
+
+			/**
+			 * \brief Clone this enumerator. The clone goes on from the same position, with the same current item,
+			 * and moves independently of this one. Enumerators built on others clone their inputs and copy their own position.
+			 * \return std::shared_ptr<IEnumerator<T> 
+			 */
 			virtual std::shared_ptr<IEnumerator<T> > clone() = 0;
+
+			/**
+			 * \brief Destructor
+			 */
+			virtual ~IEnumerator() {};
 		};
 	}
 }
@@ -3,10 +3,6 @@ namespace MyList{
 
 		template<typename T>
 		bool IEnumerator<T>::tryGetNext(T & out){
-
-			// Lock the mutex (unlocked when lock goes out of scope, exception safe).
-			std::unique_lock<std::mutex> lock(mMutex);
-
 			if (moveNext()){
 				out = getCurrent();
 				return true;
@@ -14,5 +10,15 @@ namespace MyList{
 
 			return false;
 		}
+
+		template<typename T>
+		int IEnumerator<T>::nextBatch(T * out, int max){
+			// Fallback for enumerators without a block representation.
+			int count = 0;
+			while (count < max && moveNext()){
+				out[count++] = getCurrent();
+			}
+			return count;
+		}
 	}
 }
\ No newline at end of file
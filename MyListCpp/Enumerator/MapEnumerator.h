@@ -1,38 +1,137 @@
+/**
+ *  Summary: Enumerator for lazily evaluating a collection with a mapping function.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
 #pragma once
+#include <memory>
+#include <type_traits>
 #include "IEnumerator.h"
-#include <functional>
+#include "../Memory/RawBuffer.h"
+#include "../Memory/Slot.h"
 
 namespace MyList
 {
 	namespace Enumerator
 	{
-		template<class TSource, class TOut>
+		/**
+		 * \brief Enumerator for lazily evaluating a collection with a mapping function.
+		 * \tparam TSource Source type
+		 * \tparam TOut Destination type
+		 * \tparam TFunc Type of mapping callable, stored by value.
+		 */
+		template<class TSource, class TOut, class TFunc = TOut(*)(TSource)>
 		class MapEnumerator : public IEnumerator < TOut >
 		{
-		private:
-			TOut(*mFunc)(TSource);
-
-			std::shared_ptr<IEnumerator<TSource>> mInputEnumerator;
-
 		public:
-			MapEnumerator(const std::shared_ptr<IEnumerator<TSource> > & input, TOut(*func)(TSource)) : mFunc(func), mInputEnumerator(input){ }
+			/**
+			 * \brief Instantiates new MapEnumerator from an input enumerator and map function.
+			 * \param input Pointer to input enumerator.
+			 * \param func Mapping callable.
+			 */
+			MapEnumerator(const std::shared_ptr<IEnumerator<TSource> > & input, const TFunc & func) : mFunc(func), mInputEnumerator(input){ }
 
-			MapEnumerator(const MapEnumerator & other) {
-				mFunc = other.mFunc;
-				mInputEnumerator = other.mInputEnumerator->clone();
+			/**
+			 * \brief Copy constructor, maps again from wherever the input clone is.
+			 * \param other
+			 */
+			MapEnumerator(const MapEnumerator & other) : mFunc(other.mFunc), mInputEnumerator(other.mInputEnumerator->clone()) {
 			}
 
-			bool moveNext(){
+			/**
+			 * \brief Move enumerator to next position.
+			 * \return False if at end of list, True otherwise
+			 */
+			bool moveNext() override
+			{
+				mCurrent.reset();
 				return mInputEnumerator->moveNext();
 			}
 
-			TOut getCurrent(){
-				return mFunc(mInputEnumerator->getCurrent());
+			/**
+			 * \brief Apply map function to current value, once per position.
+			 * \return Reference to the mapped value, kept until the enumerator moves.
+			 */
+			const TOut & getCurrent() override
+			{
+				if (!mCurrent.isSet()) mCurrent.set(mFunc(mInputEnumerator->getCurrent()));
+				return mCurrent.get();
+			}
+
+			/**
+			 * \brief Pull a block from the input and map it as a whole.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items written, 0 if at end of list.
+			 */
+			int nextBatch(TOut * out, int max) override
+			{
+				return nextBatch(out, max, typename Memory::RawBuffer<TSource>::IsTrivial());
+			}
+
+			/**
+			 * \brief Mapping keeps every item, pass the input hint through.
+			 * \return SizeHint of input
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return mInputEnumerator->getSizeHint();
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<TOut>> clone() override
+			{
+				return std::shared_ptr<IEnumerator<TOut> >(new MapEnumerator(*this));
+			}
+
+		private:
+			/**
+			 * \brief Pull trivially copyable input items into uninitialized scratch slots, so TSource needs no default constructor.
+			 */
+			int nextBatch(TOut * out, int max, std::true_type)
+			{
+				if (max > DEFAULT_BATCH_SIZE) max = DEFAULT_BATCH_SIZE;
+				if (!mBatch) mBatch = Memory::RawBuffer<TSource>::allocate(DEFAULT_BATCH_SIZE);
+
+				mCurrent.reset();
+				int count = mInputEnumerator->nextBatch(mBatch.get(), max);
+				for (int i = 0; i < count; ++i)
+				{
+					out[i] = mFunc(mBatch.get()[i]);
+				}
+				return count;
 			}
 
-			std::shared_ptr<IEnumerator<TOut>> clone(){
-				return std::shared_ptr<IEnumerator<TOut> >(new MapEnumerator<TSource, TOut>(*this));
+			/**
+			 * \brief Other input items would need constructing up front, map them one at a time instead.
+			 */
+			int nextBatch(TOut * out, int max, std::false_type)
+			{
+				return IEnumerator<TOut>::nextBatch(out, max);
 			}
+
+			/**
+			 * \brief Map callable.
+			 */
+			TFunc mFunc;
+
+			/**
+			 * \brief Enumerator to apply map to
+			 */
+			std::shared_ptr<IEnumerator<TSource>> mInputEnumerator;
+
+			/**
+			 * \brief Scratch block of uninitialized input slots, allocated on first nextBatch.
+			 */
+			std::shared_ptr<TSource> mBatch;
+
+			/**
+			 * \brief Mapped value at the current position, computed on first getCurrent.
+			 */
+			Memory::Slot<TOut> mCurrent;
 		};
 	}
 }
@@ -0,0 +1,184 @@
+/**
+ *  Summary: Enumerator joining the items of two inputs sorted by key, streaming both.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include <utility>
+#include <vector>
+#include "IEnumerator.h"
+#include "../Exception/MyExceptions.h"
+#include "../Memory/Slot.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator joining every item of an input with every item of another input of equal key, in input order.
+		 * Both inputs must be sorted by ascending key, so they are read once and in step. Only the items of the other input
+		 * sharing the current key are held. Keys are checked to go up as they are read, throws UnsortedInput if one does not.
+		 * \tparam TSource Type of items of the input
+		 * \tparam TOther Type of items of the other input, copy constructible.
+		 * \tparam TKey Type of key, ordered with <.
+		 * \tparam TDest Type of joined items
+		 * \tparam TKeyFunc Type of callable taking TSource and returning TKey.
+		 * \tparam TOtherKeyFunc Type of callable taking TOther and returning TKey.
+		 * \tparam TCombine Type of callable taking (TSource, TOther) and returning TDest.
+		 */
+		template<class TSource, class TOther, class TKey, class TDest, class TKeyFunc, class TOtherKeyFunc, class TCombine>
+		class MergeJoinEnumerator : public IEnumerator < TDest >
+		{
+		public:
+			/**
+			 * \brief Instantiates new MergeJoinEnumerator.
+			 * \param input Enumerator of the input, sorted by key.
+			 * \param other Enumerator of the other input, sorted by key.
+			 * \param key Key callable of the input
+			 * \param otherKey Key callable of the other input
+			 * \param combine Callable joining two items of equal key
+			 */
+			MergeJoinEnumerator(const std::shared_ptr<IEnumerator<TSource> > & input, const std::shared_ptr<IEnumerator<TOther> > & other,
+				const TKeyFunc & key, const TOtherKeyFunc & otherKey, const TCombine & combine)
+				: mInputEnumerator(input), mOtherEnumerator(other), mKeyFunc(key), mOtherKeyFunc(otherKey), mCombine(combine),
+				mStarted(false), mOtherValid(false), mMatch(0), mMatchEnd(0){ }
+
+			/**
+			 * \brief Copy constructor, clones both inputs and the run held, going on from the same match.
+			 * \param other MergeJoinEnumerator
+			 */
+			MergeJoinEnumerator(const MergeJoinEnumerator & other) : mInputEnumerator(other.mInputEnumerator->clone()),
+				mOtherEnumerator(other.mOtherEnumerator->clone()), mKeyFunc(other.mKeyFunc), mOtherKeyFunc(other.mOtherKeyFunc),
+				mCombine(other.mCombine), mInputKey(other.mInputKey), mOtherKey(other.mOtherKey), mRun(other.mRun), mRunKey(other.mRunKey),
+				mStarted(other.mStarted), mOtherValid(other.mOtherValid), mMatch(other.mMatch), mMatchEnd(other.mMatchEnd){ }
+
+			/**
+			 * \brief Move to the next match of the current input item, or on to the next input item with any.
+			 * \return False if either input has no more matches, True otherwise
+			 */
+			bool moveNext() override
+			{
+				mCurrent.reset();
+				if (mMatch + 1 < mMatchEnd)
+				{
+					++mMatch;
+					return true;
+				}
+				if (!mStarted)
+				{
+					mStarted = true;
+					moveOther();
+				}
+
+				while (mInputEnumerator->moveNext())
+				{
+					TKey next = mKeyFunc(mInputEnumerator->getCurrent());
+					if (mInputKey.isSet() && next < mInputKey.get()) throw Exception::UnsortedInput();
+					const TKey & key = mInputKey.set(std::move(next));
+
+					// Keys only go up, so the run held is either that of this key or behind it.
+					if (!mRun.empty() && !(mRunKey.get() < key)) return startRun();
+
+					while (mOtherValid && mOtherKey.get() < key) moveOther();
+					if (!mOtherValid) break;
+					if (key < mOtherKey.get()) continue;
+
+					mRun.clear();
+					mRunKey.set(key);
+					while (mOtherValid && !(key < mOtherKey.get()))
+					{
+						mRun.push_back(mOtherEnumerator->getCurrent());
+						moveOther();
+					}
+					return startRun();
+				}
+				mMatch = mMatchEnd = 0;
+				return false;
+			}
+
+			/**
+			 * \brief Join the current input item and its current match, once per position.
+			 * \return Reference to the joined item, kept until the enumerator moves.
+			 */
+			const TDest & getCurrent() override
+			{
+				if (mMatch >= mMatchEnd) throw Exception::InvalidEnumerator();
+				if (!mCurrent.isSet()) mCurrent.set(mCombine(mInputEnumerator->getCurrent(), mRun[mMatch]));
+				return mCurrent.get();
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<TDest> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<TDest> >(new MergeJoinEnumerator(*this));
+			}
+
+		private:
+			bool startRun()
+			{
+				mMatch = 0;
+				mMatchEnd = static_cast<int>(mRun.size());
+				return true;
+			}
+
+			/**
+			 * \brief Move the other input on to its next item and take its key.
+			 */
+			void moveOther()
+			{
+				mOtherValid = mOtherEnumerator->moveNext();
+				if (!mOtherValid) return;
+				TKey key = mOtherKeyFunc(mOtherEnumerator->getCurrent());
+				if (mOtherKey.isSet() && key < mOtherKey.get()) throw Exception::UnsortedInput();
+				mOtherKey.set(std::move(key));
+			}
+
+			std::shared_ptr<IEnumerator<TSource> > mInputEnumerator;
+
+			std::shared_ptr<IEnumerator<TOther> > mOtherEnumerator;
+
+			TKeyFunc mKeyFunc;
+
+			TOtherKeyFunc mOtherKeyFunc;
+
+			TCombine mCombine;
+
+			/**
+			 * \brief Key of the current input item, and of the item the other input is on.
+			 */
+			Memory::Slot<TKey> mInputKey;
+
+			Memory::Slot<TKey> mOtherKey;
+
+			/**
+			 * \brief Items of the other input with key mRunKey, read past already.
+			 */
+			std::vector<TOther> mRun;
+
+			Memory::Slot<TKey> mRunKey;
+
+			/**
+			 * \brief Whether the other input was moved on to its first item yet, and whether it is on one.
+			 */
+			bool mStarted;
+
+			bool mOtherValid;
+
+			/**
+			 * \brief Position of the current match in mRun, and the number of matches of the current input item.
+			 */
+			int mMatch;
+
+			int mMatchEnd;
+
+			/**
+			 * \brief Joined item at the current position, made on first getCurrent.
+			 */
+			Memory::Slot<TDest> mCurrent;
+		};
+	}
+}
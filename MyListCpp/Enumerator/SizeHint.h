@@ -0,0 +1,110 @@
+/**
+ *  Summary: How many items an enumerator or stage has left, exactly, at most, or unknown.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief How many items an enumerator or stage has left. Lets materialization allocate once up front.
+		 */
+		class SizeHint
+		{
+		public:
+			/**
+			 * \brief What the count means.
+			 */
+			enum Kind
+			{
+				Unknown,
+				UpperBound,
+				Exact
+			};
+
+			/**
+			 * \brief Nothing is known about the number of items.
+			 * \return SizeHint
+			 */
+			static SizeHint unknown()
+			{
+				return SizeHint(Unknown, 0);
+			}
+
+			/**
+			 * \brief Exactly count items are left.
+			 * \param count Number of items
+			 * \return SizeHint
+			 */
+			static SizeHint exact(int count)
+			{
+				return SizeHint(Exact, count);
+			}
+
+			/**
+			 * \brief At most count items are left.
+			 * \param count Number of items
+			 * \return SizeHint
+			 */
+			static SizeHint upperBound(int count)
+			{
+				return SizeHint(UpperBound, count);
+			}
+
+			/**
+			 * \brief Get hint of a stage that may drop items, such as a filter.
+			 * \return Upper bound of this hint, unknown stays unknown.
+			 */
+			SizeHint atMost() const
+			{
+				return mKind == Unknown ? *this : upperBound(mCount);
+			}
+
+			/**
+			 * \brief Get hint of a stage that stops after max items, such as take.
+			 * \param max Maximum number of items passed on
+			 * \return This hint capped at max, unknown becomes an upper bound of max.
+			 */
+			SizeHint limit(int max) const
+			{
+				if (mKind == Unknown) return upperBound(max);
+				return SizeHint(mKind, mCount < max ? mCount : max);
+			}
+
+			/**
+			 * \brief Get hint of a stage that drops the first count items, such as skip.
+			 * \param count Number of items dropped
+			 * \return This hint less count, never negative. Unknown stays unknown.
+			 */
+			SizeHint drop(int count) const
+			{
+				if (mKind == Unknown) return *this;
+				return SizeHint(mKind, mCount > count ? mCount - count : 0);
+			}
+
+			Kind getKind() const
+			{
+				return mKind;
+			}
+
+			/**
+			 * \brief Get number of items, 0 if unknown.
+			 * \return Count
+			 */
+			int getCount() const
+			{
+				return mCount;
+			}
+
+		private:
+			SizeHint(Kind kind, int count) : mKind(kind), mCount(count){}
+
+			Kind mKind;
+
+			int mCount;
+		};
+	}
+}
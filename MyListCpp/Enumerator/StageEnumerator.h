@@ -0,0 +1,130 @@
+/**
+ *  Summary: Enumerator that type-erases a pipeline stage, so a fused pipeline can cross an API boundary.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "IEnumerator.h"
+#include "../Memory/Slot.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator that type-erases a pipeline stage.
+		 * \tparam TStage Stage type
+		 */
+		template<class TStage>
+		class StageEnumerator : public IEnumerator < typename TStage::value_type >
+		{
+		public:
+			/**
+			 * \brief Type of items produced by the stage
+			 */
+			typedef typename TStage::value_type T;
+
+			/**
+			 * \brief Type the stage hands out items as, a reference or a computed value
+			 */
+			typedef typename TStage::reference reference;
+
+			/**
+			 * \brief Instantiates new StageEnumerator from a stage.
+			 * \param stage Stage, copied.
+			 */
+			StageEnumerator(const TStage & stage) : mStage(stage){ }
+
+			/**
+			 * \brief Copy constructor, copies stage and its position.
+			 * \param other StageEnumerator
+			 */
+			StageEnumerator(const StageEnumerator & other) : mStage(other.mStage), mCurrent(other.mCurrent){ }
+
+			/**
+			 * \brief Move enumerator to next position.
+			 * \return False if at end of list, True otherwise
+			 */
+			bool moveNext() override
+			{
+				mCurrent.reset();
+				return mStage.moveNext();
+			}
+
+			/**
+			 * \brief Gets the current value of the stage, computed at most once per position.
+			 * \return Reference to the item, kept until the enumerator moves.
+			 */
+			const T & getCurrent() override
+			{
+				return getCurrent(std::is_reference<reference>());
+			}
+
+			/**
+			 * \brief Push up to max items of the stage into out in one fused loop.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items written, 0 if at end of list.
+			 */
+			int nextBatch(T * out, int max) override
+			{
+				mCurrent.reset();
+				int count = 0;
+				if (max > 0)
+				{
+					mStage.forEach([out, max, &count](reference value){
+						out[count++] = std::forward<reference>(value);
+						return count < max;
+					});
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Get hint of the stage chain.
+			 * \return SizeHint
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return mStage.getSizeHint();
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<T> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<T> >(new StageEnumerator(*this));
+			}
+
+		private:
+			/**
+			 * \brief Stage hands out references, pass them on.
+			 */
+			const T & getCurrent(std::true_type)
+			{
+				return mStage.getCurrent();
+			}
+
+			/**
+			 * \brief Stage computes its items, keep the current one.
+			 */
+			const T & getCurrent(std::false_type)
+			{
+				if (!mCurrent.isSet()) mCurrent.set(mStage.getCurrent());
+				return mCurrent.get();
+			}
+
+			TStage mStage;
+
+			/**
+			 * \brief Computed item at the current position, unused for stages handing out references.
+			 */
+			Memory::Slot<T> mCurrent;
+		};
+	}
+}
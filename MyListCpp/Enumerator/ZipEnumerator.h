@@ -0,0 +1,100 @@
+/**
+ *  Summary: Enumerator pairing up the items of two enumerators, in step, until the shorter one ends.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include <utility>
+#include "IEnumerator.h"
+#include "../Memory/Slot.h"
+
+namespace MyList
+{
+	namespace Enumerator
+	{
+		/**
+		 * \brief Enumerator pairing up the items of two enumerators, in step, until the shorter one ends.
+		 * \tparam TFirst Type of items of the first input
+		 * \tparam TSecond Type of items of the second input
+		 */
+		template<class TFirst, class TSecond>
+		class ZipEnumerator : public IEnumerator < std::pair<TFirst, TSecond> >
+		{
+		public:
+			typedef std::pair<TFirst, TSecond> value_type;
+
+			/**
+			 * \brief Instantiates new ZipEnumerator from two input enumerators.
+			 * \param first Enumerator of the first items of the pairs
+			 * \param second Enumerator of the second items of the pairs
+			 */
+			ZipEnumerator(const std::shared_ptr<IEnumerator<TFirst> > & first, const std::shared_ptr<IEnumerator<TSecond> > & second)
+				: mFirst(first), mSecond(second){ }
+
+			/**
+			 * \brief Copy constructor
+			 * \param other ZipEnumerator
+			 */
+			ZipEnumerator(const ZipEnumerator & other) : mFirst(other.mFirst->clone()), mSecond(other.mSecond->clone()){ }
+
+			/**
+			 * \brief Move both inputs to their next position.
+			 * \return False once either input is at its end, True otherwise
+			 */
+			bool moveNext() override
+			{
+				mCurrent.reset();
+				return mFirst->moveNext() && mSecond->moveNext();
+			}
+
+			/**
+			 * \brief Pair up the current items, once per position.
+			 * \return Reference to the pair, kept until the enumerator moves.
+			 */
+			const value_type & getCurrent() override
+			{
+				if (!mCurrent.isSet()) mCurrent.set(value_type(mFirst->getCurrent(), mSecond->getCurrent()));
+				return mCurrent.get();
+			}
+
+			/**
+			 * \brief Get number of pairs left, as many as the shorter input has items.
+			 * \return SizeHint, exact only if both inputs know their length.
+			 */
+			SizeHint getSizeHint() const override
+			{
+				const SizeHint first = mFirst->getSizeHint();
+				const SizeHint second = mSecond->getSizeHint();
+				switch (second.getKind())
+				{
+				case SizeHint::Exact:
+					return first.limit(second.getCount());
+				case SizeHint::UpperBound:
+					return first.atMost().limit(second.getCount());
+				default:
+					return first.atMost();
+				}
+			}
+
+			/**
+			 * \brief Clone this enumerator.
+			 * \return New enumerator.
+			 */
+			std::shared_ptr<IEnumerator<value_type> > clone() override
+			{
+				return std::shared_ptr<IEnumerator<value_type> >(new ZipEnumerator(*this));
+			}
+
+		private:
+			std::shared_ptr<IEnumerator<TFirst> > mFirst;
+
+			std::shared_ptr<IEnumerator<TSecond> > mSecond;
+
+			/**
+			 * \brief Pair at the current position, made on first getCurrent.
+			 */
+			Memory::Slot<value_type> mCurrent;
+		};
+	}
+}
@@ -44,6 +44,54 @@ namespace MyList{
 				return "Enumerator not pointing to value.";
 			}
 		};
+
+		/**
+		 * \brief Exception to be thrown if a list file cannot be opened, read or written.
+		 */
+		class FileException : std::exception
+		{
+		public:
+			const char * what() const throw() override
+			{
+				return "Cannot open, read or write list file.";
+			}
+		};
+
+		/**
+		 * \brief Exception to be thrown if a file does not hold a list of the requested item type, or is corrupt.
+		 */
+		class InvalidFileFormat : std::exception
+		{
+		public:
+			const char * what() const throw() override
+			{
+				return "File is not a list of this item type, or is corrupt.";
+			}
+		};
+
+		/**
+		 * \brief Exception to be thrown if user trys to get the value of a key that is not in a map.
+		 */
+		class KeyNotFound : std::exception
+		{
+		public:
+			const char * what() const throw() override
+			{
+				return "Key not found";
+			}
+		};
+
+		/**
+		 * \brief Exception to be thrown if an input that must be sorted by key is not.
+		 */
+		class UnsortedInput : std::exception
+		{
+		public:
+			const char * what() const throw() override
+			{
+				return "Input is not sorted by key.";
+			}
+		};
 	}
 }
 
@@ -0,0 +1,147 @@
+/**
+ *  Summary: Class that represents a map from keys to values, hashed with open addressing. Entries keep insertion order,
+ *  so enumerating a map gives the same order every run.
+ *  Warning: The map itself must only be used by one thread at a time, enumerators read a snapshot like those of MutableList.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "HashMapFwd.h"
+#include "MutableListFwd.h"
+#include "IEnumerable.h"
+#include "MutableList.h"
+#include "Enumerator/IEnumerator.h"
+#include "Memory/HashIndex.h"
+#include "Exception/MyExceptions.h"
+
+namespace MyList{
+	using namespace Enumerator;
+
+	/**
+	* \brief Forward declaration
+	* \tparam T
+	*/
+	template<class T>
+	class IEnumerable;
+
+	/**
+	 * \brief Class that represents a map from keys to values. Entries are (key, value) pairs in a MutableList, in insertion
+	 * order, indexed by a Memory::HashIndex. Enumerating the map enumerates the entries. Keys cannot be removed.
+	 * \tparam TKey Type of key
+	 * \tparam TValue Type of value, default constructible.
+	 * \tparam THash Hash callable for keys
+	 * \tparam TEqual Equality callable for keys
+	 */
+	template<class TKey, class TValue, class THash, class TEqual>
+	class HashMap : public IEnumerable < std::pair<TKey, TValue> >
+	{
+	public:
+		/**
+		 * \brief Type of entries
+		 */
+		typedef std::pair<TKey, TValue> Entry;
+
+		/**
+		 * \brief Create map sized for a number of keys.
+		 * \param expected Number of keys to hold without growing.
+		 * \param hash Hash callable
+		 * \param equal Equality callable
+		 */
+		explicit HashMap(int expected = 0, const THash & hash = THash(), const TEqual & equal = TEqual())
+			: mIndex(expected), mEntries(expected), mHash(hash), mEqual(equal){}
+
+		/**
+		 * \brief Get number of keys.
+		 * \return Length
+		 */
+		int getLength() const
+		{
+			return mEntries.getLength();
+		}
+
+		/**
+		 * \brief Make sure count keys fit without growing. Never shrinks.
+		 * \param count Number of keys
+		 */
+		void reserve(int count)
+		{
+			mIndex.reserve(count);
+			mEntries.reserve(count);
+		}
+
+		/**
+		 * \brief Get value of a key, adding the key with a default constructed value if it is not there yet.
+		 * The reference is only good until the next key is added or the next snapshot is taken.
+		 * \param key Key
+		 * \return Reference to the value
+		 */
+		TValue & operator[](const TKey & key)
+		{
+			bool added;
+			const int entry = mIndex.insert(mHash(key), [this, &key](int i){ return mEqual(mEntries.at(i).first, key); }, added);
+			if (added) mEntries.emplaceBack(key, TValue());
+			return mEntries[entry].second;
+		}
+
+		/**
+		 * \brief Check whether a key is in the map.
+		 * \param key Key
+		 * \return True if it is
+		 */
+		bool contains(const TKey & key) const
+		{
+			return findEntry(key) >= 0;
+		}
+
+		/**
+		 * \brief Get value of a key.
+		 * \param key Key
+		 * \return Reference to the value, throws KeyNotFound if the key is not in the map.
+		 */
+		const TValue & at(const TKey & key) const
+		{
+			const int entry = findEntry(key);
+			if (entry < 0) throw Exception::KeyNotFound();
+			return mEntries.at(entry).second;
+		}
+
+		/**
+		 * \brief Get the entries in insertion order, e.g. to run a pipeline over them.
+		 * \return Reference to the list of entries
+		 */
+		const MutableList<Entry> & getEntries() const
+		{
+			return mEntries;
+		}
+
+		/**
+		 * \brief Get enumerator over a snapshot of the entries, in insertion order.
+		 * \return std::shared_ptr<IEnumerator<Entry> >
+		 */
+		std::shared_ptr<IEnumerator<Entry> > getEnumerator() const override
+		{
+			return mEntries.getEnumerator();
+		}
+
+	private:
+		int findEntry(const TKey & key) const
+		{
+			return mIndex.find(mHash(key), [this, &key](int i){ return mEqual(mEntries.at(i).first, key); });
+		}
+
+		Memory::HashIndex mIndex;
+
+		/**
+		 * \brief Entries by entry number of mIndex.
+		 */
+		MutableList<Entry> mEntries;
+
+		THash mHash;
+
+		TEqual mEqual;
+	};
+}
@@ -0,0 +1,22 @@
+/**
+ *  Summary: Forward declaration of HashMap carrying the default hash and equality.
+ *  Included before anything else by every header naming HashMap, so the defaults are seen first whatever the include order.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace MyList{
+
+	/**
+	 * \brief Forward declaration
+	 * \tparam TKey Type of key
+	 * \tparam TValue Type of value
+	 * \tparam THash Hash callable for keys
+	 * \tparam TEqual Equality callable for keys
+	 */
+	template<class TKey, class TValue, class THash = std::hash<TKey>, class TEqual = std::equal_to<TKey> >
+	class HashMap;
+}
@@ -5,23 +5,39 @@
 
 #pragma once
 #include<memory>
+#include<type_traits>
+#include<utility>
 
+#include "HashMapFwd.h"
+#include "ImmutableListFwd.h"
+#include "MutableListFwd.h"
+#include "HashMap.h"
 #include "ImmutableList.h"
 #include "MutableList.h"
 #include "LazyList.h"
+#include "Pipeline.h"
+#include "ParallelPipeline.h"
 
+#include "Enumerator/ConcatEnumerator.h"
+#include "Enumerator/ConcurrentEnumerator.h"
+#include "Enumerator/EnumerateEnumerator.h"
 #include "Enumerator/FilterEnumerator.h"
+#include "Enumerator/FlatMapEnumerator.h"
+#include "Enumerator/HashJoinEnumerator.h"
 #include "Enumerator/IEnumerator.h"
 #include "Enumerator/MapEnumerator.h"
+#include "Enumerator/MergeJoinEnumerator.h"
+#include "Enumerator/StageEnumerator.h"
+#include "Enumerator/ZipEnumerator.h"
+#include "Memory/HashIndex.h"
+#include "Memory/RawBuffer.h"
+#include "Stage/EnumeratorStage.h"
+#include "Stage/SkipStage.h"
+#include "Stage/TakeStage.h"
+#include "Stage/TakeWhileStage.h"
 
 namespace MyList{
 
-	template <typename T>
-	class ImmutableList;
-
-	template <typename T>
-	class MutableList;
-
 	/**
 	 * \brief Interface that represents an enumerable list of items.
 	 * \tparam T Type of item in list.
@@ -36,31 +52,203 @@ namespace MyList{
 		 */
 		virtual std::shared_ptr<IEnumerator<T> > getEnumerator() const = 0;
 
+		/**
+		 * \brief Get enumerator that can be shared between threads.
+		 * \return std::shared_ptr<ConcurrentEnumerator<T> >
+		 */
+		std::shared_ptr<ConcurrentEnumerator<T> > getConcurrentEnumerator() const
+		{
+			return std::make_shared<ConcurrentEnumerator<T> >(getEnumerator());
+		}
+
 		/**
 		 * \brief Map this list to another
 		 * \tparam TDest Type of item destination list
-		 * \param func Map function
+		 * \tparam TFunc Type of map callable, any function, lambda or functor taking T.
+		 * \param func Map callable, stored by value in the enumerator.
 		 * \return LazyList of mapped values.
 		 */
-		template<typename TDest>
-		LazyList<TDest> map(TDest(*func)(T));
+		template<typename TDest, typename TFunc>
+		LazyList<TDest> map(TFunc func);
 
 		/**
 		 * \brief Filter list
-		 * \param predicate Predicate used to filter items
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate used to filter items, stored by value in the enumerator.
 		 * \return LazyList of filtered values.
 		 */
-		LazyList<T> filter(bool(*predicate)(T));
+		template<typename TPredicate>
+		LazyList<T> filter(TPredicate predicate);
+
+		/**
+		 * \brief Pass on only the first count items, the source is not read past them.
+		 * \param count Maximum number of items
+		 * \return LazyList of at most count items.
+		 */
+		LazyList<T> take(int count);
+
+		/**
+		 * \brief Pass on items until the first one that fails a predicate, the source is not read past it.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate items must satisfy, stored by value in the enumerator.
+		 * \return LazyList of the leading items satisfying predicate.
+		 */
+		template<typename TPredicate>
+		LazyList<T> takeWhile(TPredicate predicate);
+
+		/**
+		 * \brief Drop the first count items.
+		 * \param count Number of items to drop
+		 * \return LazyList of the items after the first count.
+		 */
+		LazyList<T> skip(int count);
+
+		/**
+		 * \brief Pair up the items of this list and another, in step, until the shorter one ends.
+		 * \tparam TOther Type of items of the other list
+		 * \param other List giving the second item of every pair, enumerated when the result is.
+		 * \return LazyList of pairs.
+		 */
+		template<typename TOther>
+		LazyList<std::pair<T, TOther> > zip(const IEnumerable<TOther> & other);
+
+		/**
+		 * \brief Every item of this list, then every item of another.
+		 * \param other List read after this one, enumerated when the result is.
+		 * \return LazyList of the items of both lists.
+		 */
+		LazyList<T> concat(const IEnumerable<T> & other);
+
+		/**
+		 * \brief Expand every item into a list of items and read those in turn.
+		 * \tparam TDest Type of items of the expansions
+		 * \tparam TFunc Type of callable taking T and returning any IEnumerable<TDest> by value, e.g. a LazyList.
+		 * \param func Expanding callable, stored by value in the enumerator.
+		 * \return LazyList of the items of every expansion.
+		 */
+		template<typename TDest, typename TFunc>
+		LazyList<TDest> flatMap(TFunc func);
+
+		/**
+		 * \brief Pair every item with its position.
+		 * \return LazyList of (position, item) pairs, positions counted from 0.
+		 */
+		LazyList<std::pair<int, T> > enumerate();
+
+		/**
+		 * \brief Join every item of this list with every item of another list of equal key, by hash join.
+		 * The other list is read whole into a hash table on the first move of the result, this list is streamed against it,
+		 * so a join costs one pass over each list instead of one pass over other per item.
+		 * \tparam TDest Type of joined items
+		 * \tparam TKey Type of key, hashed with std::hash and compared with ==.
+		 * \tparam TOther Type of items of the other list
+		 * \tparam TKeyFunc Type of callable taking T and returning TKey.
+		 * \tparam TOtherKeyFunc Type of callable taking TOther and returning TKey.
+		 * \tparam TCombine Type of callable taking (T, TOther) and returning TDest.
+		 * \param other List to build the table from, best the smaller one.
+		 * \param key Key callable of this list
+		 * \param otherKey Key callable of the other list
+		 * \param combine Callable joining two items of equal key
+		 * \return LazyList of joined items, in the order of this list and then of other.
+		 */
+		template<typename TDest, typename TKey, typename TOther, typename TKeyFunc, typename TOtherKeyFunc, typename TCombine>
+		LazyList<TDest> join(const IEnumerable<TOther> & other, TKeyFunc key, TOtherKeyFunc otherKey, TCombine combine);
 
 		/**
-		 * \brief Aggregate values in the list.
+		 * \brief Join every item of this list with every item of another list of equal key, by merging.
+		 * Both lists must already be sorted by ascending key. They are then read in step, holding only the items of other
+		 * sharing the current key. Throws UnsortedInput on enumeration when a key goes down.
+		 * \tparam TDest Type of joined items
+		 * \tparam TKey Type of key, ordered with <.
+		 * \tparam TOther Type of items of the other list
+		 * \tparam TKeyFunc Type of callable taking T and returning TKey.
+		 * \tparam TOtherKeyFunc Type of callable taking TOther and returning TKey.
+		 * \tparam TCombine Type of callable taking (T, TOther) and returning TDest.
+		 * \param other List sorted by key
+		 * \param key Key callable of this list
+		 * \param otherKey Key callable of the other list
+		 * \param combine Callable joining two items of equal key
+		 * \return LazyList of joined items, in the order of this list and then of other.
+		 */
+		template<typename TDest, typename TKey, typename TOther, typename TKeyFunc, typename TOtherKeyFunc, typename TCombine>
+		LazyList<TDest> mergeJoin(const IEnumerable<TOther> & other, TKeyFunc key, TOtherKeyFunc otherKey, TCombine combine);
+
+		/**
+		 * \brief Check whether any item satisfies a predicate, stops at the first that does.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate
+		 * \return True if an item satisfies predicate, False if none does or the list is empty.
+		 */
+		template<typename TPredicate>
+		bool any(TPredicate predicate);
+
+		/**
+		 * \brief Check whether every item satisfies a predicate, stops at the first that does not.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate
+		 * \return False if an item fails predicate, True otherwise, also for an empty list.
+		 */
+		template<typename TPredicate>
+		bool all(TPredicate predicate);
+
+		/**
+		 * \brief Find the first item satisfying a predicate, the source is not read past it.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate
+		 * \param out Reference for the item, unchanged if none is found.
+		 * \return True if an item was found.
+		 */
+		template<typename TPredicate>
+		bool find(TPredicate predicate, T & out);
+
+		/**
+		 * \brief Get the first item, nothing else is read.
+		 * \return First item, throws EmptyListException if the list is empty.
+		 */
+		T first();
+
+		/**
+		 * \brief Aggregate values in the list. The accumulator is moved into func and back, so a func taking it
+		 * by value can append to it in place.
 		 * \tparam TDest Aggregate value type
+		 * \tparam TFunc Type of aggregate callable taking (TDest, T).
 		 * \param initial Initial value
-		 * \param func Aggregate function
+		 * \param func Aggregate callable
 		 * \return Aggregate value
 		 */
-		template<typename TDest>
-		TDest foldLeft(TDest initial, TDest(*func)(TDest, T));
+		template<typename TDest, typename TFunc>
+		TDest foldLeft(TDest initial, TFunc func);
+
+		/**
+		 * \brief Gather the items by key. Forces evaluation for the entire list.
+		 * \tparam TKey Type of key, hashed with std::hash.
+		 * \tparam TKeyFunc Type of callable taking T and returning TKey.
+		 * \param keyFunc Key callable
+		 * \param expectedKeys Number of distinct keys expected, sizes the table so it does not grow on the way.
+		 * \return HashMap from every key to the items with that key, keys and items in the order they were met.
+		 */
+		template<typename TKey, typename TKeyFunc>
+		HashMap<TKey, MutableList<T> > groupBy(TKeyFunc keyFunc, int expectedKeys = 0);
+
+		/**
+		 * \brief Count the items by key, without keeping them. Forces evaluation for the entire list.
+		 * \tparam TKey Type of key, hashed with std::hash.
+		 * \tparam TKeyFunc Type of callable taking T and returning TKey.
+		 * \param keyFunc Key callable
+		 * \param expectedKeys Number of distinct keys expected, sizes the table so it does not grow on the way.
+		 * \return HashMap from every key to its number of items, keys in the order they were met.
+		 */
+		template<typename TKey, typename TKeyFunc>
+		HashMap<TKey, int> countBy(TKeyFunc keyFunc, int expectedKeys = 0);
+
+		/**
+		 * \brief Get the first of every set of equal items. Forces evaluation for the entire list.
+		 * \tparam THash Hash callable for items
+		 * \param expectedItems Number of distinct items expected, sizes the table so it does not grow on the way.
+		 * \return New MutableList of distinct items, in the order they were met.
+		 */
+		template<typename THash = std::hash<T> >
+		MutableList<T> distinct(int expectedItems = 0);
 
 		/**
 		 * \brief Convert list to a new ImmutableList. Forces evalutation for the entire list.
@@ -78,6 +266,20 @@ namespace MyList{
 			return MutableList<T>(this);
 		}
 
+	private:
+		/**
+		 * \brief Fold trivially copyable items a block at a time.
+		 */
+		template<typename TDest, typename TFunc>
+		TDest foldLeft(TDest initial, TFunc & func, std::true_type);
+
+		/**
+		 * \brief Fold other items by reference, one at a time, so none is copied.
+		 */
+		template<typename TDest, typename TFunc>
+		TDest foldLeft(TDest initial, TFunc & func, std::false_type);
+
+	public:
 		/**
 		 * \brief Destructor
 		 */
@@ -1,29 +1,205 @@
 namespace MyList{
 
 	template<typename T>
-	template<typename TDest>
-	LazyList<TDest> IEnumerable<T>::map(TDest(*func)(T)){
+	template<typename TDest, typename TFunc>
+	LazyList<TDest> IEnumerable<T>::map(TFunc func){
 		// Return shared ptr to map enumerator wrapping func
 		return LazyList<TDest>(
-			std::shared_ptr<IEnumerator<TDest>>(new MapEnumerator<T, TDest>(this->getEnumerator(), func)));
+			std::shared_ptr<IEnumerator<TDest>>(new MapEnumerator<T, TDest, TFunc>(this->getEnumerator(), func)));
 	}
 
 	template<typename T>
-	LazyList<T> IEnumerable<T>::filter(bool(*predicate)(T)){
+	template<typename TPredicate>
+	LazyList<T> IEnumerable<T>::filter(TPredicate predicate){
 		// Return shared ptr to filter enumerator wrapping predicate
 		return LazyList<T>(
-			std::shared_ptr<IEnumerator<T>>(new FilterEnumerator<T>(this->getEnumerator(), predicate)));
+			std::shared_ptr<IEnumerator<T>>(new FilterEnumerator<T, TPredicate>(this->getEnumerator(), predicate)));
 	}
 
 	template<typename T>
-	template<typename TDest>
-	TDest IEnumerable<T>::foldLeft(TDest initial, TDest(*func)(TDest, T)){
-		// Need to enumerate over every value
+	LazyList<T> IEnumerable<T>::take(int count){
+		// Reuse the pipeline stage over the type-erased enumerator.
+		typedef Stage::TakeStage<Stage::EnumeratorStage<T> > TStage;
+		return LazyList<T>(
+			std::shared_ptr<IEnumerator<T>>(new StageEnumerator<TStage>(TStage(Stage::EnumeratorStage<T>(this->getEnumerator()), count))));
+	}
+
+	template<typename T>
+	template<typename TPredicate>
+	LazyList<T> IEnumerable<T>::takeWhile(TPredicate predicate){
+		typedef Stage::TakeWhileStage<Stage::EnumeratorStage<T>, TPredicate> TStage;
+		return LazyList<T>(
+			std::shared_ptr<IEnumerator<T>>(new StageEnumerator<TStage>(TStage(Stage::EnumeratorStage<T>(this->getEnumerator()), predicate))));
+	}
+
+	template<typename T>
+	LazyList<T> IEnumerable<T>::skip(int count){
+		typedef Stage::SkipStage<Stage::EnumeratorStage<T> > TStage;
+		return LazyList<T>(
+			std::shared_ptr<IEnumerator<T>>(new StageEnumerator<TStage>(TStage(Stage::EnumeratorStage<T>(this->getEnumerator()), count))));
+	}
+
+	template<typename T>
+	template<typename TOther>
+	LazyList<std::pair<T, TOther> > IEnumerable<T>::zip(const IEnumerable<TOther> & other){
+		return LazyList<std::pair<T, TOther> >(
+			std::shared_ptr<IEnumerator<std::pair<T, TOther> > >(new ZipEnumerator<T, TOther>(this->getEnumerator(), other.getEnumerator())));
+	}
+
+	template<typename T>
+	LazyList<T> IEnumerable<T>::concat(const IEnumerable<T> & other){
+		return LazyList<T>(
+			std::shared_ptr<IEnumerator<T>>(new ConcatEnumerator<T>(this->getEnumerator(), other.getEnumerator())));
+	}
+
+	template<typename T>
+	template<typename TDest, typename TFunc>
+	LazyList<TDest> IEnumerable<T>::flatMap(TFunc func){
+		return LazyList<TDest>(
+			std::shared_ptr<IEnumerator<TDest>>(new FlatMapEnumerator<T, TDest, TFunc>(this->getEnumerator(), func)));
+	}
+
+	template<typename T>
+	LazyList<std::pair<int, T> > IEnumerable<T>::enumerate(){
+		return LazyList<std::pair<int, T> >(
+			std::shared_ptr<IEnumerator<std::pair<int, T> > >(new EnumerateEnumerator<T>(this->getEnumerator())));
+	}
+
+	template<typename T>
+	template<typename TDest, typename TKey, typename TOther, typename TKeyFunc, typename TOtherKeyFunc, typename TCombine>
+	LazyList<TDest> IEnumerable<T>::join(const IEnumerable<TOther> & other, TKeyFunc key, TOtherKeyFunc otherKey, TCombine combine){
+		typedef HashJoinEnumerator<T, TOther, TKey, TDest, TKeyFunc, TOtherKeyFunc, TCombine> TEnumerator;
+		return LazyList<TDest>(
+			std::shared_ptr<IEnumerator<TDest>>(new TEnumerator(this->getEnumerator(), other.getEnumerator(), key, otherKey, combine)));
+	}
+
+	template<typename T>
+	template<typename TDest, typename TKey, typename TOther, typename TKeyFunc, typename TOtherKeyFunc, typename TCombine>
+	LazyList<TDest> IEnumerable<T>::mergeJoin(const IEnumerable<TOther> & other, TKeyFunc key, TOtherKeyFunc otherKey, TCombine combine){
+		typedef MergeJoinEnumerator<T, TOther, TKey, TDest, TKeyFunc, TOtherKeyFunc, TCombine> TEnumerator;
+		return LazyList<TDest>(
+			std::shared_ptr<IEnumerator<TDest>>(new TEnumerator(this->getEnumerator(), other.getEnumerator(), key, otherKey, combine)));
+	}
+
+	template<typename T>
+	template<typename TPredicate>
+	bool IEnumerable<T>::any(TPredicate predicate){
+		// Stop at the first item satisfying the predicate.
+		auto enumerator = getEnumerator();
+		while (enumerator->moveNext()){
+			if (predicate(enumerator->getCurrent())) return true;
+		}
+		return false;
+	}
+
+	template<typename T>
+	template<typename TPredicate>
+	bool IEnumerable<T>::all(TPredicate predicate){
+		// Stop at the first item failing the predicate.
 		auto enumerator = getEnumerator();
+		while (enumerator->moveNext()){
+			if (!predicate(enumerator->getCurrent())) return false;
+		}
+		return true;
+	}
 
-		TDest accumulator = initial;
+	template<typename T>
+	template<typename TPredicate>
+	bool IEnumerable<T>::find(TPredicate predicate, T & out){
+		// Stop at the first item satisfying the predicate.
+		auto enumerator = getEnumerator();
+		while (enumerator->moveNext()){
+			// Test the item in place, only the match is copied out.
+			const T & value = enumerator->getCurrent();
+			if (predicate(value)){
+				out = value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename T>
+	T IEnumerable<T>::first(){
+		auto enumerator = getEnumerator();
+		if (!enumerator->moveNext()){
+			throw Exception::EmptyListException();
+		}
+		return enumerator->getCurrent();
+	}
+
+	template<typename T>
+	template<typename TKey, typename TKeyFunc>
+	HashMap<TKey, MutableList<T> > IEnumerable<T>::groupBy(TKeyFunc keyFunc, int expectedKeys){
+		HashMap<TKey, MutableList<T> > groups(expectedKeys);
+		auto enumerator = getEnumerator();
+		while (enumerator->moveNext()){
+			const T & value = enumerator->getCurrent();
+			groups[keyFunc(value)].append(value);
+		}
+		return groups;
+	}
+
+	template<typename T>
+	template<typename TKey, typename TKeyFunc>
+	HashMap<TKey, int> IEnumerable<T>::countBy(TKeyFunc keyFunc, int expectedKeys){
+		HashMap<TKey, int> counts(expectedKeys);
+		auto enumerator = getEnumerator();
+		while (enumerator->moveNext()){
+			++counts[keyFunc(enumerator->getCurrent())];
+		}
+		return counts;
+	}
+
+	template<typename T>
+	template<typename THash>
+	MutableList<T> IEnumerable<T>::distinct(int expectedItems){
+		// The result list holds the entries of the index, nothing is stored twice.
+		MutableList<T> items(expectedItems);
+		Memory::HashIndex index(expectedItems);
+		THash hash;
+		auto enumerator = getEnumerator();
+		while (enumerator->moveNext()){
+			const T & value = enumerator->getCurrent();
+			bool added;
+			index.insert(hash(value), [&items, &value](int i){ return items.at(i) == value; }, added);
+			if (added) items.append(value);
+		}
+		return items;
+	}
+
+	template<typename T>
+	template<typename TDest, typename TFunc>
+	TDest IEnumerable<T>::foldLeft(TDest initial, TFunc func){
+		return foldLeft(std::move(initial), func, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+	}
+
+	template<typename T>
+	template<typename TDest, typename TFunc>
+	TDest IEnumerable<T>::foldLeft(TDest initial, TFunc & func, std::true_type){
+		// Need to enumerate over every value, a block at a time.
+		auto enumerator = getEnumerator();
+		std::shared_ptr<T> batch = Memory::RawBuffer<T>::allocate(DEFAULT_BATCH_SIZE);
+
+		TDest accumulator = std::move(initial);
+		int count;
+		while ((count = enumerator->nextBatch(batch.get(), DEFAULT_BATCH_SIZE)) > 0){
+			for (int i = 0; i < count; ++i){
+				accumulator = func(std::move(accumulator), batch.get()[i]);
+			}
+		}
+
+		return accumulator;
+	}
+
+	template<typename T>
+	template<typename TDest, typename TFunc>
+	TDest IEnumerable<T>::foldLeft(TDest initial, TFunc & func, std::false_type){
+		// Copying items into a block would cost more than the virtual calls it saves.
+		auto enumerator = getEnumerator();
+		TDest accumulator = std::move(initial);
 		while (enumerator->moveNext()){
-			accumulator = func(accumulator, enumerator->getCurrent());
+			accumulator = func(std::move(accumulator), enumerator->getCurrent());
 		}
 
 		return accumulator;
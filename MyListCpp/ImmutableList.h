@@ -6,10 +6,19 @@
 #pragma once
 
 #include<memory>
+#include<utility>
+#include<vector>
 
+#include "ImmutableListFwd.h"
 #include "IEnumerable.h"
+#include "Pipeline.h"
+#include "Parallel/ThreadPool.h"
 #include "Enumerator/IEnumerator.h"
 #include "Exception/MyExceptions.h"
+#include "Memory/RawBuffer.h"
+#include "Memory/RefCount.h"
+
+#define SPLIT_SEGMENT_LENGTH 1024
 
 namespace MyList{
 	using namespace Enumerator;
@@ -21,15 +30,32 @@ namespace MyList{
 	template<class T>
 	class IEnumerable;
 
+	template<class TStage>
+	class Pipeline;
+
+	template<class TStage>
+	class ParallelPipeline;
+
 	/**
 	 * \brief Class that represents an immutable list of items.
 	 * \tparam T Type of item to be stored in list.
+	 * \tparam TCount Reference counting policy for nodes. Memory::SharedCount (default) lists can be shared between threads,
+	 * Memory::LocalCount lists avoid atomic operations but must stay on one thread.
 	 */
-	template<class T>
+	template<class T, class TCount>
 	class ImmutableList : public IEnumerable < T >
 	{
 	private:
 		class ListNode;
+		class ListNodeStage;
+
+		/**
+		 * \brief Pointer owning a node, as chosen by the counting policy.
+		 */
+		typedef typename TCount::template Pointer<ListNode>::type NodePtr;
+
+		template<class TStage>
+		friend class Pipeline;
 
 	public:
 		/**
@@ -50,6 +76,14 @@ namespace MyList{
 		 */
 		ImmutableList(const IEnumerable<T> * list);
 
+		/**
+		 * \brief Initializes new list from the items of an rvalue MutableList, moving them into the nodes.
+		 * Items a snapshot of the list still reads are copied instead. The source list is left empty.
+		 * \param list MutableList to take the items of
+		 */
+		template<class TGrowth, int InlineCount>
+		explicit ImmutableList(MutableList<T, TGrowth, InlineCount> && list);
+
 		/**
 		 * \brief Initializes new list from a head and tail list
 		 * \param head of the new list
@@ -99,21 +133,147 @@ namespace MyList{
 		 */
 		ImmutableList reverse();
 
+		/**
+		 * \brief Map this list to another, evaluated as a fused pipeline.
+		 * \tparam TDest Type of item destination list
+		 * \tparam TFunc Type of map callable, any function, lambda or functor taking T.
+		 * \param func Map callable
+		 * \return Pipeline of mapped values.
+		 */
+		template<typename TDest, typename TFunc>
+		Pipeline<Stage::MapStage<ListNodeStage, TDest, TFunc> > map(TFunc func) const
+		{
+			return pipeline().template map<TDest>(func);
+		}
+
+		/**
+		 * \brief Filter list, evaluated as a fused pipeline.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate used to filter items
+		 * \return Pipeline of filtered values.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::FilterStage<ListNodeStage, TPredicate> > filter(TPredicate predicate) const
+		{
+			return pipeline().filter(predicate);
+		}
+
+		/**
+		 * \brief Take the first count items, evaluated as a fused pipeline.
+		 * \param count Maximum number of items
+		 * \return Pipeline of at most count items.
+		 */
+		Pipeline<Stage::TakeStage<ListNodeStage> > take(int count) const
+		{
+			return pipeline().take(count);
+		}
+
+		/**
+		 * \brief Take leading items while they satisfy a predicate, evaluated as a fused pipeline.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate items must satisfy
+		 * \return Pipeline of the leading items satisfying predicate.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::TakeWhileStage<ListNodeStage, TPredicate> > takeWhile(TPredicate predicate) const
+		{
+			return pipeline().takeWhile(predicate);
+		}
+
+		/**
+		 * \brief Drop the first count items, evaluated as a fused pipeline.
+		 * \param count Number of items to drop
+		 * \return Pipeline of the items after the first count.
+		 */
+		Pipeline<Stage::SkipStage<ListNodeStage> > skip(int count) const
+		{
+			return pipeline().skip(count);
+		}
+
+		/**
+		 * \brief Aggregate values in the list without going through an enumerator.
+		 * \tparam TDest Aggregate value type
+		 * \tparam TFunc Type of aggregate callable taking (TDest, T).
+		 * \param initial Initial value
+		 * \param func Aggregate callable
+		 * \return Aggregate value
+		 */
+		template<typename TDest, typename TFunc>
+		TDest foldLeft(TDest initial, TFunc func) const
+		{
+			return pipeline().foldLeft(std::move(initial), func);
+		}
+
+		/**
+		 * \brief Run map and filter stages across a thread pool, see ParallelPipeline.
+		 * \param pool Thread pool to run on
+		 * \return ParallelPipeline with this list as its source.
+		 */
+		ParallelPipeline<ListNodeStage> parallel(Parallel::ThreadPool & pool = Parallel::ThreadPool::getDefault()) const
+		{
+			return pipeline().parallel(pool);
+		}
+
 	private:
 		int mLength;
-		std::shared_ptr<ListNode> mNode;
+		NodePtr mNode;
 
 		/**
 		 * \brief Initialize new ImmutableList from internal node.
 		 * \param node pointer to a ListNode
 		 * \param length of linked list starting at node
 		 */
-		ImmutableList(const std::shared_ptr<ListNode> & node, int length) : mLength(length), mNode(node){}
+		ImmutableList(const NodePtr & node, int length) : mLength(length), mNode(node){}
+
+		/**
+		 * \brief Get pipeline with this list as its source.
+		 * \return Pipeline<ListNodeStage>
+		 */
+		Pipeline<ListNodeStage> pipeline() const
+		{
+			return Pipeline<ListNodeStage>(ListNodeStage(mNode, mLength));
+		}
+
+		/**
+		 * \brief Build new list from every remaining item of a stage, preserving order.
+		 * \param stage Stage to drain
+		 * \return New ImmutableList
+		 */
+		template<class TStage>
+		static ImmutableList fromStage(TStage stage);
+
+		/**
+		 * \brief Fill empty list from a block at a time, trivially copyable items are enumerated into uninitialized slots.
+		 * \param enumerator Source
+		 */
+		void appendFrom(IEnumerator<T> & enumerator, std::true_type);
+
+		/**
+		 * \brief Fill empty list from an item at a time, so T needs no default constructor.
+		 * \param enumerator Source
+		 */
+		void appendFrom(IEnumerator<T> & enumerator, std::false_type);
+
+		/**
+		 * \brief Allocate node and its reference count from the node pool.
+		 * \param head Value of node
+		 * \param tail Next node
+		 * \return Pointer owning new node
+		 */
+		static NodePtr makeNode(const T & head, const NodePtr & tail)
+		{
+			return TCount::template make<ListNode>(head, tail);
+		}
+
+		static NodePtr makeNode(T && head, const NodePtr & tail)
+		{
+			return TCount::template make<ListNode>(std::move(head), tail);
+		}
 
 		/**
 		 * \brief Internal representation of a linked list node.
 		 */
-		class ListNode
+		class ListNode : public TCount::NodeBase
 		{
 		public:
 			/**
@@ -121,14 +281,195 @@ namespace MyList{
 			 * \param head 
 			 * \param tail 
 			 */
-			inline ListNode(T head, const std::shared_ptr<ListNode> & tail) : head(head), tail(tail){ }
+			inline ListNode(T head, const NodePtr & tail) : head(std::move(head)), tail(tail){ }
+
+			/**
+			 * \brief Unlink uniquely owned tails one at a time, so a long chain is not freed by one nested destructor per node.
+			 * Past the reclaimer's inline limit the rest of the chain is handed to its background thread.
+			 */
+			~ListNode()
+			{
+				NodePtr next(std::move(tail));
+				if (next.use_count() != 1) return;
+
+				const int inlineLimit = TCount::getInlineLimit();
+				int freed = 0;
+				while (next.use_count() == 1)
+				{
+					if (++freed == inlineLimit && TCount::tryDefer(next)) return;
+					next = std::move(next->tail);
+				}
+			}
 
 			T head;
-			std::shared_ptr<ListNode> tail;
+			NodePtr tail;
 		};
 
 		/**
-		 * \brief Enumerator for internal linked list
+		 * \brief Pipeline source stage for internal linked list.
+		 * Walks raw node pointers, the root pointer keeps the whole chain alive.
+		 */
+		class ListNodeStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef T value_type;
+
+			/**
+			 * \brief Items are read in place
+			 */
+			typedef const T & reference;
+
+			/**
+			 * \brief Type of source stage at the start of the chain
+			 */
+			typedef ListNodeStage origin_type;
+
+			/**
+			 * \brief Length is known, nodes are only reached by walking
+			 */
+			typedef Stage::SizedTag capability_type;
+
+			/**
+			 * \brief Initializes new ListNodeStage starting from node.
+			 * \param node Shared pointer to a node.
+			 * \param length Number of items from node, negative if unknown.
+			 */
+			ListNodeStage(const NodePtr & node, int length) : mRoot(node), mNext(node.get()), mCurrent(nullptr), mEnd(nullptr), mRemaining(length) {}
+
+			/**
+			 * \brief Move to stage to next position
+			 * \return False if stage at end of list, Otherwise True
+			 */
+			bool moveNext()
+			{
+				if (mNext != mEnd)
+				{
+					mCurrent = mNext;
+					mNext = mCurrent->tail.get();
+					--mRemaining;
+					return true;
+				}
+				return false;
+			}
+
+			/**
+			 * \brief Get value at current position.
+			 * \return Reference to the head of the current node if stage is valid, otherwise throw exception.
+			 */
+			const T & getCurrent()
+			{
+				if (!mCurrent) throw Exception::InvalidEnumerator();
+				return mCurrent->head;
+			}
+
+			/**
+			 * \brief Push every remaining item to sink.
+			 * \param sink Callable taking T, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				int visited = 0;
+				while (mNext != mEnd)
+				{
+					mCurrent = mNext;
+					mNext = mCurrent->tail.get();
+					++visited;
+					if (!sink(mCurrent->head))
+					{
+						mRemaining -= visited;
+						return false;
+					}
+				}
+				mRemaining -= visited;
+				return true;
+			}
+
+			/**
+			 * \brief Get number of items left, known until the stage is split.
+			 * \return Exact SizeHint, or unknown
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return mRemaining >= 0 ? Enumerator::SizeHint::exact(mRemaining) : Enumerator::SizeHint::unknown();
+			}
+
+			/**
+			 * \brief Get source stage at the start of the chain.
+			 * \return Reference to this
+			 */
+			ListNodeStage & getOrigin()
+			{
+				return *this;
+			}
+
+			/**
+			 * \brief Walk the remaining nodes once, recording the first node of every segment, so copies can start mid list.
+			 * \return Number of split units, one per segment of SPLIT_SEGMENT_LENGTH nodes.
+			 */
+			int split()
+			{
+				static_assert(TCount::IsThreadSafe, "parallel() needs a list with thread safe reference counts.");
+				std::shared_ptr<std::vector<ListNode *> > segments = std::make_shared<std::vector<ListNode *> >();
+				int count = 0;
+				for (ListNode * node = mNext; node != mEnd; node = node->tail.get())
+				{
+					if (count++ % SPLIT_SEGMENT_LENGTH == 0) segments->push_back(node);
+				}
+				mSegments = segments;
+				return static_cast<int>(segments->size());
+			}
+
+			/**
+			 * \brief Get smallest number of split units worth running as a task.
+			 * \return Grain size
+			 */
+			int getSplitGrain() const
+			{
+				return 1;
+			}
+
+			/**
+			 * \brief Restrict a copy of the split stage to segments [begin, end).
+			 * \param begin First segment
+			 * \param end One past last segment
+			 */
+			void setSplitRange(int begin, int end)
+			{
+				const std::vector<ListNode *> & segments = *mSegments;
+				mNext = segments[begin];
+				mRemaining = -1;
+				if (end < static_cast<int>(segments.size())) mEnd = segments[end];
+			}
+
+		private:
+			NodePtr mRoot;
+			ListNode * mNext;
+			ListNode * mCurrent;
+
+			/**
+			 * \brief Node the stage stops at, nullptr for the end of the list.
+			 */
+			ListNode * mEnd;
+
+			/**
+			 * \brief Number of items left, negative if unknown. Only ever decremented, so unknown stays negative.
+			 */
+			int mRemaining;
+
+			/**
+			 * \brief First node of every segment, shared between copies after split().
+			 */
+			std::shared_ptr<std::vector<ListNode *> > mSegments;
+		};
+
+		/**
+		 * \brief Enumerator for internal linked list.
+		 * Walks raw node pointers, the root pointer keeps the whole chain alive so stepping never touches a reference count.
 		 */
 		class ListNodeEnumerator : public IEnumerator < T >
 		{
@@ -136,18 +477,16 @@ namespace MyList{
 
 			/**
 			 * \brief Initializes new ListNodeEnumerator starting from node.
-			 * \param node Shared pointer to a node.
+			 * \param node Pointer owning a node.
+			 * \param length Number of items from node
 			 */
-			ListNodeEnumerator(const std::shared_ptr<ListNode> &node) : mNext(node), mCurrent(nullptr) {}
+			ListNodeEnumerator(const NodePtr &node, int length) : mRoot(node), mNext(node.get()), mCurrent(nullptr), mRemaining(length) {}
 
 			/**
 			 * \brief Copy constructor
 			 * \param other ListNodeEnumerator
 			 */
-			ListNodeEnumerator(const ListNodeEnumerator & other) {
-				mNext = other.mNext;
-				mCurrent = other.mCurrent;
-			}
+			ListNodeEnumerator(const ListNodeEnumerator & other) : mRoot(other.mRoot), mNext(other.mNext), mCurrent(other.mCurrent), mRemaining(other.mRemaining) {}
 
 			/**
 			 * \brief Move to enumerator to next position
@@ -155,16 +494,42 @@ namespace MyList{
 			 */
 			bool moveNext() override;
 
+			/**
+			 * \brief Copy the heads of the next block of nodes.
+			 * \param out Buffer for at least max items.
+			 * \param max Maximum number of items.
+			 * \return Number of items copied, 0 if at end of list.
+			 */
+			int nextBatch(T * out, int max) override;
+
 			/**
 			 * \brief Get value at current position.
-			 * \return Value if Enumerator is valid, otherwise throw exception.
+			 * \return Reference to the head of the current node if Enumerator is valid, otherwise throw exception.
 			 */
-			T getCurrent() override
+			const T & getCurrent() override
 			{
 				if (!mCurrent) throw Exception::InvalidEnumerator();
 				return mCurrent->head;
 			}
 
+			/**
+			 * \brief Get number of items left.
+			 * \return Exact SizeHint
+			 */
+			SizeHint getSizeHint() const override
+			{
+				return SizeHint::exact(mRemaining);
+			}
+
+			/**
+			 * \brief Items are read from the nodes.
+			 * \return True
+			 */
+			bool isMaterialized() const override
+			{
+				return true;
+			}
+
 			/**
 			 * \brief Clone enumerator.
 			 * \return std::shared_ptr<IEnumerator<T> >
@@ -175,8 +540,10 @@ namespace MyList{
 			}
 
 		private:
-			std::shared_ptr<ListNode> mNext;
-			std::shared_ptr<ListNode> mCurrent;
+			NodePtr mRoot;
+			ListNode * mNext;
+			ListNode * mCurrent;
+			int mRemaining;
 		};
 	};
 }
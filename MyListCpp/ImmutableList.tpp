@@ -2,83 +2,146 @@
 
 namespace MyList
 {
-	template <typename T>
-	ImmutableList<T>::ImmutableList(const T * input, int length) : mLength(length), mNode(nullptr)
+	template <typename T, typename TCount>
+	ImmutableList<T, TCount>::ImmutableList(const T * input, int length) : mLength(length), mNode(nullptr)
 	{
-		// Iterate backwards over array and prepend new head for each value.
-		for (int i = length -1; i >= 0; --i){
-			mNode.reset(new ListNode(input[i], mNode));
+		// Append each value to the tail, so nodes are allocated in list order.
+		NodePtr * tail = &mNode;
+		for (int i = 0; i < length; ++i){
+			*tail = makeNode(input[i], NodePtr());
+			tail = &(*tail)->tail;
 		}
 	}
 
-	template <typename T>
-	ImmutableList<T>::ImmutableList(const IEnumerable<T> * list) : mLength(0), mNode(nullptr)
+	template <typename T, typename TCount>
+	ImmutableList<T, TCount>::ImmutableList(const IEnumerable<T> * list) : mLength(0), mNode(nullptr)
 	{
-		// Iterate over each value in list and append it to the tail.
 		auto enumerator = list->getEnumerator();
-		T value;
+		appendFrom(*enumerator, typename Memory::RawBuffer<T>::IsTrivial());
+	}
 
-		// Check if at least one value and create a new ListNode
-		if (enumerator->tryGetNext(value)){
-			mNode.reset(new ListNode(value, mNode));
-			auto current = mNode;
-			mLength = 1;
+	template <typename T, typename TCount>
+	void ImmutableList<T, TCount>::appendFrom(IEnumerator<T> & enumerator, std::true_type)
+	{
+		// Iterate over list a block at a time and append each value to the tail.
+		std::shared_ptr<T> batch = Memory::RawBuffer<T>::allocate(DEFAULT_BATCH_SIZE);
 
-			// Foreach value append new listnode to tail.
-			while (enumerator->tryGetNext(value))
+		// tail will always point to empty node at end of list.
+		NodePtr * tail = &mNode;
+		int count;
+		while ((count = enumerator.nextBatch(batch.get(), DEFAULT_BATCH_SIZE)) > 0)
+		{
+			for (int i = 0; i < count; ++i)
 			{
-				// current->tail will always point to empty node at end of list.
-				current->tail.reset(new ListNode(value, current->tail));
-				current = current->tail;
-				mLength++;
+				*tail = makeNode(batch.get()[i], NodePtr());
+				tail = &(*tail)->tail;
 			}
+			mLength += count;
+		}
+	}
+
+	template <typename T, typename TCount>
+	void ImmutableList<T, TCount>::appendFrom(IEnumerator<T> & enumerator, std::false_type)
+	{
+		NodePtr * tail = &mNode;
+		while (enumerator.moveNext())
+		{
+			*tail = makeNode(enumerator.getCurrent(), NodePtr());
+			tail = &(*tail)->tail;
+			++mLength;
+		}
+	}
+
+	template <typename T, typename TCount>
+	template <class TGrowth, int InlineCount>
+	ImmutableList<T, TCount>::ImmutableList(MutableList<T, TGrowth, InlineCount> && list) : mLength(0), mNode(nullptr)
+	{
+		// Own the buffer first, operator[] gives it a private copy if a snapshot still reads it.
+		MutableList<T, TGrowth, InlineCount> items(std::move(list));
+		NodePtr * tail = &mNode;
+		for (int i = 0; i < items.getLength(); ++i){
+			*tail = makeNode(std::move(items[i]), NodePtr());
+			tail = &(*tail)->tail;
 		}
+		mLength = items.getLength();
 	}
 
-	template <typename T>
-	ImmutableList<T>::ImmutableList(T head, const ImmutableList & tail){
+	template <typename T, typename TCount>
+	ImmutableList<T, TCount>::ImmutableList(T head, const ImmutableList & tail){
 		// Point this to new head and keep track of length.
-		mNode.reset(new ListNode(head, tail.mNode));
+		mNode = makeNode(head, tail.mNode);
 		mLength = tail.getLength() + 1;
 	}
 
-	template <class T>
-	T ImmutableList<T>::getHead() const
+	template <typename T, typename TCount>
+	T ImmutableList<T, TCount>::getHead() const
 	{
 		if (!mNode) throw Exception::EmptyListException();
 		return mNode->head;
 	}
 
-	template <typename T>
-	ImmutableList<T> ImmutableList<T>::reverse(){
+	template <typename T, typename TCount>
+	ImmutableList<T, TCount> ImmutableList<T, TCount>::reverse(){
 		// Iterate over list prepending each value to head of new list.
-		std::shared_ptr<ListNode> root(nullptr);
+		NodePtr root(nullptr);
 		auto enumerator = getEnumerator();
 		int length = 0;
 		while (enumerator->moveNext()){
 
 			// Point root to new head and keep track of length.
-			root.reset(new ListNode(enumerator->getCurrent(), root));
+			root = makeNode(enumerator->getCurrent(), root);
 			++length;
 		}
-		return ImmutableList<T>(root, length);
+		return ImmutableList<T, TCount>(root, length);
+	}
+
+	template <typename T, typename TCount>
+	template <class TStage>
+	ImmutableList<T, TCount> ImmutableList<T, TCount>::fromStage(TStage stage){
+		// Keep pointer to the empty tail at end of the list and fill it with each value.
+		typedef typename TStage::reference reference;
+		NodePtr root(nullptr);
+		NodePtr * tail = &root;
+		int length = 0;
+		stage.forEach([&tail, &length](reference value){
+			*tail = makeNode(std::forward<reference>(value), NodePtr());
+			tail = &(*tail)->tail;
+			++length;
+			return true;
+		});
+		return ImmutableList<T, TCount>(root, length);
 	}
 
-	template <typename T>
-	std::shared_ptr<Enumerator::IEnumerator<T> > ImmutableList<T>::getEnumerator() const {
+	template <typename T, typename TCount>
+	std::shared_ptr<Enumerator::IEnumerator<T> > ImmutableList<T, TCount>::getEnumerator() const {
 		// Create new enumerator pointing to head node.
-		return std::shared_ptr<IEnumerator<T> >(new ListNodeEnumerator(mNode));
+		return std::shared_ptr<IEnumerator<T> >(new ListNodeEnumerator(mNode, mLength));
 	}
 
-	template <typename T>
-	bool ImmutableList<T>::ListNodeEnumerator::moveNext(){
+	template <typename T, typename TCount>
+	bool ImmutableList<T, TCount>::ListNodeEnumerator::moveNext(){
 		// Check if at end of list or empty list.
 		if (mNext)
 		{
 			mCurrent = mNext;
-			mNext = mCurrent->tail;
+			mNext = mCurrent->tail.get();
+			--mRemaining;
 			return true;
 		}
 		return false;
 	}
+
+	template <typename T, typename TCount>
+	int ImmutableList<T, TCount>::ListNodeEnumerator::nextBatch(T * out, int max){
+		// Copy heads until the block is full or the list ends.
+		int count = 0;
+		while (mNext && count < max)
+		{
+			out[count++] = mNext->head;
+			mCurrent = mNext;
+			mNext = mNext->tail.get();
+		}
+		mRemaining -= count;
+		return count;
+	}
 }
@@ -0,0 +1,20 @@
+/**
+ *  Summary: Forward declaration of ImmutableList carrying the default reference counting policy.
+ *  Included before anything else by every header naming ImmutableList, so the default is seen first whatever the include order.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include "Memory/RefCount.h"
+
+namespace MyList{
+
+	/**
+	 * \brief Forward declaration
+	 * \tparam T Type of item to be stored in list.
+	 * \tparam TCount Reference counting policy for nodes, Memory::SharedCount or Memory::LocalCount.
+	 */
+	template<class T, class TCount = Memory::SharedCount>
+	class ImmutableList;
+}
@@ -0,0 +1,191 @@
+/**
+ *  Summary: Reads a file front to back in large blocks on a background thread, a few blocks ahead of the reader.
+ *  Memory is bounded by the number of blocks in flight, and the reader only waits when the disk is behind.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Exception/MyExceptions.h"
+
+#define FILE_BLOCK_BYTES (1024 * 1024)
+#define FILE_READ_AHEAD 4
+
+namespace MyList
+{
+	namespace Io
+	{
+		/**
+		 * \brief Reads a file in blocks on a background thread, up to a fixed number of blocks ahead of the consumer.
+		 * After the first, every read starts on a multiple of the block size, so reads stay aligned however the file is entered.
+		 * Belongs to a single consumer thread.
+		 */
+		class PrefetchReader
+		{
+		public:
+			/**
+			 * \brief Open a file and start reading ahead.
+			 * \param path File name. Throws Exception::FileException if it cannot be opened.
+			 * \param offset Position of the first byte to read
+			 * \param blockBytes Size of a block
+			 * \param depth Number of blocks, read ahead or held by the consumer. At least 2 so reading overlaps consuming.
+			 */
+			PrefetchReader(const std::string & path, long long offset, int blockBytes = FILE_BLOCK_BYTES, int depth = FILE_READ_AHEAD)
+				: mFile(path.c_str(), std::ios::binary), mBlockBytes(blockBytes), mOffset(offset), mFilled(0), mConsumed(0),
+				mHolding(false), mEnd(false), mError(false), mStop(false)
+			{
+				if (!mFile || !mFile.seekg(offset)) throw Exception::FileException();
+				for (int i = 0; i < (depth < 2 ? 2 : depth); ++i)
+				{
+					mBlocks.push_back(Block(new char[blockBytes]));
+					mSizes.push_back(0);
+				}
+				mThread = std::thread([this]{ run(); });
+			}
+
+			/**
+			 * \brief Stop reading ahead and wait for the background thread.
+			 */
+			~PrefetchReader()
+			{
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					mStop = true;
+				}
+				mFree.notify_one();
+				mThread.join();
+			}
+
+			/**
+			 * \brief Release the block returned last and get the next one, waiting until it is read.
+			 * \param size Set to the number of bytes in the block, 0 at end of file.
+			 * \return First byte of the block, valid until the next call. Throws Exception::FileException if reading failed.
+			 */
+			const char * next(int & size)
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				if (mHolding)
+				{
+					++mConsumed;
+					mHolding = false;
+					mFree.notify_one();
+				}
+				while (mFilled == mConsumed && !mEnd)
+				{
+					mReady.wait(lock);
+				}
+				if (mFilled == mConsumed)
+				{
+					if (mError) throw Exception::FileException();
+					size = 0;
+					return nullptr;
+				}
+
+				mHolding = true;
+				const size_t slot = mConsumed % mBlocks.size();
+				size = mSizes[slot];
+				return mBlocks[slot].get();
+			}
+
+		private:
+			PrefetchReader(const PrefetchReader & other);
+			PrefetchReader & operator=(const PrefetchReader & other);
+
+			typedef std::unique_ptr<char[]> Block;
+
+			/**
+			 * \brief Background thread, fills free blocks in order until the end of the file or until stopped.
+			 */
+			void run()
+			{
+				// Read up to the next block boundary first, then whole aligned blocks.
+				int want = mBlockBytes - static_cast<int>(mOffset % mBlockBytes);
+				while (true)
+				{
+					size_t slot;
+					{
+						std::unique_lock<std::mutex> lock(mMutex);
+						while (mFilled - mConsumed == mBlocks.size() && !mStop)
+						{
+							mFree.wait(lock);
+						}
+						if (mStop) return;
+						slot = mFilled % mBlocks.size();
+					}
+
+					// The slot is neither held nor waited for by the consumer, read into it without the lock.
+					mFile.read(mBlocks[slot].get(), want);
+					const int read = static_cast<int>(mFile.gcount());
+					const bool error = mFile.bad();
+					want = mBlockBytes;
+
+					std::unique_lock<std::mutex> lock(mMutex);
+					if (read > 0)
+					{
+						mSizes[slot] = read;
+						++mFilled;
+					}
+					if (error || read == 0 || mFile.eof())
+					{
+						mError = error;
+						mEnd = true;
+						mReady.notify_one();
+						return;
+					}
+					mReady.notify_one();
+				}
+			}
+
+			std::ifstream mFile;
+
+			std::vector<Block> mBlocks;
+
+			/**
+			 * \brief Number of bytes read into each block.
+			 */
+			std::vector<int> mSizes;
+
+			int mBlockBytes;
+
+			long long mOffset;
+
+			/**
+			 * \brief Number of blocks read, and number the consumer is done with. Block i is in slot i % mBlocks.size().
+			 */
+			size_t mFilled;
+
+			size_t mConsumed;
+
+			/**
+			 * \brief True while the consumer reads block mConsumed.
+			 */
+			bool mHolding;
+
+			/**
+			 * \brief Set by the background thread once it read its last block, mError if that was because reading failed.
+			 */
+			bool mEnd;
+
+			bool mError;
+
+			bool mStop;
+
+			std::mutex mMutex;
+
+			/**
+			 * \brief Signalled when a block has been read, and when the consumer releases one.
+			 */
+			std::condition_variable mReady;
+
+			std::condition_variable mFree;
+
+			std::thread mThread;
+		};
+	}
+}
@@ -6,6 +6,7 @@
 #pragma once
 #include<memory>
 
+#include "Enumerator/CachingEnumerator.h"
 #include "Enumerator/IEnumerator.h"
 
 namespace MyList{
@@ -36,6 +37,15 @@ namespace MyList{
 			return mEnumerator->clone();
 		}
 
+		/**
+		 * \brief Get a memoizing copy of this list. Every item is evaluated once, by whichever enumeration reaches it first,
+		 * and recorded; all later and concurrent enumerations of the copy read the recording. This list is unaffected.
+		 * \return LazyList reading through a shared CachingEnumerator.
+		 */
+		LazyList cached() const {
+			return LazyList(std::make_shared<CachingEnumerator<T> >(mEnumerator->clone()));
+		}
+
 	private:
 		std::shared_ptr<IEnumerator<T> > mEnumerator;
 	};
@@ -0,0 +1,48 @@
+/**
+ *  Summary: Process wide instance created on first use from any thread, portable back to VS2013 whose local statics
+ *  are not initialized thread safely.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <mutex>
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Process wide instance of T, created through std::call_once on a flag with static storage and never destroyed,
+		 * so objects still released by static destructors at exit can use it.
+		 * \tparam T Type of instance
+		 */
+		template<class T>
+		class Global
+		{
+		public:
+			/**
+			 * \brief Get the instance, creating it if no thread has yet.
+			 * \tparam TCreate Type of callable returning a new T, owned by Global.
+			 * \param create Only called by the first caller.
+			 * \return Reference to the instance
+			 */
+			template<class TCreate>
+			static T & get(TCreate create)
+			{
+				std::call_once(mOnce, [&create](){ mInstance = create(); });
+				return *mInstance;
+			}
+
+		private:
+			static std::once_flag mOnce;
+
+			static T * mInstance;
+		};
+
+		template<class T>
+		std::once_flag Global<T>::mOnce;
+
+		template<class T>
+		T * Global<T>::mInstance = nullptr;
+	}
+}
@@ -0,0 +1,113 @@
+/**
+ *  Summary: Growth policies for MutableList buffers. A policy picks the next capacity once a buffer is full,
+ *  and whether large buffers are mapped so they can grow in place (see RawBuffer::tryResize).
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <cstddef>
+#include <limits>
+
+#define HUGE_PAGE_BYTES (2 * 1024 * 1024)
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Clamp a capacity computed in a wider type to the int range of list lengths.
+		 * \param capacity Proposed capacity
+		 * \param required Smallest acceptable capacity
+		 * \return Capacity, at least required
+		 */
+		inline int clampCapacity(long long capacity, int required)
+		{
+			if (capacity > std::numeric_limits<int>::max()) capacity = std::numeric_limits<int>::max();
+			return capacity < required ? required : static_cast<int>(capacity);
+		}
+
+		/**
+		 * \brief Multiply capacity by Numerator / Denominator, e.g. FactorGrowth<3, 2> grows by half.
+		 * \tparam Numerator Numerator of the factor
+		 * \tparam Denominator Denominator of the factor, less than Numerator.
+		 */
+		template<int Numerator, int Denominator>
+		struct FactorGrowth
+		{
+			static_assert(Numerator > Denominator && Denominator > 0, "Growth factor must be greater than one");
+
+			enum { InPlace = 0 };
+
+			/**
+			 * \brief Get capacity of the next buffer.
+			 * \param capacity Current capacity
+			 * \param required Number of items the next buffer must hold
+			 * \param itemSize Size of an item in bytes
+			 * \return New capacity, at least required
+			 */
+			static int getCapacity(int capacity, int required, size_t itemSize)
+			{
+				// Small buffers always get at least one more slot.
+				long long next = static_cast<long long>(capacity) * Numerator / Denominator;
+				return clampCapacity(next > capacity ? next : capacity + 1, required);
+			}
+		};
+
+		/**
+		 * \brief Double capacity, the default.
+		 */
+		typedef FactorGrowth<2, 1> DoublingGrowth;
+
+		/**
+		 * \brief Add a fixed number of items, memory overhead stays bounded at the cost of more frequent growth.
+		 * \tparam Items Number of items added per step
+		 */
+		template<int Items>
+		struct IncrementGrowth
+		{
+			static_assert(Items > 0, "Growth increment must be positive");
+
+			enum { InPlace = 0 };
+
+			static int getCapacity(int capacity, int required, size_t itemSize)
+			{
+				return clampCapacity(static_cast<long long>(capacity) + Items, required);
+			}
+		};
+
+		/**
+		 * \brief Grow to the next multiple of PageBytes, so large buffers always span whole huge pages.
+		 * Every step is one page, pair with RemapGrowth so a step remaps pages rather than copying the buffer.
+		 * \tparam PageBytes Step in bytes
+		 */
+		template<size_t PageBytes = HUGE_PAGE_BYTES>
+		struct PageGrowth
+		{
+			enum { InPlace = 0 };
+
+			static int getCapacity(int capacity, int required, size_t itemSize)
+			{
+				long long bytes = static_cast<long long>(required > capacity + 1 ? required : capacity + 1) * itemSize;
+				bytes = (bytes + PageBytes - 1) / PageBytes * PageBytes;
+				return clampCapacity(bytes / static_cast<long long>(itemSize), required);
+			}
+		};
+
+		/**
+		 * \brief Capacities of TBase, but buffers of trivially copyable items from HUGE_PAGE_BYTES up are mapped
+		 * directly from the system and grown with mremap where available. Growth then never holds old and new
+		 * buffer at once and does not copy the items. Other buffers grow as usual.
+		 * \tparam TBase Policy picking the capacities
+		 */
+		template<class TBase = DoublingGrowth>
+		struct RemapGrowth
+		{
+			enum { InPlace = 1 };
+
+			static int getCapacity(int capacity, int required, size_t itemSize)
+			{
+				return TBase::getCapacity(capacity, required, itemSize);
+			}
+		};
+	}
+}
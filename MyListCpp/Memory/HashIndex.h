@@ -0,0 +1,153 @@
+/**
+ *  Summary: Open addressing hash index over entries stored elsewhere, e.g. in a MutableList.
+ *  The table only holds entry numbers and the entries' hashes, so growing it never moves the entries themselves.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define HASH_INDEX_MIN_SLOTS 16
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Open addressing hash index with linear probing over entries numbered 0, 1, 2... in insertion order.
+		 * Slots are a power of two and kept under three quarters full. Entries are never removed, so there are no tombstones.
+		 * Hashes are mixed by Fibonacci hashing, so identity hashes of regular keys still spread over the table.
+		 */
+		class HashIndex
+		{
+		public:
+			/**
+			 * \brief Create index sized for a number of entries.
+			 * \param expected Number of entries to hold without growing.
+			 */
+			explicit HashIndex(int expected = 0) : mShift(64)
+			{
+				reserve(expected);
+			}
+
+			/**
+			 * \brief Get number of entries.
+			 * \return Count
+			 */
+			int getLength() const
+			{
+				return static_cast<int>(mHashes.size());
+			}
+
+			/**
+			 * \brief Make sure count entries fit without growing. Never shrinks.
+			 * \param count Number of entries
+			 */
+			void reserve(int count)
+			{
+				size_t slots = HASH_INDEX_MIN_SLOTS;
+				while (slots * 3 < static_cast<size_t>(count) * 4) slots *= 2;
+				if (slots > mSlots.size()) rehash(slots);
+				mHashes.reserve(count);
+			}
+
+			/**
+			 * \brief Find the entry with a key.
+			 * \tparam TEqual Type of callable taking an entry number
+			 * \param hash Hash of the key
+			 * \param equal Checks whether an entry holds the key, only called for entries of the same hash.
+			 * \return Entry number, -1 if there is none.
+			 */
+			template<class TEqual>
+			int find(size_t hash, TEqual equal) const
+			{
+				if (mSlots.empty()) return -1;
+				const size_t mask = mSlots.size() - 1;
+				for (size_t slot = getSlot(hash);; slot = (slot + 1) & mask)
+				{
+					const int entry = mSlots[slot];
+					if (entry < 0) return -1;
+					if (mHashes[entry] == hash && equal(entry)) return entry;
+				}
+			}
+
+			/**
+			 * \brief Find the entry with a key, adding it if there is none.
+			 * \tparam TEqual Type of callable taking an entry number
+			 * \param hash Hash of the key
+			 * \param equal Checks whether an entry holds the key, only called for entries of the same hash.
+			 * \param added Set to True if the key was added. The caller then stores the new entry under the returned number.
+			 * \return Entry number
+			 */
+			template<class TEqual>
+			int insert(size_t hash, TEqual equal, bool & added)
+			{
+				if ((mHashes.size() + 1) * 4 > mSlots.size() * 3) rehash(mSlots.empty() ? HASH_INDEX_MIN_SLOTS : mSlots.size() * 2);
+
+				const size_t mask = mSlots.size() - 1;
+				size_t slot = getSlot(hash);
+				for (;; slot = (slot + 1) & mask)
+				{
+					const int entry = mSlots[slot];
+					if (entry < 0) break;
+					if (mHashes[entry] == hash && equal(entry))
+					{
+						added = false;
+						return entry;
+					}
+				}
+
+				const int entry = static_cast<int>(mHashes.size());
+				mSlots[slot] = entry;
+				mHashes.push_back(hash);
+				added = true;
+				return entry;
+			}
+
+		private:
+			/**
+			 * \brief Get home slot of a hash, from its top bits after multiplying by 2^64 / golden ratio.
+			 */
+			size_t getSlot(size_t hash) const
+			{
+				return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> mShift);
+			}
+
+			/**
+			 * \brief Rebuild the slots with a new size, from the stored hashes. Entries keep their numbers.
+			 * \param slots Number of slots, a power of two.
+			 */
+			void rehash(size_t slots)
+			{
+				mSlots.assign(slots, -1);
+				mShift = 64;
+				for (size_t size = slots; size > 1; size /= 2) --mShift;
+
+				const size_t mask = slots - 1;
+				for (size_t entry = 0; entry < mHashes.size(); ++entry)
+				{
+					size_t slot = getSlot(mHashes[entry]);
+					while (mSlots[slot] >= 0) slot = (slot + 1) & mask;
+					mSlots[slot] = static_cast<int>(entry);
+				}
+			}
+
+			/**
+			 * \brief Entry number in every used slot, -1 in free ones.
+			 */
+			std::vector<int> mSlots;
+
+			/**
+			 * \brief Hash of every entry, by entry number.
+			 */
+			std::vector<size_t> mHashes;
+
+			/**
+			 * \brief 64 minus log2 of the number of slots.
+			 */
+			int mShift;
+		};
+	}
+}
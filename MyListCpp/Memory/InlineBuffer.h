@@ -0,0 +1,58 @@
+/**
+ *  Summary: Fixed number of uninitialized slots stored inside the owning object, for small buffer optimization.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <type_traits>
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Count uninitialized slots stored inline. The owner constructs and destroys the items.
+		 * \tparam T Type of item
+		 * \tparam Count Number of slots
+		 */
+		template<class T, int Count>
+		class InlineBuffer
+		{
+		public:
+			/**
+			 * \brief Get slots as items.
+			 * \return Pointer to slot 0
+			 */
+			T * items()
+			{
+				return reinterpret_cast<T *>(mStorage);
+			}
+
+			const T * items() const
+			{
+				return reinterpret_cast<const T *>(mStorage);
+			}
+
+		private:
+			typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type mStorage[Count];
+		};
+
+		/**
+		 * \brief No inline slots.
+		 */
+		template<class T>
+		class InlineBuffer<T, 0>
+		{
+		public:
+			T * items()
+			{
+				return nullptr;
+			}
+
+			const T * items() const
+			{
+				return nullptr;
+			}
+		};
+	}
+}
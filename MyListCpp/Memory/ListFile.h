@@ -0,0 +1,275 @@
+/**
+ *  Summary: On-disk format for lists of trivially copyable items, and mapping such a file read-only.
+ *  A file is a fixed header (format version, item size and alignment, length, checksum) followed by the raw items,
+ *  so loading it is a single map of the file and no item is read until it is used.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <fstream>
+#include <memory>
+#include <type_traits>
+#include "../Exception/MyExceptions.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define LIST_FILE_VERSION 1
+#define LIST_FILE_ALIGNMENT 64
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Header at the start of a list file. Every field has a fixed size, the payload starts at payloadOffset.
+		 */
+		struct ListFileHeader
+		{
+			/**
+			 * \brief "MYLIST" padded with zeros.
+			 */
+			char magic[8];
+
+			/**
+			 * \brief Format version, LIST_FILE_VERSION when written.
+			 */
+			uint32_t version;
+
+			/**
+			 * \brief 0x01020304 as written, reads differently on a machine of the other byte order.
+			 */
+			uint32_t byteOrder;
+
+			/**
+			 * \brief sizeof and alignof the item type that was written.
+			 */
+			uint32_t itemSize;
+
+			uint32_t itemAlignment;
+
+			/**
+			 * \brief Number of items.
+			 */
+			uint64_t length;
+
+			/**
+			 * \brief Checksum of the payload, see ListFile::checksum.
+			 */
+			uint64_t checksum;
+
+			/**
+			 * \brief Offset of item 0 from the start of the file, a multiple of the item alignment.
+			 */
+			uint64_t payloadOffset;
+		};
+
+		/**
+		 * \brief Read-only mapping of a whole file, shared by everything reading it and unmapped by the last owner.
+		 */
+		class FileMapping
+		{
+		public:
+			/**
+			 * \brief Map a file read-only.
+			 * \param path File name
+			 * \param size Set to the size of the file in bytes.
+			 * \return Pointer to the first byte, owning the mapping. Throws Exception::FileException if the file cannot be mapped.
+			 */
+			static std::shared_ptr<const char> map(const char * path, size_t & size)
+			{
+#if defined(_WIN32)
+				HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE) throw Exception::FileException();
+				LARGE_INTEGER fileSize;
+				if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+				{
+					CloseHandle(file);
+					throw Exception::FileException();
+				}
+				HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				CloseHandle(file);
+				if (mapping == nullptr) throw Exception::FileException();
+
+				// The view keeps the mapping open on its own.
+				void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+				if (view == nullptr) throw Exception::FileException();
+				size = static_cast<size_t>(fileSize.QuadPart);
+				return std::shared_ptr<const char>(static_cast<const char *>(view), Unmap());
+#else
+				int file = open(path, O_RDONLY);
+				if (file < 0) throw Exception::FileException();
+				struct stat status;
+				if (fstat(file, &status) != 0 || status.st_size == 0)
+				{
+					close(file);
+					throw Exception::FileException();
+				}
+				size = static_cast<size_t>(status.st_size);
+
+				// Pages are read on first touch, the mapping outlives the descriptor.
+				void * pages = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+				close(file);
+				if (pages == MAP_FAILED) throw Exception::FileException();
+				return std::shared_ptr<const char>(static_cast<const char *>(pages), Unmap(size));
+#endif
+			}
+
+		private:
+			/**
+			 * \brief Deleter unmapping the file.
+			 */
+			struct Unmap
+			{
+#if defined(_WIN32)
+				void operator()(const char * view) const
+				{
+					UnmapViewOfFile(view);
+				}
+#else
+				explicit Unmap(size_t size) : size(size){}
+
+				void operator()(const char * pages) const
+				{
+					munmap(const_cast<char *>(pages), size);
+				}
+
+				size_t size;
+#endif
+			};
+		};
+
+		/**
+		 * \brief Writes lists to files and maps them back. Only the item size and alignment are recorded,
+		 * a file must be mapped with the item type it was written with.
+		 * \tparam T Type of item, trivially copyable so the bytes of an item are the item.
+		 */
+		template<class T>
+		class ListFile
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable items can be written as raw bytes");
+
+		public:
+			/**
+			 * \brief Write items to a file, replacing it.
+			 * \param path File name
+			 * \param items First item
+			 * \param length Number of items
+			 */
+			static void write(const char * path, const T * items, int length)
+			{
+				const size_t bytes = static_cast<size_t>(length) * sizeof(T);
+				ListFileHeader header = makeHeader(length, checksum(items, bytes));
+
+				std::ofstream file(path, std::ios::binary | std::ios::trunc);
+				if (!file) throw Exception::FileException();
+				file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+				// Zeros up to the payload, so item 0 is aligned in a mapping.
+				for (size_t i = sizeof(header); i < header.payloadOffset; ++i) file.put(0);
+				if (bytes > 0) file.write(reinterpret_cast<const char *>(items), static_cast<std::streamsize>(bytes));
+				file.close();
+				if (!file) throw Exception::FileException();
+			}
+
+			/**
+			 * \brief Map a file written by write, read-only. Nothing is copied, items are paged in as they are read.
+			 * The file must not change while the mapping is in use.
+			 * \param path File name
+			 * \param verify Check the payload against its checksum, which reads the whole file.
+			 * \param length Set to the number of items.
+			 * \return Pointer to item 0, owning the mapping. Throws Exception::InvalidFileFormat if the file does not hold
+			 * items of this size and alignment, is truncated or, when verifying, is corrupt.
+			 */
+			static std::shared_ptr<T> map(const char * path, bool verify, int & length)
+			{
+				size_t size;
+				std::shared_ptr<const char> file = FileMapping::map(path, size);
+				if (size < sizeof(ListFileHeader)) throw Exception::InvalidFileFormat();
+
+				ListFileHeader header;
+				memcpy(&header, file.get(), sizeof(header));
+				const ListFileHeader expected = makeHeader(0, 0);
+				if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version ||
+					header.byteOrder != expected.byteOrder || header.itemSize != expected.itemSize ||
+					header.itemAlignment != expected.itemAlignment || header.payloadOffset % std::alignment_of<T>::value != 0 ||
+					header.length > static_cast<uint64_t>(INT_MAX) ||
+					header.payloadOffset > size || (size - header.payloadOffset) / sizeof(T) < header.length)
+				{
+					throw Exception::InvalidFileFormat();
+				}
+
+				const T * items = reinterpret_cast<const T *>(file.get() + header.payloadOffset);
+				if (verify && checksum(items, static_cast<size_t>(header.length) * sizeof(T)) != header.checksum)
+				{
+					throw Exception::InvalidFileFormat();
+				}
+
+				// Point at item 0 and share ownership of the whole mapping. Readers must not write through it.
+				length = static_cast<int>(header.length);
+				return std::shared_ptr<T>(file, const_cast<T *>(items));
+			}
+
+			/**
+			 * \brief FNV-1a over 64 bit words, then over the trailing bytes. Catches truncation and damage, not tampering.
+			 * \param items First item
+			 * \param bytes Size in bytes
+			 * \return Checksum
+			 */
+			static uint64_t checksum(const T * items, size_t bytes)
+			{
+				const uint64_t prime = 1099511628211ULL;
+				uint64_t hash = 14695981039346656037ULL;
+				const char * data = reinterpret_cast<const char *>(items);
+				size_t i = 0;
+				for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t))
+				{
+					uint64_t word;
+					memcpy(&word, data + i, sizeof(word));
+					hash = (hash ^ word) * prime;
+				}
+				for (; i < bytes; ++i)
+				{
+					hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+				}
+				return hash;
+			}
+
+		private:
+			static ListFileHeader makeHeader(int length, uint64_t sum)
+			{
+				ListFileHeader header;
+				memset(&header, 0, sizeof(header));
+				memcpy(header.magic, "MYLIST", 6);
+				header.version = LIST_FILE_VERSION;
+				header.byteOrder = 0x01020304;
+				header.itemSize = sizeof(T);
+				header.itemAlignment = std::alignment_of<T>::value;
+				header.length = static_cast<uint64_t>(length);
+				header.checksum = sum;
+
+				// Past the header, on a cache line or the item alignment if that is larger.
+				const size_t alignment = std::alignment_of<T>::value > LIST_FILE_ALIGNMENT ? std::alignment_of<T>::value : LIST_FILE_ALIGNMENT;
+				header.payloadOffset = (sizeof(header) + alignment - 1) / alignment * alignment;
+				return header;
+			}
+		};
+	}
+}
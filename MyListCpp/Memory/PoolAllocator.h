@@ -0,0 +1,286 @@
+/**
+ *  Summary: Slab pool for fixed size nodes and a standard allocator that draws single objects from it.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Global.h"
+#include "ThreadLocal.h"
+
+#define POOL_BATCH_SIZE 256
+#define POOL_SLAB_BATCHES 16
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Process wide pool of blocks of one size, carved from large slabs.
+		 * Every thread allocates from and frees to its own cache without locking. Caches exchange whole batches of
+		 * POOL_BATCH_SIZE blocks with the shared pool, so consecutive allocations of a thread are adjacent in memory
+		 * and a thread that frees what another allocated hands the blocks back instead of hoarding them.
+		 * A thread hands its whole cache back when it exits. Slabs are kept for the life of the process.
+		 * \tparam Size Size of a block in bytes
+		 * \tparam Align Alignment of a block
+		 */
+		template<size_t Size, size_t Align>
+		class NodePool
+		{
+		public:
+			/**
+			 * \brief Get a block.
+			 * \return Pointer to uninitialized block of Size bytes
+			 */
+			static void * allocate()
+			{
+				Cache & cache = getCache();
+				if (!cache.head)
+				{
+					cache.head = getShared().takeBatch(cache.count);
+				}
+				FreeBlock * block = cache.head;
+				cache.head = block->next;
+				--cache.count;
+				return block;
+			}
+
+			/**
+			 * \brief Return a block, from any thread.
+			 * \param pointer Block from allocate()
+			 */
+			static void deallocate(void * pointer)
+			{
+				Cache & cache = getCache();
+				FreeBlock * block = static_cast<FreeBlock *>(pointer);
+				block->next = cache.head;
+				cache.head = block;
+				++cache.count;
+
+				// Keep one batch cached, hand the one above it back.
+				if (cache.count == 2 * POOL_BATCH_SIZE)
+				{
+					FreeBlock * last = cache.head;
+					for (int i = 1; i < POOL_BATCH_SIZE; ++i)
+					{
+						last = last->next;
+					}
+					FreeBlock * batch = cache.head;
+					cache.head = last->next;
+					last->next = nullptr;
+					cache.count -= POOL_BATCH_SIZE;
+					getShared().giveBatch(batch, POOL_BATCH_SIZE);
+				}
+			}
+
+		private:
+			struct FreeBlock
+			{
+				FreeBlock * next;
+			};
+
+			/**
+			 * \brief Block size, large enough for a free list link and a multiple of the alignment.
+			 */
+			static const size_t BlockSize = ((Size > sizeof(FreeBlock) ? Size : sizeof(FreeBlock)) + Align - 1) / Align * Align;
+
+			/**
+			 * \brief Per thread free list, plain data so it can be thread local.
+			 */
+			struct Cache
+			{
+				FreeBlock * head;
+				int count;
+
+				/**
+				 * \brief Whether the exit hook of the pool is armed for this thread.
+				 */
+				bool hooked;
+			};
+
+			/**
+			 * \brief Batches and slabs shared by every thread.
+			 */
+			class Shared
+			{
+			public:
+				Shared() : mExitHook(&NodePool::flushCache){}
+
+				/**
+				 * \brief Take a batch of free blocks.
+				 * \param count Set to the number of blocks in the batch.
+				 * \return First block of the batch
+				 */
+				FreeBlock * takeBatch(int & count)
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					if (mBatches.empty()) addSlab();
+					FreeBlock * batch = mBatches.back().first;
+					count = mBatches.back().second;
+					mBatches.pop_back();
+					return batch;
+				}
+
+				/**
+				 * \brief Give back a batch of free blocks, usually POOL_BATCH_SIZE of them, fewer or more from an exiting thread.
+				 * \param batch First block of the batch
+				 * \param count Number of blocks in the batch
+				 */
+				void giveBatch(FreeBlock * batch, int count)
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					mBatches.push_back(std::make_pair(batch, count));
+				}
+
+				/**
+				 * \brief Have the calling thread's cache handed back when it exits.
+				 * \param cache Cache of the calling thread
+				 */
+				void hook(Cache & cache)
+				{
+					mExitHook.arm(&cache);
+					cache.hooked = true;
+				}
+
+			private:
+				void addSlab()
+				{
+					char * slab = static_cast<char *>(::operator new(BlockSize * POOL_BATCH_SIZE * POOL_SLAB_BATCHES));
+					mSlabs.push_back(slab);
+
+					// Link every batch in address order, pushed last to first so the lowest addresses are taken first.
+					for (int batch = POOL_SLAB_BATCHES - 1; batch >= 0; --batch)
+					{
+						char * first = slab + batch * BlockSize * POOL_BATCH_SIZE;
+						for (int i = 0; i < POOL_BATCH_SIZE; ++i)
+						{
+							reinterpret_cast<FreeBlock *>(first + i * BlockSize)->next = i + 1 < POOL_BATCH_SIZE ? reinterpret_cast<FreeBlock *>(first + (i + 1) * BlockSize) : nullptr;
+						}
+						mBatches.push_back(std::make_pair(reinterpret_cast<FreeBlock *>(first), POOL_BATCH_SIZE));
+					}
+				}
+
+				std::mutex mMutex;
+				std::vector<std::pair<FreeBlock *, int> > mBatches;
+				std::vector<char *> mSlabs;
+				ThreadExitHook mExitHook;
+			};
+
+			static Cache & getCache()
+			{
+				static MYLIST_THREAD_LOCAL Cache cache = { nullptr, 0, false };
+				if (!cache.hooked) getShared().hook(cache);
+				return cache;
+			}
+
+			/**
+			 * \brief Hand the cache of an exiting thread back to the shared pool.
+			 * \param value Cache of the thread
+			 */
+			static void MYLIST_THREAD_EXIT_CALLBACK flushCache(void * value)
+			{
+				Cache & cache = *static_cast<Cache *>(value);
+				if (cache.head) getShared().giveBatch(cache.head, cache.count);
+				cache.head = nullptr;
+				cache.count = 0;
+
+				// Blocks freed later in the thread's exit arm the hook again.
+				cache.hooked = false;
+			}
+
+			static Shared & getShared()
+			{
+				// Never destroyed, blocks may still be freed by other static destructors at exit.
+				return Global<Shared>::get([](){ return new Shared(); });
+			}
+		};
+
+		/**
+		 * \brief Standard allocator drawing single objects from the NodePool for their size, larger requests use operator new.
+		 * Stateless, so containers and std::allocate_shared store it for free.
+		 * \tparam T Type of object
+		 */
+		template<class T>
+		class PoolAllocator
+		{
+		public:
+			typedef T value_type;
+			typedef T * pointer;
+			typedef const T * const_pointer;
+			typedef T & reference;
+			typedef const T & const_reference;
+			typedef size_t size_type;
+			typedef ptrdiff_t difference_type;
+
+			template<class U>
+			struct rebind
+			{
+				typedef PoolAllocator<U> other;
+			};
+
+			PoolAllocator(){}
+
+			template<class U>
+			PoolAllocator(const PoolAllocator<U> &){}
+
+			/**
+			 * \brief Allocate uninitialized storage.
+			 * \param count Number of objects
+			 * \return Pointer to storage
+			 */
+			T * allocate(size_t count)
+			{
+				if (count == 1) return static_cast<T *>(Pool::allocate());
+				return static_cast<T *>(::operator new(count * sizeof(T)));
+			}
+
+			/**
+			 * \brief Free storage from allocate.
+			 * \param pointer Storage
+			 * \param count Number of objects passed to allocate
+			 */
+			void deallocate(T * pointer, size_t count)
+			{
+				if (count == 1) Pool::deallocate(pointer);
+				else ::operator delete(pointer);
+			}
+
+			template<class U, class... TArgs>
+			void construct(U * pointer, TArgs &&... args)
+			{
+				::new (static_cast<void *>(pointer)) U(std::forward<TArgs>(args)...);
+			}
+
+			template<class U>
+			void destroy(U * pointer)
+			{
+				pointer->~U();
+			}
+
+			size_t max_size() const
+			{
+				return static_cast<size_t>(-1) / sizeof(T);
+			}
+
+			T * address(T & value) const { return &value; }
+
+			const T * address(const T & value) const { return &value; }
+
+		private:
+			typedef NodePool<sizeof(T), std::alignment_of<T>::value> Pool;
+		};
+
+		template<class T, class U>
+		bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &){ return true; }
+
+		template<class T, class U>
+		bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &){ return false; }
+	}
+}
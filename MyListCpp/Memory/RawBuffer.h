@@ -0,0 +1,262 @@
+/**
+ *  Summary: Shared buffers of uninitialized slots, and copying and moving items into such slots.
+ *  Trivially copyable items are copied with memcpy, everything else is constructed in place one item at a time.
+ *  Large buffers can be mapped straight from the system and, on Linux, resized in place with mremap.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MYLIST_HAS_MREMAP
+#endif
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Buffer of capacity uninitialized slots owned by a std::shared_ptr.
+		 * A count stored in front of the slots says how many items from slot 0 are constructed; the last owner destroys
+		 * exactly those, so a buffer can be handed to enumerators and outlive the container that fills it.
+		 * The shared_ptr points at slot 0 but owns the whole block through its deleter, so a resized block keeps its owners.
+		 * \tparam T Type of item
+		 */
+		template<class T>
+		class RawBuffer
+		{
+		public:
+			/**
+			 * \brief True if items can be copied and moved with memcpy.
+			 */
+			typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value> IsTrivial;
+
+			/**
+			 * \brief Allocate buffer, no slot is constructed.
+			 * \param capacity Number of slots
+			 * \param mapped Map the block straight from the system so tryResize can grow it, ignored where unsupported.
+			 * \return Pointer to slot 0
+			 */
+			static std::shared_ptr<T> allocate(int capacity, bool mapped = false)
+			{
+				const size_t bytes = HeaderSize + static_cast<size_t>(capacity) * sizeof(T);
+				size_t mappedBytes = 0;
+				char * block;
+#if defined(MYLIST_HAS_MREMAP)
+				if (mapped)
+				{
+					mappedBytes = roundToPages(bytes);
+					void * pages = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if (pages == MAP_FAILED) throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+					madvise(pages, mappedBytes, MADV_HUGEPAGE);
+#endif
+					block = static_cast<char *>(pages);
+				}
+				else
+#endif
+				{
+					block = static_cast<char *>(::operator new(bytes));
+				}
+
+				Header * header = ::new (static_cast<void *>(block)) Header();
+				header->count = 0;
+				header->mappedBytes = mappedBytes;
+				T * items = reinterpret_cast<T *>(block + HeaderSize);
+				return std::shared_ptr<T>(items, Release(items));
+			}
+
+			/**
+			 * \brief Resize a mapped buffer in place, the system moves its pages if it cannot extend them.
+			 * Only for trivially copyable items, and only while buffer is the sole owner.
+			 * \param buffer Buffer from allocate, updated to the new address.
+			 * \param capacity New number of slots, at least the count of constructed items.
+			 * \return False if the buffer is not mapped, is shared or could not be resized; it is unchanged then.
+			 */
+			static bool tryResize(std::shared_ptr<T> & buffer, int capacity)
+			{
+				static_assert(IsTrivial::value, "Only trivially copyable items can be moved by remapping");
+#if defined(MYLIST_HAS_MREMAP)
+				Header & header = getHeader(buffer.get());
+				if (header.mappedBytes == 0 || buffer.use_count() != 1) return false;
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				const size_t bytes = roundToPages(HeaderSize + static_cast<size_t>(capacity) * sizeof(T));
+				void * pages = mremap(reinterpret_cast<char *>(buffer.get()) - HeaderSize, header.mappedBytes, bytes, MREMAP_MAYMOVE);
+				if (pages == MAP_FAILED) return false;
+
+				// Point the deleter and the pointer at the new address, neither step allocates.
+				reinterpret_cast<Header *>(pages)->mappedBytes = bytes;
+				T * items = reinterpret_cast<T *>(static_cast<char *>(pages) + HeaderSize);
+				std::get_deleter<Release>(buffer)->items = items;
+				buffer = std::shared_ptr<T>(buffer, items);
+				return true;
+#else
+				return false;
+#endif
+			}
+
+			/**
+			 * \brief Get number of constructed items of a buffer from allocate, update it after constructing or destroying.
+			 * \param items Pointer to slot 0
+			 * \return Reference to the count
+			 */
+			static int & getCount(T * items)
+			{
+				return getHeader(items).count;
+			}
+
+			/**
+			 * \brief Copy construct items into uninitialized slots. Nothing is left constructed in out if a copy throws.
+			 * \param in Items to copy
+			 * \param count Number of items
+			 * \param out First uninitialized slot
+			 */
+			static void copy(const T * in, int count, T * out)
+			{
+				copy(in, count, out, IsTrivial());
+			}
+
+			/**
+			 * \brief Move construct items into uninitialized slots, copying instead where a move could throw.
+			 * The moved from items are left constructed. Nothing is left constructed in out if a copy throws.
+			 * \param in Items to move
+			 * \param count Number of items
+			 * \param out First uninitialized slot
+			 */
+			static void relocate(T * in, int count, T * out)
+			{
+				relocate(in, count, out, IsTrivial());
+			}
+
+			/**
+			 * \brief Destroy constructed items.
+			 * \param items First item
+			 * \param count Number of items
+			 */
+			static void destroy(T * items, int count)
+			{
+				for (int i = 0; i < count; ++i)
+				{
+					items[i].~T();
+				}
+			}
+
+		private:
+			/**
+			 * \brief Bookkeeping in front of slot 0.
+			 */
+			struct Header
+			{
+				/**
+				 * \brief Number of constructed items from slot 0.
+				 */
+				int count;
+
+				/**
+				 * \brief Size of the mapping holding header and slots, 0 if allocated with operator new.
+				 */
+				size_t mappedBytes;
+			};
+
+			/**
+			 * \brief Bytes in front of slot 0, room for the header keeping slot 0 aligned.
+			 */
+			static const size_t HeaderSize = sizeof(typename std::aligned_storage<sizeof(Header),
+				(std::alignment_of<T>::value > std::alignment_of<Header>::value ? std::alignment_of<T>::value : std::alignment_of<Header>::value)>::type);
+
+			/**
+			 * \brief Deleter destroying the constructed items, then freeing the block.
+			 * Holds the current address of slot 0, which tryResize may change after the shared_ptr was created.
+			 */
+			struct Release
+			{
+				explicit Release(T * items) : items(items){}
+
+				void operator()(T *) const
+				{
+					destroy(items, getCount(items));
+					char * block = reinterpret_cast<char *>(items) - HeaderSize;
+#if defined(MYLIST_HAS_MREMAP)
+					const size_t mappedBytes = getHeader(items).mappedBytes;
+					if (mappedBytes != 0)
+					{
+						munmap(block, mappedBytes);
+						return;
+					}
+#endif
+					::operator delete(block);
+				}
+
+				T * items;
+			};
+
+			static Header & getHeader(T * items)
+			{
+				return *reinterpret_cast<Header *>(reinterpret_cast<char *>(items) - HeaderSize);
+			}
+
+#if defined(MYLIST_HAS_MREMAP)
+			static size_t roundToPages(size_t bytes)
+			{
+				const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+				return (bytes + page - 1) / page * page;
+			}
+#endif
+
+			static void copy(const T * in, int count, T * out, std::true_type)
+			{
+				if (count > 0) memcpy(out, in, count * sizeof(T));
+			}
+
+			static void copy(const T * in, int count, T * out, std::false_type)
+			{
+				int i = 0;
+				try
+				{
+					for (; i < count; ++i)
+					{
+						::new (static_cast<void *>(out + i)) T(in[i]);
+					}
+				}
+				catch (...)
+				{
+					destroy(out, i);
+					throw;
+				}
+			}
+
+			static void relocate(T * in, int count, T * out, std::true_type)
+			{
+				if (count > 0) memcpy(out, in, count * sizeof(T));
+			}
+
+			static void relocate(T * in, int count, T * out, std::false_type)
+			{
+				int i = 0;
+				try
+				{
+					for (; i < count; ++i)
+					{
+						::new (static_cast<void *>(out + i)) T(std::move_if_noexcept(in[i]));
+					}
+				}
+				catch (...)
+				{
+					// Only reachable through copies, so the source is still intact.
+					destroy(out, i);
+					throw;
+				}
+			}
+		};
+	}
+}
@@ -0,0 +1,154 @@
+/**
+ *  Summary: Background thread that destroys objects handed to it, so freeing large structures does not stall the releasing thread.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Global.h"
+#include "ThreadLocal.h"
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Background thread that destroys objects handed to it.
+		 * Objects are destroyed in the order they were handed over. Disabled until setInlineLimit is given a positive limit, the thread starts on first use.
+		 */
+		class Reclaimer
+		{
+		public:
+			Reclaimer() : mInlineLimit(0), mBusy(false), mStopping(false){}
+
+			/**
+			 * \brief Destroy everything still queued, then stop the thread.
+			 */
+			~Reclaimer()
+			{
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					mStopping = true;
+				}
+				mWake.notify_all();
+				if (mThread.joinable()) mThread.join();
+			}
+
+			/**
+			 * \brief Set how many nodes of a chain the releasing thread frees itself before handing the rest over.
+			 * \param nodes Node count, 0 (the default) frees every chain on the releasing thread.
+			 */
+			void setInlineLimit(int nodes)
+			{
+				mInlineLimit = nodes;
+			}
+
+			/**
+			 * \brief Get how many nodes of a chain the releasing thread frees itself.
+			 * \return Node count, 0 if disabled.
+			 */
+			int getInlineLimit() const
+			{
+				return mInlineLimit;
+			}
+
+			/**
+			 * \brief Take over the last reference to an object, unless disabled or called from the reclaimer thread itself.
+			 * \param object Reference to take, emptied if accepted.
+			 * \return True if accepted, False if the caller must release it.
+			 */
+			template<class T>
+			bool tryDefer(std::shared_ptr<T> & object)
+			{
+				if (mInlineLimit <= 0 || isReclaimerThread()) return false;
+
+				std::unique_lock<std::mutex> lock(mMutex);
+				if (mStopping) return false;
+				if (!mThread.joinable())
+				{
+					mThread = std::thread([this](){ run(); });
+				}
+				mQueue.push_back(std::shared_ptr<void>(std::move(object)));
+				lock.unlock();
+				mWake.notify_one();
+				return true;
+			}
+
+			/**
+			 * \brief Wait until everything deferred so far has been destroyed.
+			 */
+			void drain()
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mIdle.wait(lock, [this](){ return mQueue.empty() && !mBusy; });
+			}
+
+			/**
+			 * \brief Get reclaimer used by the lists.
+			 * \return Reference to default reclaimer
+			 */
+			static Reclaimer & getDefault()
+			{
+				// Never destroyed, lists may still be released by other static destructors at exit.
+				return Global<Reclaimer>::get([](){ return new Reclaimer(); });
+			}
+
+		private:
+			Reclaimer(const Reclaimer & other);
+			Reclaimer & operator=(const Reclaimer & other);
+
+			static bool & isReclaimerThread()
+			{
+				static MYLIST_THREAD_LOCAL bool reclaimerThread = false;
+				return reclaimerThread;
+			}
+
+			void run()
+			{
+				isReclaimerThread() = true;
+				std::unique_lock<std::mutex> lock(mMutex);
+				while (true)
+				{
+					mWake.wait(lock, [this](){ return mStopping || !mQueue.empty(); });
+					if (mQueue.empty()) return;
+
+					// Destroy outside the lock so releasing threads never wait on a teardown.
+					std::vector<std::shared_ptr<void> > work;
+					work.swap(mQueue);
+					mBusy = true;
+					lock.unlock();
+					work.clear();
+					lock.lock();
+					mBusy = false;
+					if (mQueue.empty()) mIdle.notify_all();
+				}
+			}
+
+			std::atomic<int> mInlineLimit;
+
+			std::mutex mMutex;
+
+			std::condition_variable mWake;
+
+			std::condition_variable mIdle;
+
+			std::vector<std::shared_ptr<void> > mQueue;
+
+			/**
+			 * \brief Set while a swapped out batch is being destroyed.
+			 */
+			bool mBusy;
+
+			bool mStopping;
+
+			std::thread mThread;
+		};
+	}
+}
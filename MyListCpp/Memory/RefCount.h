@@ -0,0 +1,231 @@
+/**
+ *  Summary: Reference counting policies for list nodes. SharedCount uses atomic std::shared_ptr counts and is safe to share
+ *  between threads, LocalCount keeps a plain counter inside the node for lists confined to one thread.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "PoolAllocator.h"
+#include "Reclaimer.h"
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Smart pointer to a node holding its own non-atomic reference count.
+		 * Nodes are created with LocalCount::make and returned to the PoolAllocator when the last pointer goes.
+		 * \tparam TNode Node type, derived from LocalCount::NodeBase.
+		 */
+		template<class TNode>
+		class IntrusivePtr
+		{
+		public:
+			IntrusivePtr() : mNode(nullptr){}
+
+			IntrusivePtr(std::nullptr_t) : mNode(nullptr){}
+
+			/**
+			 * \brief Take a reference to node.
+			 * \param node Node, may be nullptr.
+			 */
+			explicit IntrusivePtr(TNode * node) : mNode(node)
+			{
+				if (mNode) ++mNode->mRefCount;
+			}
+
+			IntrusivePtr(const IntrusivePtr & other) : mNode(other.mNode)
+			{
+				if (mNode) ++mNode->mRefCount;
+			}
+
+			IntrusivePtr(IntrusivePtr && other) : mNode(other.mNode)
+			{
+				other.mNode = nullptr;
+			}
+
+			~IntrusivePtr()
+			{
+				release();
+			}
+
+			IntrusivePtr & operator=(const IntrusivePtr & other)
+			{
+				IntrusivePtr(other).swap(*this);
+				return *this;
+			}
+
+			IntrusivePtr & operator=(IntrusivePtr && other)
+			{
+				// The old node is released only after this points to the new one, as with std::shared_ptr.
+				IntrusivePtr(std::move(other)).swap(*this);
+				return *this;
+			}
+
+			void swap(IntrusivePtr & other)
+			{
+				std::swap(mNode, other.mNode);
+			}
+
+			void reset()
+			{
+				IntrusivePtr().swap(*this);
+			}
+
+			TNode * get() const { return mNode; }
+
+			TNode * operator->() const { return mNode; }
+
+			TNode & operator*() const { return *mNode; }
+
+			explicit operator bool() const { return mNode != nullptr; }
+
+			/**
+			 * \brief Get number of pointers to the node.
+			 * \return Count, 0 if empty.
+			 */
+			long use_count() const
+			{
+				return mNode ? mNode->mRefCount : 0;
+			}
+
+		private:
+			void release()
+			{
+				if (mNode && --mNode->mRefCount == 0)
+				{
+					PoolAllocator<TNode> allocator;
+					mNode->~TNode();
+					allocator.deallocate(mNode, 1);
+				}
+				mNode = nullptr;
+			}
+
+			TNode * mNode;
+		};
+
+		/**
+		 * \brief Atomic reference counts through std::shared_ptr, node and count share one pool block.
+		 * Lists can be read and released from any thread, long chains can be released on the Reclaimer thread.
+		 */
+		struct SharedCount
+		{
+			enum { IsThreadSafe = 1 };
+
+			/**
+			 * \brief Base of every node, the count lives in the shared_ptr block.
+			 */
+			struct NodeBase
+			{
+			};
+
+			/**
+			 * \brief Pointer type owning a node.
+			 */
+			template<class TNode>
+			struct Pointer
+			{
+				typedef std::shared_ptr<TNode> type;
+			};
+
+			/**
+			 * \brief Create node from the pool.
+			 * \return Pointer owning the node
+			 */
+			template<class TNode, class... TArgs>
+			static std::shared_ptr<TNode> make(TArgs &&... args)
+			{
+				return std::allocate_shared<TNode>(PoolAllocator<TNode>(), std::forward<TArgs>(args)...);
+			}
+
+			/**
+			 * \brief Get how many nodes of a chain the releasing thread frees itself.
+			 * \return Reclaimer's inline limit
+			 */
+			static int getInlineLimit()
+			{
+				return Reclaimer::getDefault().getInlineLimit();
+			}
+
+			/**
+			 * \brief Hand the rest of a chain to the Reclaimer.
+			 * \return True if accepted
+			 */
+			template<class TNode>
+			static bool tryDefer(std::shared_ptr<TNode> & node)
+			{
+				return Reclaimer::getDefault().tryDefer(node);
+			}
+		};
+
+		/**
+		 * \brief Plain reference count inside every node, no atomic operations.
+		 * A list and every list sharing its nodes must only be used by one thread; they cannot be used with parallel().
+		 */
+		struct LocalCount
+		{
+			enum { IsThreadSafe = 0 };
+
+			/**
+			 * \brief Base of every node, holds the count.
+			 */
+			class NodeBase
+			{
+			public:
+				NodeBase() : mRefCount(0){}
+
+				long mRefCount;
+			};
+
+			/**
+			 * \brief Pointer type owning a node.
+			 */
+			template<class TNode>
+			struct Pointer
+			{
+				typedef IntrusivePtr<TNode> type;
+			};
+
+			/**
+			 * \brief Create node from the pool.
+			 * \return Pointer owning the node
+			 */
+			template<class TNode, class... TArgs>
+			static IntrusivePtr<TNode> make(TArgs &&... args)
+			{
+				PoolAllocator<TNode> allocator;
+				TNode * node = allocator.allocate(1);
+				try
+				{
+					::new (static_cast<void *>(node)) TNode(std::forward<TArgs>(args)...);
+				}
+				catch (...)
+				{
+					allocator.deallocate(node, 1);
+					throw;
+				}
+				return IntrusivePtr<TNode>(node);
+			}
+
+			/**
+			 * \brief Every chain is freed on the releasing thread, the counts are not safe to touch from another.
+			 * \return 0
+			 */
+			static int getInlineLimit()
+			{
+				return 0;
+			}
+
+			template<class TPointer>
+			static bool tryDefer(TPointer &)
+			{
+				return false;
+			}
+		};
+	}
+}
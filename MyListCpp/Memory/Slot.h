@@ -0,0 +1,95 @@
+/**
+ *  Summary: Storage for at most one item, constructed on demand. Lets enumerators that compute their items
+ *  hand out references to the current one.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Storage for at most one item, constructed on demand. Needs no default constructor for T.
+		 * \tparam T Type of item
+		 */
+		template<class T>
+		class Slot
+		{
+		public:
+			Slot() : mFull(false){}
+
+			/**
+			 * \brief Copy constructor, copies the item if there is one.
+			 * \param other Slot
+			 */
+			Slot(const Slot & other) : mFull(false)
+			{
+				if (other.mFull) set(other.get());
+			}
+
+			~Slot()
+			{
+				reset();
+			}
+
+			/**
+			 * \brief Construct the item from value, destroying any previous one.
+			 * \param value Value, moved in if an rvalue.
+			 * \return Reference to the item
+			 */
+			template<class TValue>
+			T & set(TValue && value)
+			{
+				reset();
+				::new (static_cast<void *>(&mStorage)) T(std::forward<TValue>(value));
+				mFull = true;
+				return get();
+			}
+
+			/**
+			 * \brief Destroy the item if there is one.
+			 */
+			void reset()
+			{
+				if (!mFull) return;
+				get().~T();
+				mFull = false;
+			}
+
+			/**
+			 * \brief Check whether there is an item.
+			 * \return True if set and not reset since.
+			 */
+			bool isSet() const
+			{
+				return mFull;
+			}
+
+			/**
+			 * \brief Get the item, only valid while isSet().
+			 * \return Reference to the item
+			 */
+			T & get()
+			{
+				return *reinterpret_cast<T *>(&mStorage);
+			}
+
+			const T & get() const
+			{
+				return *reinterpret_cast<const T *>(&mStorage);
+			}
+
+		private:
+			Slot & operator=(const Slot & other);
+
+			typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type mStorage;
+
+			bool mFull;
+		};
+	}
+}
@@ -0,0 +1,81 @@
+/**
+ *  Summary: Thread local storage for plain data, and a hook run when a thread exits, portable back to VS2013 which has no thread_local.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#if defined(_MSC_VER)
+#define MYLIST_THREAD_LOCAL __declspec(thread)
+#else
+#define MYLIST_THREAD_LOCAL __thread
+#endif
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define MYLIST_THREAD_EXIT_CALLBACK NTAPI
+#else
+#include <pthread.h>
+#define MYLIST_THREAD_EXIT_CALLBACK
+#endif
+
+namespace MyList
+{
+	namespace Memory
+	{
+		/**
+		 * \brief Calls a function when a thread that armed the hook exits, with the value it armed it with.
+		 * Plain thread local data has no destructor, so this is how such data is cleaned up: fiber local storage on Windows,
+		 * a pthread key elsewhere. If the system runs out of keys the hook does nothing.
+		 */
+		class ThreadExitHook
+		{
+		public:
+			typedef void (MYLIST_THREAD_EXIT_CALLBACK * Callback)(void *);
+
+			/**
+			 * \brief Create hook.
+			 * \param callback Function called on thread exit, declared with MYLIST_THREAD_EXIT_CALLBACK.
+			 */
+			explicit ThreadExitHook(Callback callback)
+			{
+#if defined(_WIN32)
+				mKey = FlsAlloc(callback);
+#else
+				mValid = pthread_key_create(&mKey, callback) == 0;
+#endif
+			}
+
+			/**
+			 * \brief Have the callback called with value when the calling thread exits.
+			 * \param value Non null value, replaces any value armed before on this thread.
+			 */
+			void arm(void * value)
+			{
+#if defined(_WIN32)
+				if (mKey != FLS_OUT_OF_INDEXES) FlsSetValue(mKey, value);
+#else
+				if (mValid) pthread_setspecific(mKey, value);
+#endif
+			}
+
+		private:
+			ThreadExitHook(const ThreadExitHook & other);
+			ThreadExitHook & operator=(const ThreadExitHook & other);
+
+#if defined(_WIN32)
+			DWORD mKey;
+#else
+			pthread_key_t mKey;
+
+			bool mValid;
+#endif
+		};
+	}
+}
@@ -1,13 +1,31 @@
 /**
  *  Summary: Class that represents an mutable list of items. Allows O(1) random access and assignment.
- *  Warning: Not safe to write to list while reading.
+ *  Enumerators and pipelines read a snapshot, the list copies its buffer before overwriting items a snapshot still holds.
+ *  Lists of trivially copyable items can be saved to a file and mapped back read-only, see save and mapFile.
+ *  Warning: The list itself, including taking snapshots, must only be used by one thread at a time.
  *  Author: Brian Cullen (brianshan@gmail.com)
  */
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "MutableListFwd.h"
 #include "IEnumerable.h"
+#include "Pipeline.h"
 #include "Enumerator/IEnumerator.h"
+#include "Memory/Growth.h"
+#include "Memory/InlineBuffer.h"
+#include "Memory/ListFile.h"
+#include "Memory/RawBuffer.h"
+#include "Parallel/Chunks.h"
+#include "Parallel/ThreadPool.h"
+#include "Simd/Kernels.h"
+#include "Stage/ArrayStage.h"
 #include "Exception/MyExceptions.h"
 
 #define DEFAULT_CAPACITY 16
@@ -22,19 +40,50 @@ namespace MyList{
 	template<class T>
 	class IEnumerable;
 
+	template<class TStage>
+	class Pipeline;
+
+	template<class TStage>
+	class ParallelPipeline;
+
 	/**
 	* \brief Class that represents an mutable list of items. Allows random access and assignment.
 	* \tparam T Type of item to be stored in list.
+	* \tparam TGrowth Growth policy for the buffer: Memory::DoublingGrowth (default), FactorGrowth, IncrementGrowth, PageGrowth,
+	* or RemapGrowth to map large buffers of trivially copyable items and grow them in place.
+	* \tparam InlineCount Number of items stored inside the list itself. Shorter lists never allocate, longer ones spill to the heap.
+	* Enumerators and lazy pipelines over inline items get their own heap copy, as they may outlive the list.
 	*/
-	template<class T>
+	template<class T, class TGrowth, int InlineCount>
 	class MutableList : public IEnumerable < T >
 	{
+	private:
+		typedef Stage::ArrayStage<T> BufferStage;
+
+		typedef Memory::RawBuffer<T> Buffer;
+
+		/**
+		 * \brief Capacity of a new list when nothing is known about its length.
+		 */
+		enum { InitialCapacity = InlineCount > 0 ? InlineCount : DEFAULT_CAPACITY };
+
+		/**
+		 * \brief True if large buffers are mapped and grown with Buffer::tryResize.
+		 */
+		typedef std::integral_constant<bool, TGrowth::InPlace && Buffer::IsTrivial::value> IsRemapped;
+
+		template<class TStage>
+		friend class Pipeline;
+
+		template<class TStage>
+		friend class ParallelPipeline;
+
 	public:
 
 		/**
-		 * \brief Create list with default capacity
+		 * \brief Create list with default capacity, or in the inline slots if there are any.
 		 */
-		MutableList() : MutableList(DEFAULT_CAPACITY) {}
+		MutableList() : MutableList(InitialCapacity) {}
 
 		/**
 		 * \brief Create list with given capacity.
@@ -56,7 +105,7 @@ namespace MyList{
 		MutableList(const MutableList & other);
 
 		/**
-		 * \brief Move constructor
+		 * \brief Move constructor, takes the buffer and leaves other empty.
 		 * \param other MutableList 
 		 */
 		MutableList(MutableList && other);
@@ -67,18 +116,112 @@ namespace MyList{
 		 */
 		MutableList(const IEnumerable<T> * input);
 
+		/**
+		 * \brief Copy assignment, deep copy array items.
+		 * \param other MutableList
+		 * \return This list
+		 */
+		MutableList & operator=(const MutableList & other);
+
+		/**
+		 * \brief Move assignment, takes the buffer and leaves other empty.
+		 * \param other MutableList
+		 * \return This list
+		 */
+		MutableList & operator=(MutableList && other);
+
 		/**
 		* \brief Append item to list
 		* \param value
 		*/
-		void append(const T & value);
+		void append(const T & value)
+		{
+			emplaceBack(value);
+		}
+
+		/**
+		 * \brief Append item to list, moving it in.
+		 * \param value
+		 */
+		void append(T && value)
+		{
+			emplaceBack(std::move(value));
+		}
+
+		/**
+		 * \brief Construct item at the end of the list from arguments.
+		 * \tparam TArgs Types of constructor arguments
+		 * \param args Constructor arguments, may refer to items of this list.
+		 */
+		template<class... TArgs>
+		void emplaceBack(TArgs &&... args);
+
+		/**
+		 * \brief Append copies of an array of items, growing at most once.
+		 * \param input Array, may be part of this list.
+		 * \param length Length of input array
+		 */
+		void appendRange(const T * input, int length);
+
+		/**
+		 * \brief Append every item of another IEnumerable. A MutableList of the same type is copied in one block,
+		 * anything else is enumerated in batches.
+		 * \param input Source, may be this list.
+		 */
+		void appendAll(const IEnumerable<T> & input);
+
+		/**
+		 * \brief Write the items to a file, see Memory::ListFile. Only for trivially copyable items.
+		 * \param path File name, replaced if it exists.
+		 */
+		void save(const char * path) const
+		{
+			Memory::ListFile<T>::write(path, data(), mLength);
+		}
+
+		/**
+		 * \brief Create list reading the items of a file written by save, mapped read-only instead of loaded.
+		 * Reading, enumerating and pipelines use the mapping without copying it. The first change copies the items
+		 * to a buffer of the list's own, snapshots taken before keep reading the mapping. The file must not change while mapped.
+		 * \param path File name
+		 * \param verify Check the items against the checksum in the file, which reads the whole file.
+		 * \return New MutableList. Throws Exception::FileException if the file cannot be mapped and
+		 * Exception::InvalidFileFormat if it does not hold items of this type.
+		 */
+		static MutableList mapFile(const char * path, bool verify = false);
+
+		/**
+		 * \brief Check whether the list still reads a mapped file, see mapFile.
+		 * \return True until the first change
+		 */
+		bool isFileMapped() const
+		{
+			return mFileMapped;
+		}
+
+		/**
+		 * \brief Make sure the list holds capacity items without growing. Never shrinks.
+		 * \param capacity Number of items
+		 */
+		void reserve(int capacity)
+		{
+			if (capacity > mCapacity) setCapacity(capacity);
+		}
+
+		/**
+		 * \brief Drop unused capacity, moving items to a buffer of exactly their length (or into the inline slots).
+		 */
+		void shrinkToFit()
+		{
+			if (mCapacity > mLength) setCapacity(mLength);
+		}
 
 		/**
 		 * \brief Get item at index.
 		 * \param i index
-		 * \return Item
+		 * \return Reference to the item, valid until the list changes.
 		 */
-		T at(unsigned int i) const;
+		const T & at(unsigned int i) const;
 
 		/**
 		 * \brief Get the length of the list
@@ -103,6 +246,8 @@ namespace MyList{
 
 		/**
 		 * \brief Random access to item in list, read or assign.
+		 * Gives the list a buffer of its own first if a snapshot still reads the current one.
+		 * The reference is only good until the next snapshot is taken.
 		 * \param i index
 		 * \return Reference to item.
 		 */
@@ -115,27 +260,330 @@ namespace MyList{
 		MutableList reverse();
 
 		/**
-		 * \brief Sets new capacity for the list.
+		 * \brief Sets new capacity for the list. Items are moved to the new buffer, or copied while an enumerator still reads the old one.
 		 * \param newCapacity must be greater than length of list.
 		 */
 		void setCapacity(int newCapacity);
 
 		/**
-		 * \brief Get enumerator for the list.
+		 * \brief Get enumerator over a snapshot of the list. Later writes to the list are never seen, so the enumerator
+		 * can be handed to another thread and read without locks while the list keeps changing.
 		 * \return std::shared_ptr<IEnumerator<T>
 		 */
 		std::shared_ptr<IEnumerator<T>> getEnumerator() const override{
-			return std::shared_ptr<IEnumerator<T>>(new MutableListEnumerator(this));
+			return std::shared_ptr<IEnumerator<T>>(new MutableListEnumerator(share(), mLength));
+		}
+
+		/**
+		 * \brief Map this list to another, evaluated as a fused pipeline.
+		 * \tparam TDest Type of item destination list
+		 * \tparam TFunc Type of map callable, any function, lambda or functor taking T.
+		 * \param func Map callable
+		 * \return Pipeline of mapped values.
+		 */
+		template<typename TDest, typename TFunc>
+		Pipeline<Stage::MapStage<BufferStage, TDest, TFunc> > map(TFunc func) const
+		{
+			return pipeline().template map<TDest>(func);
+		}
+
+		/**
+		 * \brief Filter list, evaluated as a fused pipeline.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate used to filter items
+		 * \return Pipeline of filtered values.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::FilterStage<BufferStage, TPredicate> > filter(TPredicate predicate) const
+		{
+			return pipeline().filter(predicate);
+		}
+
+		/**
+		 * \brief Take the first count items, evaluated as a fused pipeline.
+		 * \param count Maximum number of items
+		 * \return Pipeline of at most count items.
+		 */
+		Pipeline<Stage::TakeStage<BufferStage> > take(int count) const
+		{
+			return pipeline().take(count);
+		}
+
+		/**
+		 * \brief Take leading items while they satisfy a predicate, evaluated as a fused pipeline.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate items must satisfy
+		 * \return Pipeline of the leading items satisfying predicate.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::TakeWhileStage<BufferStage, TPredicate> > takeWhile(TPredicate predicate) const
+		{
+			return pipeline().takeWhile(predicate);
+		}
+
+		/**
+		 * \brief Drop the first count items, evaluated as a fused pipeline.
+		 * \param count Number of items to drop
+		 * \return Pipeline of the items after the first count.
+		 */
+		Pipeline<Stage::SkipStage<BufferStage> > skip(int count) const
+		{
+			return pipeline().skip(count);
+		}
+
+		/**
+		 * \brief Aggregate values in the list without going through an enumerator.
+		 * \tparam TDest Aggregate value type
+		 * \tparam TFunc Type of aggregate callable taking (TDest, T).
+		 * \param initial Initial value
+		 * \param func Aggregate callable
+		 * \return Aggregate value
+		 */
+		template<typename TDest, typename TFunc>
+		TDest foldLeft(TDest initial, TFunc func) const
+		{
+			// Runs to completion while the list is alive, no need to share inline items.
+			return Pipeline<BufferStage>(BufferStage(view(), mLength)).foldLeft(std::move(initial), func);
+		}
+
+		/**
+		 * \brief Aggregate values in the list on a thread pool. Every chunk of the list is folded from identity,
+		 * then the chunk results are combined in list order. Chunks only depend on length and thread count,
+		 * so floating point results are reproducible for a fixed pool size.
+		 * \tparam TDest Aggregate value type
+		 * \tparam TFunc Type of aggregate callable taking (TDest, T), copied per chunk.
+		 * \tparam TCombine Type of callable merging two aggregates (TDest, TDest), must be associative.
+		 * \param identity Initial value of every chunk, must not change a value it is combined with.
+		 * \param func Aggregate callable
+		 * \param combine Combine callable
+		 * \param pool Thread pool to run on
+		 * \return Aggregate value, identity if list is empty.
+		 */
+		template<typename TDest, typename TFunc, typename TCombine>
+		TDest parallelFold(TDest identity, TFunc func, TCombine combine, Parallel::ThreadPool & pool = Parallel::ThreadPool::getDefault()) const;
+
+		/**
+		 * \brief Reduce values in the list on a thread pool with an associative operation, see parallelFold.
+		 * \tparam TFunc Type of operation taking (T, T).
+		 * \param identity Identity of the operation, e.g. 0 for addition.
+		 * \param func Associative operation
+		 * \param pool Thread pool to run on
+		 * \return Reduced value, identity if list is empty.
+		 */
+		template<typename TFunc>
+		T reduce(T identity, TFunc func, Parallel::ThreadPool & pool = Parallel::ThreadPool::getDefault()) const
+		{
+			return parallelFold(identity, func, func, pool);
+		}
+
+		/**
+		 * \brief Run map and filter stages across a thread pool, see ParallelPipeline.
+		 * \param pool Thread pool to run on
+		 * \return ParallelPipeline with this list as its source.
+		 */
+		ParallelPipeline<BufferStage> parallel(Parallel::ThreadPool & pool = Parallel::ThreadPool::getDefault()) const
+		{
+			return pipeline().parallel(pool);
 		}
 
 		/**
 		 * \brief Destructor
 		 */
 		~MutableList() override{
+			release();
 		}
 
 	private:
 
+		/**
+		 * \brief Get pipeline with this list as its source.
+		 * \return Pipeline<BufferStage>
+		 */
+		Pipeline<BufferStage> pipeline() const
+		{
+			return Pipeline<BufferStage>(BufferStage(share(), mLength));
+		}
+
+		/**
+		 * \brief Get first slot, inline or on the heap.
+		 * \return Pointer to slot 0
+		 */
+		T * data() const
+		{
+			return mBuffer ? mBuffer.get() : const_cast<T *>(mInline.items());
+		}
+
+		/**
+		 * \brief Get first inline slot.
+		 * \return Pointer to inline slot 0
+		 */
+		T * inlineItems()
+		{
+			return mInline.items();
+		}
+
+		/**
+		 * \brief Get buffer that may outlive the list. Inline items are copied to a new heap buffer.
+		 * \return Shared buffer holding mLength items
+		 */
+		std::shared_ptr<T> share() const
+		{
+			if (mBuffer || mLength == 0) return mBuffer;
+			std::shared_ptr<T> buffer = Buffer::allocate(mLength);
+			Buffer::copy(data(), mLength, buffer.get());
+			Buffer::getCount(buffer.get()) = mLength;
+			return buffer;
+		}
+
+		/**
+		 * \brief Get buffer only valid while the list is alive and unchanged, inline items are not copied.
+		 * \return Shared buffer, or pointer to inline slots owning nothing.
+		 */
+		std::shared_ptr<T> view() const
+		{
+			if (mBuffer) return mBuffer;
+			return std::shared_ptr<T>(std::shared_ptr<T>(), data());
+		}
+
+		/**
+		 * \brief Check whether the heap buffer must be copied rather than changed.
+		 * \return True if an enumerator or pipeline holds the buffer, or it is a read-only file mapping
+		 */
+		bool isShared() const
+		{
+			if (mFileMapped || mBuffer.use_count() > 1) return true;
+
+			// Snapshots released on other threads drop their count with release order, pair with it before overwriting.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return false;
+		}
+
+		/**
+		 * \brief Copy the buffer if a snapshot still reads it, so items can be overwritten.
+		 */
+		void detach()
+		{
+			if (mBuffer && isShared()) setCapacity(mCapacity);
+		}
+
+		/**
+		 * \brief Create list over a file mapping, see mapFile.
+		 * \param mapping Pointer to item 0, owning the mapping.
+		 * \param length Number of items, at least one.
+		 */
+		MutableList(const std::shared_ptr<T> & mapping, int length) : mCapacity(length), mBuffer(mapping), mFileMapped(true), mLength(length){}
+
+		/**
+		 * \brief Take the items of other, which is left empty.
+		 * \param other Empty list
+		 */
+		void takeFrom(MutableList & other);
+
+		/**
+		 * \brief Destroy items and drop the heap buffer, leaving an empty list.
+		 */
+		void release();
+
+		/**
+		 * \brief Build new list from every remaining item of a stage.
+		 * \param stage Stage to drain
+		 * \return New MutableList
+		 */
+		template<class TStage>
+		static MutableList fromStage(TStage stage)
+		{
+			return collect(stage);
+		}
+
+		/**
+		 * \brief Get capacity to allocate for a source. A bound may be far above what a filter lets through,
+		 * so it only caps the initial capacity and the list grows from there.
+		 * \param hint SizeHint of the source
+		 * \return Count if known, otherwise the initial capacity, no more than the bound if any.
+		 */
+		static int getCapacity(const SizeHint & hint)
+		{
+			switch (hint.getKind())
+			{
+			case SizeHint::Exact:
+				return hint.getCount();
+			case SizeHint::UpperBound:
+				return std::min(hint.getCount(), static_cast<int>(InitialCapacity));
+			default:
+				return InitialCapacity;
+			}
+		}
+
+		/**
+		 * \brief Append every remaining item of a stage to a new list, allocated once if the stage knows its length.
+		 * \param stage Stage to drain
+		 * \return New MutableList
+		 */
+		template<class TStage>
+		static MutableList collect(TStage & stage);
+
+		/**
+		 * \brief Build new list holding the items of every part in turn.
+		 * \param parts Lists to concatenate
+		 * \return New MutableList
+		 */
+		static MutableList concatParts(const std::vector<const MutableList *> & parts);
+
+		/**
+		 * \brief Build new list from a filter directly over a buffer, with a block kernel.
+		 * \param stage Stage to drain
+		 * \return New MutableList
+		 */
+		template<class TPredicate>
+		static MutableList fromStage(Stage::FilterStage<BufferStage, TPredicate> stage)
+		{
+			return fromBlock(stage, typename Buffer::IsTrivial());
+		}
+
+		/**
+		 * \brief Build new list from a same type map directly over a buffer, with a block kernel.
+		 * \param stage Stage to drain
+		 * \return New MutableList
+		 */
+		template<class TFunc>
+		static MutableList fromStage(Stage::MapStage<BufferStage, T, TFunc> stage)
+		{
+			return fromBlock(stage, typename Buffer::IsTrivial());
+		}
+
+		/**
+		 * \brief Filter kernel writing by assignment straight into the uninitialized slots of the new buffer.
+		 */
+		template<class TPredicate>
+		static MutableList fromBlock(Stage::FilterStage<BufferStage, TPredicate> & stage, std::true_type);
+
+		/**
+		 * \brief Map kernel writing by assignment straight into the uninitialized slots of the new buffer.
+		 */
+		template<class TFunc>
+		static MutableList fromBlock(Stage::MapStage<BufferStage, T, TFunc> & stage, std::true_type);
+
+		/**
+		 * \brief Items that are not trivially copyable must be constructed, so append them one at a time.
+		 */
+		template<class TStage>
+		static MutableList fromBlock(TStage & stage, std::false_type)
+		{
+			return collect(stage);
+		}
+
+		/**
+		 * \brief Enumerate straight into the free slots, the enumerator assigns items of trivially copyable type.
+		 * \param enumerator Source
+		 */
+		void appendFrom(IEnumerator<T> & enumerator, std::true_type);
+
+		/**
+		 * \brief Copy construct items straight into the free slots one at a time, so T needs no default constructor.
+		 * \param enumerator Source
+		 */
+		void appendFrom(IEnumerator<T> & enumerator, std::false_type);
+
 		/**
 		 * \brief Allocates capacity in the internal buffer
 		 * \param capacity 
@@ -143,9 +591,45 @@ namespace MyList{
 		void allocateCapacity(int capacity);
 
 		/**
-		 * \brief Ensure capacity is great enough to insert new item. Doubles capacity if not.
+		 * \brief Ensure capacity is great enough for required items. Grows as the policy says if not.
+		 * \param required Number of items the buffer must hold
 		 */
-		void ensureCapacity();
+		void ensureCapacity(int required);
+
+		/**
+		 * \brief Check whether a new buffer should be mapped so it can be resized in place later.
+		 * \param capacity Number of slots
+		 * \return True if the policy remaps and the buffer is large
+		 */
+		static bool isMapped(int capacity)
+		{
+			return IsRemapped::value && static_cast<size_t>(capacity) * sizeof(T) >= HUGE_PAGE_BYTES;
+		}
+
+		/**
+		 * \brief Resize the mapped buffer in place.
+		 * \param newCapacity New number of slots
+		 * \return True if resized
+		 */
+		bool tryResize(int newCapacity, std::true_type)
+		{
+			return Buffer::tryResize(mBuffer, newCapacity);
+		}
+
+		bool tryResize(int, std::false_type)
+		{
+			return false;
+		}
+
+		/**
+		 * \brief Set length after constructing or destroying items at the end of the buffer.
+		 * \param length Number of constructed items
+		 */
+		void setLength(int length)
+		{
+			mLength = length;
+			if (mBuffer) Buffer::getCount(mBuffer.get()) = length;
+		}
 
 		/**
 		 * \brief Reverse contents in place.
@@ -158,10 +642,22 @@ namespace MyList{
 		int mCapacity;
 
 		/**
-		 * \brief Shared pointer to buffer. Allows transfer of ownership to enumerators.
+		 * \brief Shared pointer to a Memory::RawBuffer, the first mLength slots hold items. Allows transfer of ownership to enumerators.
+		 * Null while the items are in mInline.
 		 */
 		std::shared_ptr<T> mBuffer;
 
+		/**
+		 * \brief True while mBuffer points into a read-only file mapping rather than a Memory::RawBuffer.
+		 * It has no count in front of slot 0 and is never written, the list copies it before the first change.
+		 */
+		bool mFileMapped;
+
+		/**
+		 * \brief Inline slots, hold the items while mBuffer is null.
+		 */
+		Memory::InlineBuffer<T, InlineCount> mInline;
+
 		/**
 		 * \brief Length of list.
 		 */
@@ -177,13 +673,13 @@ namespace MyList{
 			* \brief Create enumerator from list
 			* \param list that will share its buffer.
 			*/
-			MutableListEnumerator(const MutableList * list) : mIndex(-1), mBuffer(list->mBuffer), mLength(list->mLength){};
+			MutableListEnumerator(const std::shared_ptr<T> & buffer, int length) : mIndex(-1), mBuffer(buffer), mLength(length){};
 
 			/**
-			 * \brief Copy constructor shares buffer
+			 * \brief Copy constructor shares buffer and copies the position
 			 * \param other MutableListEnumerator
 			 */
-			MutableListEnumerator(const MutableListEnumerator & other) : mIndex(-1), mBuffer(other.mBuffer), mLength(other.mLength){};
+			MutableListEnumerator(const MutableListEnumerator & other) : mIndex(other.mIndex), mBuffer(other.mBuffer), mLength(other.mLength){};
 
 			/**
 			* \brief Move to enumerator to next position
@@ -201,14 +697,50 @@ namespace MyList{
 
 			/**
 			* \brief Get value at current position.
-			* \return Value if Enumerator is valid, otherwise throw exception.
+			* \return Reference into the shared buffer if Enumerator is valid, otherwise throw exception.
 			*/
-			T getCurrent() override
+			const T & getCurrent() override
 			{
 				if (mIndex < 0) throw Exception::InvalidEnumerator();
 				return mBuffer.get()[mIndex];
 			}
 
+			/**
+			* \brief Copy next block of the shared buffer.
+			* \param out Buffer for at least max items.
+			* \param max Maximum number of items.
+			* \return Number of items copied, 0 if at end of list.
+			*/
+			int nextBatch(T * out, int max) override
+			{
+				int count = mLength - (mIndex + 1);
+				if (count > max) count = max;
+				if (count <= 0) return 0;
+
+				const T * start = mBuffer.get() + mIndex + 1;
+				std::copy(start, start + count, out);
+				mIndex += count;
+				return count;
+			}
+
+			/**
+			* \brief Get number of items left.
+			* \return Exact SizeHint
+			*/
+			SizeHint getSizeHint() const override
+			{
+				return SizeHint::exact(mLength - (mIndex + 1));
+			}
+
+			/**
+			* \brief Items are read from the shared buffer.
+			* \return True
+			*/
+			bool isMaterialized() const override
+			{
+				return true;
+			}
+
 			/**
 			* \brief Clone enumerator.
 			* \return std::shared_ptr<IEnumerator<T> >
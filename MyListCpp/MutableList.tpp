@@ -3,139 +3,412 @@
 namespace MyList
 {
 
-	template<class T>
-	MutableList<T>::MutableList(int capacity) : mCapacity(capacity), mBuffer(nullptr), mLength(0)
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount>::MutableList(int capacity) : mCapacity(InlineCount), mBuffer(nullptr), mFileMapped(false), mLength(0)
 	{
-		allocateCapacity(mCapacity);
+		allocateCapacity(capacity);
 	}
 
-	template<class T>
-	MutableList<T>::MutableList(const T * input, int length) : mCapacity(length), mBuffer(nullptr), mLength(length)
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount>::MutableList(const T * input, int length) : mCapacity(InlineCount), mBuffer(nullptr), mFileMapped(false), mLength(0)
 	{
-		allocateCapacity(mCapacity);
+		allocateCapacity(length);
 
 		// Copy contents of array.
-		memcpy(mBuffer.get(), input, length * sizeof(T));
+		Buffer::copy(input, length, data());
+		setLength(length);
 	}
 
-	template<class T>
-	MutableList<T>::MutableList(const MutableList & other) : mCapacity(other.mLength), mBuffer(nullptr), mLength(other.mLength)
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount>::MutableList(const MutableList & other) : mCapacity(InlineCount), mBuffer(nullptr), mFileMapped(false), mLength(0)
 	{
-		allocateCapacity(mCapacity);
+		allocateCapacity(other.mLength);
 
 		// Copy length items from other buffer.
-		memcpy(mBuffer.get(), other.mBuffer.get(), mLength * sizeof(T));
+		Buffer::copy(other.data(), other.mLength, data());
+		setLength(other.mLength);
 	}
 
-	template<class T>
-	MutableList<T>::MutableList(MutableList && other) : mCapacity(other.mLength), mBuffer(other.mBuffer), mLength(other.mLength)
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount>::MutableList(MutableList && other) : mCapacity(InlineCount), mBuffer(nullptr), mFileMapped(false), mLength(0)
 	{
-		// Transfer ownership of buffer.
+		takeFrom(other);
 	}
 
-	template<class T>
-	MutableList<T>::MutableList(const IEnumerable<T> * input) : MutableList()
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount>::MutableList(const IEnumerable<T> * input) : mCapacity(InlineCount), mBuffer(nullptr), mFileMapped(false), mLength(0)
 	{
-		// Enumerate and append every value.
+		// Allocate once if the source knows how many items it has left.
 		auto enumerator = input->getEnumerator();
-		T value;
-		while (enumerator->tryGetNext(value))
+		allocateCapacity(getCapacity(enumerator->getSizeHint()));
+		appendFrom(*enumerator, typename Buffer::IsTrivial());
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount> MutableList<T, TGrowth, InlineCount>::mapFile(const char * path, bool verify)
+	{
+		int length;
+		std::shared_ptr<T> mapping = Memory::ListFile<T>::map(path, verify, length);
+		if (length == 0) return MutableList<T, TGrowth, InlineCount>();
+
+		// The mapping is the buffer, full to capacity, so any append or write copies it first.
+		return MutableList<T, TGrowth, InlineCount>(mapping, length);
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount> & MutableList<T, TGrowth, InlineCount>::operator=(const MutableList & other)
+	{
+		if (this != &other)
+		{
+			*this = MutableList<T, TGrowth, InlineCount>(other);
+		}
+		return *this;
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount> & MutableList<T, TGrowth, InlineCount>::operator=(MutableList && other)
+	{
+		if (this != &other)
 		{
-			append(value);
+			release();
+			takeFrom(other);
 		}
+		return *this;
 	}
 
-	template<class T>
-	void MutableList<T>::append(const T & value)
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::takeFrom(MutableList & other)
 	{
-		// Make sure buffer is large enough.
-		ensureCapacity();
-		mBuffer.get()[mLength++] = value;
+		if (other.mBuffer)
+		{
+			// Transfer ownership of buffer, other starts again from its inline slots.
+			mBuffer = std::move(other.mBuffer);
+			mFileMapped = other.mFileMapped;
+			mCapacity = other.mCapacity;
+			mLength = other.mLength;
+		}
+		else
+		{
+			// Inline items cannot change owner, move them one by one.
+			Buffer::relocate(other.data(), other.mLength, data());
+			mLength = other.mLength;
+			Buffer::destroy(other.data(), other.mLength);
+		}
+		other.mFileMapped = false;
+		other.mCapacity = InlineCount;
+		other.mLength = 0;
 	}
 
-	template<class T>
-	T MutableList<T>::pop()
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::release()
+	{
+		// A heap buffer destroys its items when its last owner lets go.
+		if (mBuffer) mBuffer.reset();
+		else Buffer::destroy(data(), mLength);
+		mFileMapped = false;
+		mCapacity = InlineCount;
+		mLength = 0;
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::appendFrom(IEnumerator<T> & enumerator, std::true_type)
+	{
+		// Enumerate straight into the free part of the buffer, growing it whenever it fills up.
+		while (true)
+		{
+			if (mLength == mCapacity)
+			{
+				// A presized buffer is full exactly when the source runs out, don't grow just to find that out.
+				// Only an exact count sizes the growth, a bound grows by the policy like an unknown length.
+				SizeHint hint = enumerator.getSizeHint();
+				if (hint.getKind() != SizeHint::Unknown && hint.getCount() == 0) return;
+				ensureCapacity(mLength + (hint.getKind() == SizeHint::Exact ? std::max(hint.getCount(), 1) : 1));
+			}
+
+			int count = enumerator.nextBatch(data() + mLength, mCapacity - mLength);
+			if (count == 0) return;
+			setLength(mLength + count);
+		}
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::appendFrom(IEnumerator<T> & enumerator, std::false_type)
+	{
+		// Construct every item once, in place, from the enumerator's current item.
+		SizeHint hint = enumerator.getSizeHint();
+		if (hint.getKind() == SizeHint::Exact) ensureCapacity(mLength + hint.getCount());
+		while (enumerator.moveNext())
+		{
+			emplaceBack(enumerator.getCurrent());
+		}
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	template<class TStage>
+	MutableList<T, TGrowth, InlineCount> MutableList<T, TGrowth, InlineCount>::collect(TStage & stage)
+	{
+		// Append every value straight from the chain, computed values are moved in.
+		typedef typename TStage::reference reference;
+		MutableList<T, TGrowth, InlineCount> list(getCapacity(stage.getSizeHint()));
+		stage.forEach([&list](reference value){
+			list.emplaceBack(std::forward<reference>(value));
+			return true;
+		});
+		return list;
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount> MutableList<T, TGrowth, InlineCount>::concatParts(const std::vector<const MutableList *> & parts)
+	{
+		int length = 0;
+		for (size_t i = 0; i < parts.size(); ++i)
+		{
+			length += parts[i]->mLength;
+		}
+
+		// Allocate once, then copy every part into place.
+		MutableList<T, TGrowth, InlineCount> list(length);
+		for (size_t i = 0; i < parts.size(); ++i)
+		{
+			Buffer::copy(parts[i]->data(), parts[i]->mLength, list.data() + list.mLength);
+			list.setLength(list.mLength + parts[i]->mLength);
+		}
+		return list;
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	template<class TPredicate>
+	MutableList<T, TGrowth, InlineCount> MutableList<T, TGrowth, InlineCount>::fromBlock(Stage::FilterStage<BufferStage, TPredicate> & stage, std::true_type)
+	{
+		// Result is never longer than the source, compact straight into the new buffer.
+		BufferStage & input = stage.getInput();
+		MutableList<T, TGrowth, InlineCount> list(input.getRemaining());
+		list.setLength(Simd::filter(input.getData(), input.getRemaining(), list.data(), stage.getPredicate()));
+		input.skip(input.getRemaining());
+
+		// A selective filter would otherwise keep the whole source's worth of buffer.
+		if (list.mLength < list.mCapacity / 2) list.shrinkToFit();
+		return list;
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	template<class TFunc>
+	MutableList<T, TGrowth, InlineCount> MutableList<T, TGrowth, InlineCount>::fromBlock(Stage::MapStage<BufferStage, T, TFunc> & stage, std::true_type)
+	{
+		// Map the whole block straight into the new buffer.
+		BufferStage & input = stage.getInput();
+		MutableList<T, TGrowth, InlineCount> list(input.getRemaining());
+		Simd::map(input.getData(), input.getRemaining(), list.data(), stage.getFunc());
+		list.setLength(input.getRemaining());
+		input.skip(input.getRemaining());
+		return list;
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	template<typename TDest, typename TFunc, typename TCombine>
+	TDest MutableList<T, TGrowth, InlineCount>::parallelFold(TDest identity, TFunc func, TCombine combine, Parallel::ThreadPool & pool) const
+	{
+		const int length = mLength;
+		const int chunkCount = Parallel::getChunkCount(length, pool.getThreadCount());
+		if (chunkCount == 0) return identity;
+
+		// Fold every chunk into its own slot, block kernels still apply per chunk.
+		std::vector<Parallel::Partial<TDest> > partials(chunkCount, Parallel::Partial<TDest>{ identity });
+		const std::shared_ptr<T> buffer = view();
+		pool.run(chunkCount, [&](int chunk){
+			BufferStage stage(buffer, Parallel::getChunkBegin(chunk, chunkCount, length), Parallel::getChunkBegin(chunk + 1, chunkCount, length));
+			TFunc chunkFunc(func);
+			partials[chunk].value = Stage::fold(stage, identity, chunkFunc);
+		});
+
+		// Combine in chunk order so the result does not depend on which thread finished first.
+		TDest result = std::move(partials[0].value);
+		for (int chunk = 1; chunk < chunkCount; ++chunk)
+		{
+			result = combine(std::move(result), std::move(partials[chunk].value));
+		}
+		return result;
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	template<class... TArgs>
+	void MutableList<T, TGrowth, InlineCount>::emplaceBack(TArgs &&... args)
+	{
+		if (mLength == mCapacity)
+		{
+			// Arguments may be items of this list, construct before the items move to a larger buffer.
+			T item(std::forward<TArgs>(args)...);
+			ensureCapacity(mLength + 1);
+			::new (static_cast<void *>(data() + mLength)) T(std::move(item));
+		}
+		else
+		{
+			::new (static_cast<void *>(data() + mLength)) T(std::forward<TArgs>(args)...);
+		}
+		setLength(mLength + 1);
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::appendRange(const T * input, int length)
+	{
+		if (length <= 0) return;
+
+		// Items of this list would move away while growing, copy them out first.
+		std::less<const T *> before;
+		if (mLength + length > mCapacity && !before(input, data()) && before(input, data() + mLength))
+		{
+			MutableList<T, TGrowth, InlineCount> copy(input, length);
+			appendRange(copy.data(), length);
+			return;
+		}
+
+		ensureCapacity(mLength + length);
+		Buffer::copy(input, length, data() + mLength);
+		setLength(mLength + length);
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::appendAll(const IEnumerable<T> & input)
+	{
+		const MutableList<T, TGrowth, InlineCount> * list = dynamic_cast<const MutableList<T, TGrowth, InlineCount> *>(&input);
+		if (list)
+		{
+			appendRange(list->data(), list->mLength);
+			return;
+		}
+
+		auto enumerator = input.getEnumerator();
+		SizeHint hint = enumerator->getSizeHint();
+		if (hint.getKind() == SizeHint::Exact) reserve(mLength + hint.getCount());
+		appendFrom(*enumerator, typename Buffer::IsTrivial());
+	}
+
+	template<class T, class TGrowth, int InlineCount>
+	T MutableList<T, TGrowth, InlineCount>::pop()
 	{
 		// Cant pop from empty list
 		if (mLength == 0) throw Exception::EmptyListException();
-		return mBuffer.get()[mLength--];
+
+		// A snapshot may still read the last item, give the list a buffer of its own first.
+		detach();
+
+		T * last = data() + mLength - 1;
+		T value(std::move(*last));
+		last->~T();
+		setLength(mLength - 1);
+		return value;
 	}
 
-	template<class T>
-	T & MutableList<T>::operator[](unsigned int i)
+	template<class T, class TGrowth, int InlineCount>
+	T & MutableList<T, TGrowth, InlineCount>::operator[](unsigned int i)
 	{
 		if (i >= mLength)
 		{
 			throw Exception::IndexOutOfBounds();
 		}
-		return mBuffer.get()[i];
+		detach();
+		return data()[i];
 	}
 
-	template<class T>
-	T MutableList<T>::at(unsigned int i) const
+	template<class T, class TGrowth, int InlineCount>
+	const T & MutableList<T, TGrowth, InlineCount>::at(unsigned int i) const
 	{
-		return (const_cast<MutableList<T>*>(this))->operator[](i);
+		if (i >= static_cast<unsigned int>(mLength))
+		{
+			throw Exception::IndexOutOfBounds();
+		}
+		return data()[i];
 	}
 
-	template<class T>
-	MutableList<T> MutableList<T>::reverse()
+	template<class T, class TGrowth, int InlineCount>
+	MutableList<T, TGrowth, InlineCount> MutableList<T, TGrowth, InlineCount>::reverse()
 	{
 		// Create copy of this list
-		MutableList<T> reversedList(*this);
+		MutableList<T, TGrowth, InlineCount> reversedList(*this);
 		reversedList.reverseInPlace();
 
 		// return with move constructor (prevent another copy)
 		return std::move(reversedList);
 	}
 
-	template<class T>
-	void MutableList<T>::setCapacity(int newCapacity)
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::setCapacity(int newCapacity)
 	{
 		// Ignore request for too small capacity
 		if (newCapacity >= mLength)
 		{
-			// Double buffer size.
-			T * newBuffer = new T[newCapacity];
-			memcpy(newBuffer, mBuffer.get(), mLength * sizeof(T));
-			T * temp = mBuffer.get();
+			if (newCapacity <= InlineCount)
+			{
+				// Short enough for the inline slots, which are always there.
+				if (mBuffer)
+				{
+					T * items = mBuffer.get();
+					if (isShared()) Buffer::copy(items, mLength, inlineItems());
+					else Buffer::relocate(items, mLength, inlineItems());
+					mBuffer.reset();
+				}
+				mFileMapped = false;
+				mCapacity = InlineCount;
+				return;
+			}
+
+			// Large mapped buffers grow without a second buffer or a copy when nothing else reads them.
+			// A file mapping has no header to resize, it is only ever copied.
+			if (mBuffer && !mFileMapped && tryResize(newCapacity, IsRemapped()))
+			{
+				mCapacity = newCapacity;
+				return;
+			}
+
+			std::shared_ptr<T> newBuffer = Buffer::allocate(newCapacity, isMapped(newCapacity));
+
+			// Move items across unless an enumerator still reads the old buffer, then it keeps intact copies.
+			if (!mBuffer)
+			{
+				// Spill inline items, nobody else can read them.
+				Buffer::relocate(inlineItems(), mLength, newBuffer.get());
+				Buffer::destroy(inlineItems(), mLength);
+			}
+			else if (isShared()) Buffer::copy(mBuffer.get(), mLength, newBuffer.get());
+			else Buffer::relocate(mBuffer.get(), mLength, newBuffer.get());
+			Buffer::getCount(newBuffer.get()) = mLength;
 
 			// Smart pointer will destroy old buffer if its not owned by some enumerator.
-			mBuffer.reset(newBuffer, std::default_delete<T[]>());
+			mBuffer = std::move(newBuffer);
+			mFileMapped = false;
 			mCapacity = newCapacity;
 		}
 	}
 
-	template<class T>
-	void MutableList<T>::allocateCapacity(int capacity)
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::allocateCapacity(int capacity)
 	{
-		// Make sure capacity is at least one. 
+		// Make sure capacity is at least one, short lists stay in the inline slots.
 		if (capacity <= 0) capacity = 1;
+		if (capacity <= InlineCount) return;
 		mCapacity = capacity;
-		mBuffer.reset(new T[mCapacity], std::default_delete<T[]>());
+		mBuffer = Buffer::allocate(mCapacity, isMapped(mCapacity));
 	}
 
-	template<class T>
-	void MutableList<T>::ensureCapacity()
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::ensureCapacity(int required)
 	{
-		if (mLength == mCapacity)
+		if (required > mCapacity)
 		{
-			// Double buffer size and copy items
-			auto newCapacity = mCapacity * 2;
-			setCapacity(newCapacity);
+			// Grow and move items, a moved from list starts again at the default.
+			setCapacity(mCapacity > 0 ? TGrowth::getCapacity(mCapacity, required, sizeof(T)) : std::max(required, DEFAULT_CAPACITY));
 		}
 	}
 
-	template<class T>
-	void MutableList<T>::reverseInPlace()
+	template<class T, class TGrowth, int InlineCount>
+	void MutableList<T, TGrowth, InlineCount>::reverseInPlace()
 	{
-		T * startPtr = mBuffer.get();
-		T * endPtr = mBuffer.get() + mLength - 1;
+		T * startPtr = data();
+		T * endPtr = data() + mLength - 1;
 		while (startPtr < endPtr)
 		{
 			// Swap values;
-			T temp = *startPtr;
-			*startPtr = *endPtr;
-			*endPtr = temp;
+			std::swap(*startPtr, *endPtr);
 			++startPtr;
 			--endPtr;
 		}
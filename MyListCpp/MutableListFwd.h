@@ -0,0 +1,21 @@
+/**
+ *  Summary: Forward declaration of MutableList carrying the default growth policy.
+ *  Included before anything else by every header naming MutableList, so the default is seen first whatever the include order.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include "Memory/Growth.h"
+
+namespace MyList{
+
+	/**
+	 * \brief Forward declaration
+	 * \tparam T Type of item to be stored in list.
+	 * \tparam TGrowth Growth policy for the buffer, see Memory/Growth.h.
+	 * \tparam InlineCount Number of items stored inside the list before spilling to the heap.
+	 */
+	template<class T, class TGrowth = Memory::DoublingGrowth, int InlineCount = 0>
+	class MutableList;
+}
@@ -0,0 +1,51 @@
+/**
+ *  Summary: Deterministic split of a buffer into chunks for parallel operations.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#define MIN_CHUNK_LENGTH 16384
+
+namespace MyList
+{
+	namespace Parallel
+	{
+		/**
+		 * \brief Get number of chunks to split a buffer into.
+		 * Depends only on length and threadCount, so results combined in chunk order are reproducible for a fixed thread count.
+		 * \param length Number of items
+		 * \param threadCount Number of threads that will work on the chunks
+		 * \return Chunk count, 0 for an empty buffer
+		 */
+		inline int getChunkCount(int length, int threadCount)
+		{
+			if (length <= 0) return 0;
+			int count = length / MIN_CHUNK_LENGTH;
+			if (count < 1) count = 1;
+			return count < threadCount ? count : threadCount;
+		}
+
+		/**
+		 * \brief Get index of first item of a chunk, chunks differ in length by at most one.
+		 * \param chunk Chunk index, chunkCount gives the end of the last chunk.
+		 * \param chunkCount Number of chunks
+		 * \param length Number of items
+		 * \return Item index
+		 */
+		inline int getChunkBegin(int chunk, int chunkCount, int length)
+		{
+			return static_cast<int>((static_cast<long long>(length) * chunk) / chunkCount);
+		}
+
+		/**
+		 * \brief Per chunk result, kept in its own object so threads never write to a shared word (e.g. vector<bool>).
+		 * \tparam T Type of result
+		 */
+		template<class T>
+		struct Partial
+		{
+			T value;
+		};
+	}
+}
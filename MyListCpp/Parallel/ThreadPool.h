@@ -0,0 +1,188 @@
+/**
+ *  Summary: Fixed set of worker threads that run a batch of indexed tasks, with the calling thread helping.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../Memory/Global.h"
+
+namespace MyList
+{
+	namespace Parallel
+	{
+		/**
+		 * \brief Fixed set of worker threads that run a batch of indexed tasks.
+		 * One batch runs at a time; run() called while another batch is running, e.g. from inside a task, runs its tasks inline.
+		 */
+		class ThreadPool
+		{
+		public:
+			/**
+			 * \brief Start pool.
+			 * \param threadCount Number of threads working on a batch, including the thread calling run().
+			 */
+			explicit ThreadPool(int threadCount) : mTaskCount(0), mNextTask(0), mPending(0), mStopping(false)
+			{
+				for (int i = 1; i < threadCount; ++i)
+				{
+					mThreads.push_back(std::thread([this](){ workerLoop(); }));
+				}
+			}
+
+			/**
+			 * \brief Stop and join every worker.
+			 */
+			~ThreadPool()
+			{
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					mStopping = true;
+				}
+				mWake.notify_all();
+				for (size_t i = 0; i < mThreads.size(); ++i)
+				{
+					mThreads[i].join();
+				}
+			}
+
+			/**
+			 * \brief Get number of threads working on a batch, including the thread calling run().
+			 * \return Thread count
+			 */
+			int getThreadCount() const
+			{
+				return static_cast<int>(mThreads.size()) + 1;
+			}
+
+			/**
+			 * \brief Run task(0) .. task(taskCount - 1) across the pool and wait for all of them.
+			 * Tasks are handed out in index order, the first exception thrown by a task is rethrown here once all have finished.
+			 * \param taskCount Number of tasks
+			 * \param task Callable taking task index
+			 */
+			void run(int taskCount, const std::function<void(int)> & task)
+			{
+				std::unique_lock<std::mutex> runLock(mRunMutex, std::try_to_lock);
+				if (!runLock.owns_lock() || mThreads.empty())
+				{
+					for (int i = 0; i < taskCount; ++i)
+					{
+						task(i);
+					}
+					return;
+				}
+
+				std::unique_lock<std::mutex> lock(mMutex);
+				mTask = task;
+				mTaskCount = taskCount;
+				mNextTask = 0;
+				mPending = taskCount;
+				mError = std::exception_ptr();
+				mWake.notify_all();
+
+				// Help instead of idling until the workers are done.
+				while (mNextTask < mTaskCount)
+				{
+					int index = mNextTask++;
+					lock.unlock();
+					execute(index);
+					lock.lock();
+					--mPending;
+				}
+				mDone.wait(lock, [this](){ return mPending == 0; });
+
+				std::exception_ptr error = mError;
+				mTask = nullptr;
+				mTaskCount = 0;
+				mNextTask = 0;
+				mError = std::exception_ptr();
+				lock.unlock();
+
+				if (error) std::rethrow_exception(error);
+			}
+
+			/**
+			 * \brief Get pool shared by the parallel operations, with one thread per hardware thread.
+			 * \return Reference to default pool
+			 */
+			static ThreadPool & getDefault()
+			{
+				// Never destroyed, so parallel work started by static destructors at exit still has its workers.
+				return Memory::Global<ThreadPool>::get([](){
+					return new ThreadPool(std::thread::hardware_concurrency() > 0 ? static_cast<int>(std::thread::hardware_concurrency()) : 1);
+				});
+			}
+
+		private:
+			ThreadPool(const ThreadPool & other);
+			ThreadPool & operator=(const ThreadPool & other);
+
+			void workerLoop()
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				while (true)
+				{
+					mWake.wait(lock, [this](){ return mStopping || mNextTask < mTaskCount; });
+					if (mStopping) return;
+
+					int index = mNextTask++;
+					lock.unlock();
+					execute(index);
+					lock.lock();
+					if (--mPending == 0) mDone.notify_all();
+				}
+			}
+
+			void execute(int index)
+			{
+				try
+				{
+					mTask(index);
+				}
+				catch (...)
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					if (!mError) mError = std::current_exception();
+				}
+			}
+
+			std::vector<std::thread> mThreads;
+
+			/**
+			 * \brief Held for the length of a batch, so only one batch is handed to the workers at a time.
+			 */
+			std::mutex mRunMutex;
+
+			/**
+			 * \brief Guards every member below.
+			 */
+			std::mutex mMutex;
+
+			std::condition_variable mWake;
+
+			std::condition_variable mDone;
+
+			std::function<void(int)> mTask;
+
+			int mTaskCount;
+
+			int mNextTask;
+
+			/**
+			 * \brief Tasks of the current batch not finished yet.
+			 */
+			int mPending;
+
+			bool mStopping;
+
+			std::exception_ptr mError;
+		};
+	}
+}
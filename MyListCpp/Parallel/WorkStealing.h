@@ -0,0 +1,135 @@
+/**
+ *  Summary: Work stealing loop over an index range, run on a ThreadPool.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace MyList
+{
+	namespace Parallel
+	{
+		/**
+		 * \brief Ranges waiting to run on one worker. The owner works from the back, thieves take from the front.
+		 */
+		class RangeQueue
+		{
+		public:
+			/**
+			 * \brief Add range to the back.
+			 * \param range [begin, end)
+			 */
+			void push(const std::pair<int, int> & range)
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mRanges.push_back(range);
+			}
+
+			/**
+			 * \brief Take the most recently pushed range, the smallest one nearest to what the owner just ran.
+			 * \param range Output range
+			 * \return False if queue is empty, True otherwise.
+			 */
+			bool pop(std::pair<int, int> & range)
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				if (mRanges.empty()) return false;
+				range = mRanges.back();
+				mRanges.pop_back();
+				return true;
+			}
+
+			/**
+			 * \brief Take the oldest range, the largest one.
+			 * \param range Output range
+			 * \return False if queue is empty, True otherwise.
+			 */
+			bool steal(std::pair<int, int> & range)
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				if (mRanges.empty()) return false;
+				range = mRanges.front();
+				mRanges.pop_front();
+				return true;
+			}
+
+		private:
+			std::mutex mMutex;
+			std::deque<std::pair<int, int> > mRanges;
+		};
+
+		/**
+		 * \brief Run task over every unit of [0, length) on the pool.
+		 * Every thread starts with an equal share and halves its ranges down to grain as it goes, pushing the upper halves
+		 * where idle threads can steal them, so uneven work (e.g. a selective filter) still keeps every thread busy.
+		 * \tparam TTask Callable taking (begin, end), called concurrently for disjoint ranges.
+		 * \param pool Thread pool to run on
+		 * \param length Number of units
+		 * \param grain Smallest range worth running as one task
+		 * \param task Task callable
+		 */
+		template<class TTask>
+		void forEachRange(ThreadPool & pool, int length, int grain, TTask task)
+		{
+			if (length <= 0) return;
+			if (grain < 1) grain = 1;
+
+			const int workerCount = pool.getThreadCount();
+			std::vector<std::unique_ptr<RangeQueue> > queues;
+			for (int worker = 0; worker < workerCount; ++worker)
+			{
+				queues.push_back(std::unique_ptr<RangeQueue>(new RangeQueue()));
+				int begin = static_cast<int>((static_cast<long long>(length) * worker) / workerCount);
+				int end = static_cast<int>((static_cast<long long>(length) * (worker + 1)) / workerCount);
+				if (begin < end) queues[worker]->push(std::make_pair(begin, end));
+			}
+
+			std::atomic<int> remaining(length);
+			std::atomic<bool> failed(false);
+			pool.run(workerCount, [&](int worker){
+				std::pair<int, int> range;
+				while (remaining.load() > 0 && !failed.load())
+				{
+					bool found = queues[worker]->pop(range);
+					for (int offset = 1; !found && offset < workerCount; ++offset)
+					{
+						found = queues[(worker + offset) % workerCount]->steal(range);
+					}
+					if (!found)
+					{
+						// Everything left is already running on other threads.
+						std::this_thread::yield();
+						continue;
+					}
+
+					while (range.second - range.first > grain)
+					{
+						int middle = range.first + (range.second - range.first) / 2;
+						queues[worker]->push(std::make_pair(middle, range.second));
+						range.second = middle;
+					}
+
+					try
+					{
+						task(range.first, range.second);
+					}
+					catch (...)
+					{
+						failed = true;
+						throw;
+					}
+					remaining -= range.second - range.first;
+				}
+			});
+		}
+	}
+}
@@ -0,0 +1,113 @@
+/**
+ *  Summary: Class that represents a pipeline whose map and filter stages run across a work stealing thread pool.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include<algorithm>
+#include<memory>
+#include<mutex>
+#include<utility>
+#include<vector>
+
+#include "MutableListFwd.h"
+#include "IEnumerable.h"
+#include "Parallel/ThreadPool.h"
+#include "Parallel/WorkStealing.h"
+#include "Stage/FilterStage.h"
+#include "Stage/MapStage.h"
+
+namespace MyList{
+
+	template<class TStage>
+	class Pipeline;
+
+	/**
+	 * \brief Class that represents a pipeline whose map and filter stages run across a work stealing thread pool.
+	 * The source at the start of the chain is split into units (items of a MutableList, node segments of an ImmutableList);
+	 * every task runs a copy of the whole chain over its own range of units.
+	 * \tparam TStage Type of the last stage in the chain.
+	 */
+	template<class TStage>
+	class ParallelPipeline
+	{
+	public:
+		/**
+		 * \brief Type of items produced by the stage
+		 */
+		typedef typename TStage::value_type T;
+
+		/**
+		 * \brief Initializes parallel pipeline from a stage whose source has been split.
+		 * \param stage Stage in its initial position, copied for every task.
+		 * \param splitLength Number of split units returned by the source's split().
+		 * \param pool Thread pool to run on, must outlive the pipeline.
+		 */
+		ParallelPipeline(const TStage & stage, int splitLength, Parallel::ThreadPool & pool) : mStage(stage), mSplitLength(splitLength), mPool(&pool){}
+
+		/**
+		 * \brief Map this pipeline to another, map callable is called concurrently.
+		 * \tparam TDest Type of item destination list
+		 * \tparam TFunc Type of map callable taking T, copied into every task.
+		 * \param func Map callable
+		 * \return ParallelPipeline of mapped values.
+		 */
+		template<typename TDest, typename TFunc>
+		ParallelPipeline<Stage::MapStage<TStage, TDest, TFunc> > map(TFunc func) const;
+
+		/**
+		 * \brief Filter pipeline, predicate is called concurrently.
+		 * \tparam TPredicate Type of predicate callable taking T, copied into every task.
+		 * \param predicate Predicate used to filter items
+		 * \return ParallelPipeline of filtered values.
+		 */
+		template<typename TPredicate>
+		ParallelPipeline<Stage::FilterStage<TStage, TPredicate> > filter(TPredicate predicate) const;
+
+		/**
+		 * \brief Evaluate pipeline into a new MutableList, keeping the order of the source.
+		 * \return new MutableList
+		 */
+		MutableList<T> toMutableList() const
+		{
+			return collect(true);
+		}
+
+		/**
+		 * \brief Evaluate pipeline into a new MutableList. Items of a range stay together, ranges are in completion order.
+		 * \return new MutableList
+		 */
+		MutableList<T> toUnorderedMutableList() const
+		{
+			return collect(false);
+		}
+
+		/**
+		 * \brief Continue with the same chain on the calling thread only.
+		 * \return Pipeline
+		 */
+		Pipeline<TStage> sequential() const
+		{
+			return Pipeline<TStage>(mStage);
+		}
+
+	private:
+		/**
+		 * \brief Run every range and concatenate the results.
+		 * \param ordered Concatenate in source order if True, completion order otherwise.
+		 * \return new MutableList
+		 */
+		MutableList<T> collect(bool ordered) const;
+
+		/**
+		 * \brief Last stage of the chain, never advanced. Every task works on a copy.
+		 */
+		TStage mStage;
+
+		int mSplitLength;
+
+		Parallel::ThreadPool * mPool;
+	};
+}
+
+#include "ParallelPipeline.tpp"
@@ -0,0 +1,48 @@
+namespace MyList{
+
+	template<typename TStage>
+	template<typename TDest, typename TFunc>
+	ParallelPipeline<Stage::MapStage<TStage, TDest, TFunc> > ParallelPipeline<TStage>::map(TFunc func) const{
+		// Nest current stage inside a new map stage, the split source is shared.
+		return ParallelPipeline<Stage::MapStage<TStage, TDest, TFunc> >(Stage::MapStage<TStage, TDest, TFunc>(mStage, func), mSplitLength, *mPool);
+	}
+
+	template<typename TStage>
+	template<typename TPredicate>
+	ParallelPipeline<Stage::FilterStage<TStage, TPredicate> > ParallelPipeline<TStage>::filter(TPredicate predicate) const{
+		// Nest current stage inside a new filter stage, the split source is shared.
+		return ParallelPipeline<Stage::FilterStage<TStage, TPredicate> >(Stage::FilterStage<TStage, TPredicate>(mStage, predicate), mSplitLength, *mPool);
+	}
+
+	template<typename TStage>
+	MutableList<typename TStage::value_type> ParallelPipeline<TStage>::collect(bool ordered) const{
+		typedef std::pair<int, std::shared_ptr<MutableList<T> > > Part;
+
+		std::vector<Part> parts;
+		std::mutex partsMutex;
+		const TStage & stage = mStage;
+		int grain = TStage(mStage).getOrigin().getSplitGrain();
+
+		// Every range runs the whole chain into its own list, block kernels still apply per range.
+		Parallel::forEachRange(*mPool, mSplitLength, grain, [&](int begin, int end){
+			TStage range(stage);
+			range.getOrigin().setSplitRange(begin, end);
+			std::shared_ptr<MutableList<T> > list = std::make_shared<MutableList<T> >(MutableList<T>::fromStage(range));
+
+			std::unique_lock<std::mutex> lock(partsMutex);
+			parts.push_back(Part(begin, list));
+		});
+
+		if (ordered)
+		{
+			std::sort(parts.begin(), parts.end(), [](const Part & a, const Part & b){ return a.first < b.first; });
+		}
+
+		std::vector<const MutableList<T> *> lists;
+		for (size_t i = 0; i < parts.size(); ++i)
+		{
+			lists.push_back(parts[i].second.get());
+		}
+		return MutableList<T>::concatParts(lists);
+	}
+}
@@ -0,0 +1,231 @@
+/**
+ *  Summary: Class that represents a statically typed, lazily evaluated chain of stages over a list.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include<memory>
+#include<utility>
+
+#include "ImmutableListFwd.h"
+#include "MutableListFwd.h"
+#include "IEnumerable.h"
+#include "ParallelPipeline.h"
+#include "Enumerator/IEnumerator.h"
+#include "Enumerator/StageEnumerator.h"
+#include "Exception/MyExceptions.h"
+#include "Parallel/ThreadPool.h"
+#include "Stage/Capability.h"
+#include "Stage/FilterStage.h"
+#include "Stage/Fold.h"
+#include "Stage/MapStage.h"
+#include "Stage/ReverseStage.h"
+#include "Stage/SkipStage.h"
+#include "Stage/TakeStage.h"
+#include "Stage/TakeWhileStage.h"
+
+namespace MyList{
+	using namespace Enumerator;
+
+	template<class T>
+	class IEnumerable;
+
+	template<class T>
+	class LazyList;
+
+	template<class TStage>
+	class ParallelPipeline;
+
+	/**
+	 * \brief Class that represents a statically typed, lazily evaluated chain of stages over a list.
+	 * Every map and filter adds a stage to the type instead of wrapping a heap allocated enumerator,
+	 * so terminal operations run as a single loop without virtual calls.
+	 * The chain keeps the capability tier of its stages (see Stage/Capability.h): a map over a MutableList can still be
+	 * indexed, sliced and reversed in O(1), a filter anywhere in the chain leaves it forward only.
+	 * \tparam TStage Type of the last stage in the chain.
+	 */
+	template<class TStage>
+	class Pipeline : public IEnumerable < typename TStage::value_type >
+	{
+	public:
+		/**
+		 * \brief Type of items produced by the stage
+		 */
+		typedef typename TStage::value_type T;
+
+		/**
+		 * \brief Capability tier of the chain
+		 */
+		typedef typename TStage::capability_type capability_type;
+
+		/**
+		 * \brief Initializes pipeline from a stage.
+		 * \param stage Stage in its initial position, copied for every evaluation.
+		 */
+		explicit Pipeline(const TStage & stage) : mStage(stage){}
+
+		/**
+		 * \brief Map this pipeline to another
+		 * \tparam TDest Type of item destination list
+		 * \tparam TFunc Type of map callable, any function, lambda or functor taking T.
+		 * \param func Map callable
+		 * \return Pipeline of mapped values.
+		 */
+		template<typename TDest, typename TFunc>
+		Pipeline<Stage::MapStage<TStage, TDest, TFunc> > map(TFunc func) const;
+
+		/**
+		 * \brief Filter pipeline
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate used to filter items
+		 * \return Pipeline of filtered values.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::FilterStage<TStage, TPredicate> > filter(TPredicate predicate) const;
+
+		/**
+		 * \brief Pass on only the first count items, nothing past them is evaluated.
+		 * \param count Maximum number of items
+		 * \return Pipeline of at most count items.
+		 */
+		Pipeline<Stage::TakeStage<TStage> > take(int count) const;
+
+		/**
+		 * \brief Pass on items until the first one that fails a predicate, nothing past it is evaluated.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate items must satisfy
+		 * \return Pipeline of the leading items satisfying predicate.
+		 */
+		template<typename TPredicate>
+		Pipeline<Stage::TakeWhileStage<TStage, TPredicate> > takeWhile(TPredicate predicate) const;
+
+		/**
+		 * \brief Drop the first count items without evaluating them. Random access chains jump past them in O(1).
+		 * \param count Number of items to drop
+		 * \return Pipeline of the items after the first count.
+		 */
+		Pipeline<Stage::SkipStage<TStage> > skip(int count) const;
+
+		/**
+		 * \brief Get number of items without evaluating them. Sized pipelines only.
+		 * \return Length
+		 */
+		int getLength() const;
+
+		/**
+		 * \brief Get item at index, evaluating only that item. Random access pipelines only.
+		 * \param i index
+		 * \return Item
+		 */
+		T at(int i) const;
+
+		/**
+		 * \brief Restrict pipeline to items [begin, end) without evaluating or copying any. Random access pipelines only.
+		 * \param begin Index of first item
+		 * \param end Index one past last item
+		 * \return Pipeline over the slice
+		 */
+		Pipeline slice(int begin, int end) const;
+
+		/**
+		 * \brief View items back to front without evaluating or copying any. Random access pipelines only.
+		 * \return Pipeline reading the chain by index from the end.
+		 */
+		Pipeline<Stage::ReverseStage<TStage> > reverse() const;
+
+		/**
+		 * \brief Aggregate values in the pipeline.
+		 * \tparam TDest Aggregate value type
+		 * \tparam TFunc Type of aggregate callable taking (TDest, T).
+		 * \param initial Initial value
+		 * \param func Aggregate callable
+		 * \return Aggregate value
+		 */
+		template<typename TDest, typename TFunc>
+		TDest foldLeft(TDest initial, TFunc func) const;
+
+		/**
+		 * \brief Check whether any item satisfies a predicate, stops at the first that does.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate
+		 * \return True if an item satisfies predicate, False if none does or the pipeline is empty.
+		 */
+		template<typename TPredicate>
+		bool any(TPredicate predicate) const;
+
+		/**
+		 * \brief Check whether every item satisfies a predicate, stops at the first that does not.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate
+		 * \return False if an item fails predicate, True otherwise, also for an empty pipeline.
+		 */
+		template<typename TPredicate>
+		bool all(TPredicate predicate) const;
+
+		/**
+		 * \brief Find the first item satisfying a predicate, nothing past it is evaluated.
+		 * \tparam TPredicate Type of predicate callable taking T.
+		 * \param predicate Predicate
+		 * \param out Reference for the item, unchanged if none is found.
+		 * \return True if an item was found.
+		 */
+		template<typename TPredicate>
+		bool find(TPredicate predicate, T & out) const;
+
+		/**
+		 * \brief Get the first item, only that item is evaluated.
+		 * \return First item, throws EmptyListException if the pipeline is empty.
+		 */
+		T first() const;
+
+		/**
+		 * \brief Run the rest of the chain across a thread pool. The source must be splittable (a MutableList or ImmutableList).
+		 * \param pool Thread pool to run on
+		 * \return ParallelPipeline over the same chain
+		 */
+		ParallelPipeline<TStage> parallel(Parallel::ThreadPool & pool = Parallel::ThreadPool::getDefault()) const;
+
+		/**
+		 * \brief Convert pipeline to a new ImmutableList. Forces evalutation for the entire pipeline.
+		 * \return new ImmutableList
+		 */
+		ImmutableList<T> toImmutableList() const;
+
+		/**
+		 * \brief Convert pipeline to a new MutableList. Forces evalutation for the entire pipeline.
+		 * \return new MutableList
+		 */
+		MutableList<T> toMutableList() const;
+
+		/**
+		 * \brief Type-erase the pipeline, for passing it across an API boundary.
+		 * \return LazyList over this pipeline.
+		 */
+		LazyList<T> toLazyList() const;
+
+		/**
+		 * \brief Implicit conversion to type-erased LazyList.
+		 */
+		operator LazyList<T>() const
+		{
+			return toLazyList();
+		}
+
+		/**
+		 * \brief Get new enumerator for this pipeline.
+		 * \return std::shared_ptr < IEnumerator<T> >
+		 */
+		std::shared_ptr<IEnumerator<T> > getEnumerator() const override
+		{
+			return std::shared_ptr<IEnumerator<T> >(new StageEnumerator<TStage>(mStage));
+		}
+
+	private:
+		/**
+		 * \brief Last stage of the chain, never advanced. Evaluations work on a copy.
+		 */
+		TStage mStage;
+	};
+}
+
+#include "Pipeline.tpp"
@@ -0,0 +1,138 @@
+namespace MyList{
+
+	template<typename TStage>
+	template<typename TDest, typename TFunc>
+	Pipeline<Stage::MapStage<TStage, TDest, TFunc> > Pipeline<TStage>::map(TFunc func) const{
+		// Nest current stage inside a new map stage
+		return Pipeline<Stage::MapStage<TStage, TDest, TFunc> >(Stage::MapStage<TStage, TDest, TFunc>(mStage, func));
+	}
+
+	template<typename TStage>
+	template<typename TPredicate>
+	Pipeline<Stage::FilterStage<TStage, TPredicate> > Pipeline<TStage>::filter(TPredicate predicate) const{
+		// Nest current stage inside a new filter stage
+		return Pipeline<Stage::FilterStage<TStage, TPredicate> >(Stage::FilterStage<TStage, TPredicate>(mStage, predicate));
+	}
+
+	template<typename TStage>
+	Pipeline<Stage::TakeStage<TStage> > Pipeline<TStage>::take(int count) const{
+		return Pipeline<Stage::TakeStage<TStage> >(Stage::TakeStage<TStage>(mStage, count));
+	}
+
+	template<typename TStage>
+	template<typename TPredicate>
+	Pipeline<Stage::TakeWhileStage<TStage, TPredicate> > Pipeline<TStage>::takeWhile(TPredicate predicate) const{
+		return Pipeline<Stage::TakeWhileStage<TStage, TPredicate> >(Stage::TakeWhileStage<TStage, TPredicate>(mStage, predicate));
+	}
+
+	template<typename TStage>
+	Pipeline<Stage::SkipStage<TStage> > Pipeline<TStage>::skip(int count) const{
+		return Pipeline<Stage::SkipStage<TStage> >(Stage::SkipStage<TStage>(mStage, count));
+	}
+
+	template<typename TStage>
+	int Pipeline<TStage>::getLength() const{
+		static_assert(Stage::HasCapability<TStage, Stage::SizedTag>::value, "getLength() needs a sized pipeline, a filter drops an unknown number of items");
+		return mStage.getSizeHint().getCount();
+	}
+
+	template<typename TStage>
+	typename TStage::value_type Pipeline<TStage>::at(int i) const{
+		static_assert(Stage::HasCapability<TStage, Stage::RandomAccessTag>::value, "at() needs a random access pipeline");
+		if (i < 0 || i >= mStage.getRemaining())
+		{
+			throw Exception::IndexOutOfBounds();
+		}
+		return mStage.at(i);
+	}
+
+	template<typename TStage>
+	Pipeline<TStage> Pipeline<TStage>::slice(int begin, int end) const{
+		static_assert(Stage::HasCapability<TStage, Stage::RandomAccessTag>::value, "slice() needs a random access pipeline");
+		if (begin < 0 || begin > end || end > mStage.getRemaining())
+		{
+			throw Exception::IndexOutOfBounds();
+		}
+		TStage stage(mStage);
+		stage.setRange(begin, end);
+		return Pipeline<TStage>(stage);
+	}
+
+	template<typename TStage>
+	Pipeline<Stage::ReverseStage<TStage> > Pipeline<TStage>::reverse() const{
+		static_assert(Stage::HasCapability<TStage, Stage::RandomAccessTag>::value, "reverse() needs a random access pipeline, materialize the list first");
+		return Pipeline<Stage::ReverseStage<TStage> >(Stage::ReverseStage<TStage>(mStage));
+	}
+
+	template<typename TStage>
+	template<typename TDest, typename TFunc>
+	TDest Pipeline<TStage>::foldLeft(TDest initial, TFunc func) const{
+		// Push every value through the chain into the accumulator, or a block kernel if one applies.
+		TStage stage(mStage);
+		return Stage::fold(stage, std::move(initial), func);
+	}
+
+	template<typename TStage>
+	template<typename TPredicate>
+	bool Pipeline<TStage>::any(TPredicate predicate) const{
+		// forEach stops pulling the chain as soon as the sink returns false.
+		TStage stage(mStage);
+		return !stage.forEach([&predicate](typename TStage::reference value){ return !predicate(value); });
+	}
+
+	template<typename TStage>
+	template<typename TPredicate>
+	bool Pipeline<TStage>::all(TPredicate predicate) const{
+		TStage stage(mStage);
+		return stage.forEach([&predicate](typename TStage::reference value){ return static_cast<bool>(predicate(value)); });
+	}
+
+	template<typename TStage>
+	template<typename TPredicate>
+	bool Pipeline<TStage>::find(TPredicate predicate, T & out) const{
+		TStage stage(mStage);
+		bool found = false;
+		typedef typename TStage::reference reference;
+		stage.forEach([&predicate, &out, &found](reference value){
+			if (!predicate(value)) return true;
+			out = std::forward<reference>(value);
+			found = true;
+			return false;
+		});
+		return found;
+	}
+
+	template<typename TStage>
+	typename TStage::value_type Pipeline<TStage>::first() const{
+		// Moving does not evaluate map stages, only reading the item does.
+		TStage stage(mStage);
+		if (!stage.moveNext())
+		{
+			throw Exception::EmptyListException();
+		}
+		return stage.getCurrent();
+	}
+
+	template<typename TStage>
+	ParallelPipeline<TStage> Pipeline<TStage>::parallel(Parallel::ThreadPool & pool) const{
+		// Split a copy of the source once, every task then restricts its own copy to a range.
+		TStage stage(mStage);
+		int splitLength = stage.getOrigin().split();
+		return ParallelPipeline<TStage>(stage, splitLength, pool);
+	}
+
+	template<typename TStage>
+	ImmutableList<typename TStage::value_type> Pipeline<TStage>::toImmutableList() const{
+		return ImmutableList<T>::fromStage(TStage(mStage));
+	}
+
+	template<typename TStage>
+	MutableList<typename TStage::value_type> Pipeline<TStage>::toMutableList() const{
+		return MutableList<T>::fromStage(TStage(mStage));
+	}
+
+	template<typename TStage>
+	LazyList<typename TStage::value_type> Pipeline<TStage>::toLazyList() const{
+		return LazyList<T>(getEnumerator());
+	}
+}
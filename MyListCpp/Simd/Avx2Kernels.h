@@ -0,0 +1,325 @@
+/**
+ *  Summary: AVX2 kernels for filter, count, map and reduce over int, float and double buffers.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include "CpuFeatures.h"
+#include "Operations.h"
+
+#if defined(MYLIST_SIMD_X86)
+#include <immintrin.h>
+
+namespace MyList
+{
+	namespace Simd
+	{
+		namespace Avx2
+		{
+			/**
+			 * \brief Byte indices of the set lanes of an 8 lane mask, packed to the front.
+			 * \return Eight 32 bit lane indices, one per byte
+			 */
+			inline const unsigned long long * packIndices32()
+			{
+				static const unsigned long long table[256] = {
+					0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000100ULL,
+					0x0000000000000002ULL, 0x0000000000000200ULL, 0x0000000000000201ULL, 0x0000000000020100ULL,
+					0x0000000000000003ULL, 0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL,
+					0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL, 0x0000000003020100ULL,
+					0x0000000000000004ULL, 0x0000000000000400ULL, 0x0000000000000401ULL, 0x0000000000040100ULL,
+					0x0000000000000402ULL, 0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+					0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL, 0x0000000004030100ULL,
+					0x0000000000040302ULL, 0x0000000004030200ULL, 0x0000000004030201ULL, 0x0000000403020100ULL,
+					0x0000000000000005ULL, 0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL,
+					0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL, 0x0000000005020100ULL,
+					0x0000000000000503ULL, 0x0000000000050300ULL, 0x0000000000050301ULL, 0x0000000005030100ULL,
+					0x0000000000050302ULL, 0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+					0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL, 0x0000000005040100ULL,
+					0x0000000000050402ULL, 0x0000000005040200ULL, 0x0000000005040201ULL, 0x0000000504020100ULL,
+					0x0000000000050403ULL, 0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL,
+					0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL, 0x0000050403020100ULL,
+					0x0000000000000006ULL, 0x0000000000000600ULL, 0x0000000000000601ULL, 0x0000000000060100ULL,
+					0x0000000000000602ULL, 0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+					0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL, 0x0000000006030100ULL,
+					0x0000000000060302ULL, 0x0000000006030200ULL, 0x0000000006030201ULL, 0x0000000603020100ULL,
+					0x0000000000000604ULL, 0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL,
+					0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL, 0x0000000604020100ULL,
+					0x0000000000060403ULL, 0x0000000006040300ULL, 0x0000000006040301ULL, 0x0000000604030100ULL,
+					0x0000000006040302ULL, 0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+					0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL, 0x0000000006050100ULL,
+					0x0000000000060502ULL, 0x0000000006050200ULL, 0x0000000006050201ULL, 0x0000000605020100ULL,
+					0x0000000000060503ULL, 0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL,
+					0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL, 0x0000060503020100ULL,
+					0x0000000000060504ULL, 0x0000000006050400ULL, 0x0000000006050401ULL, 0x0000000605040100ULL,
+					0x0000000006050402ULL, 0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+					0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL, 0x0000060504030100ULL,
+					0x0000000605040302ULL, 0x0000060504030200ULL, 0x0000060504030201ULL, 0x0006050403020100ULL,
+					0x0000000000000007ULL, 0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL,
+					0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL, 0x0000000007020100ULL,
+					0x0000000000000703ULL, 0x0000000000070300ULL, 0x0000000000070301ULL, 0x0000000007030100ULL,
+					0x0000000000070302ULL, 0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+					0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL, 0x0000000007040100ULL,
+					0x0000000000070402ULL, 0x0000000007040200ULL, 0x0000000007040201ULL, 0x0000000704020100ULL,
+					0x0000000000070403ULL, 0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL,
+					0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL, 0x0000070403020100ULL,
+					0x0000000000000705ULL, 0x0000000000070500ULL, 0x0000000000070501ULL, 0x0000000007050100ULL,
+					0x0000000000070502ULL, 0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+					0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL, 0x0000000705030100ULL,
+					0x0000000007050302ULL, 0x0000000705030200ULL, 0x0000000705030201ULL, 0x0000070503020100ULL,
+					0x0000000000070504ULL, 0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL,
+					0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL, 0x0000070504020100ULL,
+					0x0000000007050403ULL, 0x0000000705040300ULL, 0x0000000705040301ULL, 0x0000070504030100ULL,
+					0x0000000705040302ULL, 0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+					0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL, 0x0000000007060100ULL,
+					0x0000000000070602ULL, 0x0000000007060200ULL, 0x0000000007060201ULL, 0x0000000706020100ULL,
+					0x0000000000070603ULL, 0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL,
+					0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL, 0x0000070603020100ULL,
+					0x0000000000070604ULL, 0x0000000007060400ULL, 0x0000000007060401ULL, 0x0000000706040100ULL,
+					0x0000000007060402ULL, 0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+					0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL, 0x0000070604030100ULL,
+					0x0000000706040302ULL, 0x0000070604030200ULL, 0x0000070604030201ULL, 0x0007060403020100ULL,
+					0x0000000000070605ULL, 0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL,
+					0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL, 0x0000070605020100ULL,
+					0x0000000007060503ULL, 0x0000000706050300ULL, 0x0000000706050301ULL, 0x0000070605030100ULL,
+					0x0000000706050302ULL, 0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+					0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL, 0x0000070605040100ULL,
+					0x0000000706050402ULL, 0x0000070605040200ULL, 0x0000070605040201ULL, 0x0007060504020100ULL,
+					0x0000000706050403ULL, 0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL,
+					0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL
+				};
+				return table;
+			}
+
+			/**
+			 * \brief Byte indices of the 32 bit halves of the set lanes of a 4 lane mask, packed to the front.
+			 * \return Eight 32 bit lane indices, one per byte
+			 */
+			inline const unsigned long long * packIndices64()
+			{
+				static const unsigned long long table[16] = {
+					0x0000000000000000ULL, 0x0000000000000100ULL, 0x0000000000000302ULL, 0x0000000003020100ULL,
+					0x0000000000000504ULL, 0x0000000005040100ULL, 0x0000000005040302ULL, 0x0000050403020100ULL,
+					0x0000000000000706ULL, 0x0000000007060100ULL, 0x0000000007060302ULL, 0x0000070603020100ULL,
+					0x0000000007060504ULL, 0x0000070605040100ULL, 0x0000070605040302ULL, 0x0706050403020100ULL
+				};
+				return table;
+			}
+
+			/**
+			 * \brief Load permutation that packs the set lanes of mask to the front.
+			 * \param table packIndices32 or packIndices64
+			 * \param mask Lane mask
+			 * \return Permutation for _mm256_permutevar8x32
+			 */
+			inline MYLIST_TARGET_AVX2 __m256i packPermutation(const unsigned long long * table, int mask)
+			{
+				return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(table + mask)));
+			}
+
+			/**
+			 * \brief 256 bit register operations per item type.
+			 * \tparam T Item type
+			 */
+			template<class T>
+			struct Vec;
+
+			template<>
+			struct Vec < int >
+			{
+				typedef __m256i type;
+				enum { Lanes = 8 };
+
+				static MYLIST_TARGET_AVX2 type load(const int * p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+				static MYLIST_TARGET_AVX2 void store(int * p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+				static MYLIST_TARGET_AVX2 type set1(int value) { return _mm256_set1_epi32(value); }
+				static MYLIST_TARGET_AVX2 type pack(type v, int mask) { return _mm256_permutevar8x32_epi32(v, packPermutation(packIndices32(), mask)); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_AVX2 int mask(type a, type b)
+				{
+					type result = C == ComparisonGreater ? _mm256_cmpgt_epi32(a, b) : (C == ComparisonLess ? _mm256_cmpgt_epi32(b, a) : _mm256_cmpeq_epi32(a, b));
+					return _mm256_movemask_ps(_mm256_castsi256_ps(result));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_AVX2 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm256_add_epi32(a, b);
+					case ArithmeticMultiply: return _mm256_mullo_epi32(a, b);
+					case ArithmeticMin: return _mm256_min_epi32(a, b);
+					default: return _mm256_max_epi32(a, b);
+					}
+				}
+			};
+
+			template<>
+			struct Vec < float >
+			{
+				typedef __m256 type;
+				enum { Lanes = 8 };
+
+				static MYLIST_TARGET_AVX2 type load(const float * p) { return _mm256_loadu_ps(p); }
+				static MYLIST_TARGET_AVX2 void store(float * p, type v) { _mm256_storeu_ps(p, v); }
+				static MYLIST_TARGET_AVX2 type set1(float value) { return _mm256_set1_ps(value); }
+				static MYLIST_TARGET_AVX2 type pack(type v, int mask) { return _mm256_permutevar8x32_ps(v, packPermutation(packIndices32(), mask)); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_AVX2 int mask(type a, type b)
+				{
+					return _mm256_movemask_ps(C == ComparisonGreater ? _mm256_cmp_ps(a, b, _CMP_GT_OQ) : (C == ComparisonLess ? _mm256_cmp_ps(a, b, _CMP_LT_OQ) : _mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_AVX2 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm256_add_ps(a, b);
+					case ArithmeticMultiply: return _mm256_mul_ps(a, b);
+					case ArithmeticMin: return _mm256_min_ps(b, a);
+					default: return _mm256_max_ps(b, a);
+					}
+				}
+			};
+
+			template<>
+			struct Vec < double >
+			{
+				typedef __m256d type;
+				enum { Lanes = 4 };
+
+				static MYLIST_TARGET_AVX2 type load(const double * p) { return _mm256_loadu_pd(p); }
+				static MYLIST_TARGET_AVX2 void store(double * p, type v) { _mm256_storeu_pd(p, v); }
+				static MYLIST_TARGET_AVX2 type set1(double value) { return _mm256_set1_pd(value); }
+				static MYLIST_TARGET_AVX2 type pack(type v, int mask)
+				{
+					return _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), packPermutation(packIndices64(), mask)));
+				}
+
+				template<Comparison C>
+				static MYLIST_TARGET_AVX2 int mask(type a, type b)
+				{
+					return _mm256_movemask_pd(C == ComparisonGreater ? _mm256_cmp_pd(a, b, _CMP_GT_OQ) : (C == ComparisonLess ? _mm256_cmp_pd(a, b, _CMP_LT_OQ) : _mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_AVX2 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm256_add_pd(a, b);
+					case ArithmeticMultiply: return _mm256_mul_pd(a, b);
+					case ArithmeticMin: return _mm256_min_pd(b, a);
+					default: return _mm256_max_pd(b, a);
+					}
+				}
+			};
+
+			/**
+			 * \brief Copy items satisfying the comparison to out, keeping order. out may equal in.
+			 * Kept lanes are packed with one permute and the whole register stored, it never reaches past the current input position.
+			 * \return Number of items kept
+			 */
+			template<Comparison C, class T>
+			MYLIST_TARGET_AVX2 int filter(const T * in, int length, T * out, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int count = 0;
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					typename V::type items = V::load(in + i);
+					int mask = V::template mask<C>(items, constant);
+					V::store(out + count, V::pack(items, mask));
+					count += popCount(static_cast<unsigned int>(mask));
+				}
+				for (; i < length; ++i)
+				{
+					out[count] = in[i];
+					count += compare<C>(in[i], value) ? 1 : 0;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Count items satisfying the comparison.
+			 * \return Number of matching items
+			 */
+			template<Comparison C, class T>
+			MYLIST_TARGET_AVX2 int count(const T * in, int length, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int count = 0;
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					count += popCount(static_cast<unsigned int>(V::template mask<C>(V::load(in + i), constant)));
+				}
+				for (; i < length; ++i)
+				{
+					count += compare<C>(in[i], value) ? 1 : 0;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Combine every item with a constant. out may equal in.
+			 */
+			template<Arithmetic A, class T>
+			MYLIST_TARGET_AVX2 void map(const T * in, int length, T * out, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					V::store(out + i, V::template combine<A>(V::load(in + i), constant));
+				}
+				for (; i < length; ++i)
+				{
+					out[i] = combine<A>(in[i], value);
+				}
+			}
+
+			/**
+			 * \brief Fold items into initial with an associative operation, one lane accumulator per column.
+			 * \return Reduced value
+			 */
+			template<Arithmetic A, class T>
+			MYLIST_TARGET_AVX2 T reduce(const T * in, int length, T initial)
+			{
+				typedef Vec<T> V;
+				T result = initial;
+				int i = 0;
+				if (length >= V::Lanes)
+				{
+					typename V::type accumulator = V::load(in);
+					for (i = V::Lanes; i + V::Lanes <= length; i += V::Lanes)
+					{
+						accumulator = V::template combine<A>(accumulator, V::load(in + i));
+					}
+
+					T lanes[V::Lanes];
+					V::store(lanes, accumulator);
+					for (int lane = 0; lane < V::Lanes; ++lane)
+					{
+						result = combine<A>(result, lanes[lane]);
+					}
+				}
+				for (; i < length; ++i)
+				{
+					result = combine<A>(result, in[i]);
+				}
+				return result;
+			}
+		}
+	}
+}
+
+#endif
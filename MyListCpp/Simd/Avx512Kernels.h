@@ -0,0 +1,219 @@
+/**
+ *  Summary: AVX-512 kernels for filter, count, map and reduce over int, float and double buffers.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include "CpuFeatures.h"
+#include "Operations.h"
+
+#if defined(MYLIST_SIMD_AVX512)
+#include <immintrin.h>
+
+namespace MyList
+{
+	namespace Simd
+	{
+		namespace Avx512
+		{
+			/**
+			 * \brief 512 bit register operations per item type.
+			 * \tparam T Item type
+			 */
+			template<class T>
+			struct Vec;
+
+			template<>
+			struct Vec < int >
+			{
+				typedef __m512i type;
+				enum { Lanes = 16 };
+
+				static MYLIST_TARGET_AVX512 type load(const int * p) { return _mm512_loadu_si512(p); }
+				static MYLIST_TARGET_AVX512 void store(int * p, type v) { _mm512_storeu_si512(p, v); }
+				static MYLIST_TARGET_AVX512 type set1(int value) { return _mm512_set1_epi32(value); }
+				static MYLIST_TARGET_AVX512 void compress(int * p, int mask, type v) { _mm512_mask_compressstoreu_epi32(p, static_cast<__mmask16>(mask), v); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_AVX512 int mask(type a, type b)
+				{
+					return C == ComparisonGreater ? _mm512_cmpgt_epi32_mask(a, b) : (C == ComparisonLess ? _mm512_cmplt_epi32_mask(a, b) : _mm512_cmpeq_epi32_mask(a, b));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_AVX512 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm512_add_epi32(a, b);
+					case ArithmeticMultiply: return _mm512_mullo_epi32(a, b);
+					case ArithmeticMin: return _mm512_min_epi32(a, b);
+					default: return _mm512_max_epi32(a, b);
+					}
+				}
+			};
+
+			template<>
+			struct Vec < float >
+			{
+				typedef __m512 type;
+				enum { Lanes = 16 };
+
+				static MYLIST_TARGET_AVX512 type load(const float * p) { return _mm512_loadu_ps(p); }
+				static MYLIST_TARGET_AVX512 void store(float * p, type v) { _mm512_storeu_ps(p, v); }
+				static MYLIST_TARGET_AVX512 type set1(float value) { return _mm512_set1_ps(value); }
+				static MYLIST_TARGET_AVX512 void compress(float * p, int mask, type v) { _mm512_mask_compressstoreu_ps(p, static_cast<__mmask16>(mask), v); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_AVX512 int mask(type a, type b)
+				{
+					return _mm512_cmp_ps_mask(a, b, C == ComparisonGreater ? _CMP_GT_OQ : (C == ComparisonLess ? _CMP_LT_OQ : _CMP_EQ_OQ));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_AVX512 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm512_add_ps(a, b);
+					case ArithmeticMultiply: return _mm512_mul_ps(a, b);
+					case ArithmeticMin: return _mm512_min_ps(b, a);
+					default: return _mm512_max_ps(b, a);
+					}
+				}
+			};
+
+			template<>
+			struct Vec < double >
+			{
+				typedef __m512d type;
+				enum { Lanes = 8 };
+
+				static MYLIST_TARGET_AVX512 type load(const double * p) { return _mm512_loadu_pd(p); }
+				static MYLIST_TARGET_AVX512 void store(double * p, type v) { _mm512_storeu_pd(p, v); }
+				static MYLIST_TARGET_AVX512 type set1(double value) { return _mm512_set1_pd(value); }
+				static MYLIST_TARGET_AVX512 void compress(double * p, int mask, type v) { _mm512_mask_compressstoreu_pd(p, static_cast<__mmask8>(mask), v); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_AVX512 int mask(type a, type b)
+				{
+					return _mm512_cmp_pd_mask(a, b, C == ComparisonGreater ? _CMP_GT_OQ : (C == ComparisonLess ? _CMP_LT_OQ : _CMP_EQ_OQ));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_AVX512 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm512_add_pd(a, b);
+					case ArithmeticMultiply: return _mm512_mul_pd(a, b);
+					case ArithmeticMin: return _mm512_min_pd(b, a);
+					default: return _mm512_max_pd(b, a);
+					}
+				}
+			};
+
+			/**
+			 * \brief Copy items satisfying the comparison to out with compress stores, keeping order. out may equal in.
+			 * \return Number of items kept
+			 */
+			template<Comparison C, class T>
+			MYLIST_TARGET_AVX512 int filter(const T * in, int length, T * out, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int count = 0;
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					typename V::type items = V::load(in + i);
+					int mask = V::template mask<C>(items, constant);
+					V::compress(out + count, mask, items);
+					count += popCount(static_cast<unsigned int>(mask));
+				}
+				for (; i < length; ++i)
+				{
+					out[count] = in[i];
+					count += compare<C>(in[i], value) ? 1 : 0;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Count items satisfying the comparison.
+			 * \return Number of matching items
+			 */
+			template<Comparison C, class T>
+			MYLIST_TARGET_AVX512 int count(const T * in, int length, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int count = 0;
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					count += popCount(static_cast<unsigned int>(V::template mask<C>(V::load(in + i), constant)));
+				}
+				for (; i < length; ++i)
+				{
+					count += compare<C>(in[i], value) ? 1 : 0;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Combine every item with a constant. out may equal in.
+			 */
+			template<Arithmetic A, class T>
+			MYLIST_TARGET_AVX512 void map(const T * in, int length, T * out, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					V::store(out + i, V::template combine<A>(V::load(in + i), constant));
+				}
+				for (; i < length; ++i)
+				{
+					out[i] = combine<A>(in[i], value);
+				}
+			}
+
+			/**
+			 * \brief Fold items into initial with an associative operation, one lane accumulator per column.
+			 * \return Reduced value
+			 */
+			template<Arithmetic A, class T>
+			MYLIST_TARGET_AVX512 T reduce(const T * in, int length, T initial)
+			{
+				typedef Vec<T> V;
+				T result = initial;
+				int i = 0;
+				if (length >= V::Lanes)
+				{
+					typename V::type accumulator = V::load(in);
+					for (i = V::Lanes; i + V::Lanes <= length; i += V::Lanes)
+					{
+						accumulator = V::template combine<A>(accumulator, V::load(in + i));
+					}
+
+					T lanes[V::Lanes];
+					V::store(lanes, accumulator);
+					for (int lane = 0; lane < V::Lanes; ++lane)
+					{
+						result = combine<A>(result, lanes[lane]);
+					}
+				}
+				for (; i < length; ++i)
+				{
+					result = combine<A>(result, in[i]);
+				}
+				return result;
+			}
+		}
+	}
+}
+
+#endif
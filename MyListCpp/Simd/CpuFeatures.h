@@ -0,0 +1,147 @@
+/**
+ *  Summary: Runtime detection of the vector instruction sets the kernels can use.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <atomic>
+#include "../Memory/Global.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define MYLIST_SIMD_X86
+#endif
+
+// AVX-512 intrinsics need VS2017 or a GCC/Clang that knows the avx512f target.
+#if defined(MYLIST_SIMD_X86) && ((defined(_MSC_VER) && _MSC_VER >= 1910) || (defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))))
+#define MYLIST_SIMD_AVX512
+#endif
+
+// GCC and Clang only accept intrinsics inside functions compiled for that target, MSVC accepts them anywhere.
+#if defined(__GNUC__)
+#define MYLIST_TARGET_SSE2 __attribute__((target("sse2")))
+#define MYLIST_TARGET_AVX2 __attribute__((target("avx2")))
+#define MYLIST_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define MYLIST_TARGET_SSE2
+#define MYLIST_TARGET_AVX2
+#define MYLIST_TARGET_AVX512
+#endif
+
+#if defined(MYLIST_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace MyList
+{
+	namespace Simd
+	{
+		/**
+		 * \brief Vector instruction sets, ordered from least to most capable.
+		 */
+		enum InstructionSet
+		{
+			InstructionSetScalar = 0,
+			InstructionSetSse2 = 1,
+			InstructionSetAvx2 = 2,
+			InstructionSetAvx512 = 3
+		};
+
+		/**
+		 * \brief Query the CPU (and OS register support) for the best usable instruction set.
+		 * \return InstructionSet
+		 */
+		inline InstructionSet detectInstructionSet()
+		{
+#if !defined(MYLIST_SIMD_X86)
+			return InstructionSetScalar;
+#elif defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			int maxLeaf = info[0];
+
+			__cpuid(info, 1);
+			bool sse2 = (info[3] & (1 << 26)) != 0;
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+			unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+			bool avx2 = false;
+			bool avx512 = false;
+			if (maxLeaf >= 7)
+			{
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0;
+				avx512 = (info[1] & (1 << 16)) != 0;
+			}
+
+#if defined(MYLIST_SIMD_AVX512)
+			// OS must save the ymm, zmm and opmask registers.
+			if (avx && avx512 && (xcr0 & 0xE6) == 0xE6) return InstructionSetAvx512;
+#endif
+			if (avx && avx2 && (xcr0 & 0x6) == 0x6) return InstructionSetAvx2;
+			if (sse2) return InstructionSetSse2;
+			return InstructionSetScalar;
+#else
+			__builtin_cpu_init();
+#if defined(MYLIST_SIMD_AVX512)
+			if (__builtin_cpu_supports("avx512f")) return InstructionSetAvx512;
+#endif
+			if (__builtin_cpu_supports("avx2")) return InstructionSetAvx2;
+			if (__builtin_cpu_supports("sse2")) return InstructionSetSse2;
+			return InstructionSetScalar;
+#endif
+		}
+
+		/**
+		 * \brief Instruction set currently used by the kernels, read by pool threads while another thread may limit it.
+		 */
+		struct ActiveInstructionSet
+		{
+			explicit ActiveInstructionSet(InstructionSet detected) : value(detected){}
+
+			std::atomic<int> value;
+		};
+
+		/**
+		 * \brief Get the active instruction set, detected on first use from any thread.
+		 * \return Reference to the active instruction set
+		 */
+		inline ActiveInstructionSet & activeInstructionSet()
+		{
+			return Memory::Global<ActiveInstructionSet>::get([](){ return new ActiveInstructionSet(detectInstructionSet()); });
+		}
+
+		/**
+		 * \brief Get instruction set the kernels dispatch to.
+		 * \return InstructionSet
+		 */
+		inline InstructionSet getInstructionSet()
+		{
+			// Only selects a kernel, every value is valid on its own, so nothing else needs ordering with it.
+			return static_cast<InstructionSet>(activeInstructionSet().value.load(std::memory_order_relaxed));
+		}
+
+		/**
+		 * \brief Restrict kernels to at most the given instruction set, e.g. InstructionSetScalar to verify results against the reference.
+		 * Kernels already running on other threads finish on the instruction set they started with.
+		 * \param limit Most capable instruction set allowed, capped to what the CPU supports.
+		 */
+		inline void limitInstructionSet(InstructionSet limit)
+		{
+			InstructionSet supported = detectInstructionSet();
+			activeInstructionSet().value.store(limit < supported ? limit : supported, std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Count set bits of a lane mask.
+		 * \param mask Lane mask
+		 * \return Number of set bits
+		 */
+		inline int popCount(unsigned int mask)
+		{
+			mask = mask - ((mask >> 1) & 0x55555555u);
+			mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+			return static_cast<int>((((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+		}
+	}
+}
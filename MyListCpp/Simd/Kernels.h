@@ -0,0 +1,217 @@
+/**
+ *  Summary: Filter, count, map and reduce over contiguous buffers. Dispatches to the best vector kernel the CPU supports
+ *  when the item type is int, float or double and the operation is one of the Simd operations, scalar otherwise.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <type_traits>
+
+#include "CpuFeatures.h"
+#include "Operations.h"
+#include "Sse2Kernels.h"
+#include "Avx2Kernels.h"
+#include "Avx512Kernels.h"
+
+namespace MyList
+{
+	namespace Simd
+	{
+		/**
+		 * \brief True for item types that have vector kernels.
+		 * \tparam T Item type
+		 */
+		template<class T>
+		struct IsVectorizable : std::integral_constant < bool,
+			std::is_same<T, int>::value || std::is_same<T, float>::value || std::is_same<T, double>::value > {};
+
+		/**
+		 * \brief Scalar reference implementations, the vector kernels must match them.
+		 */
+		namespace Reference
+		{
+			/**
+			 * \brief Copy items satisfying predicate to out, keeping order.
+			 * \param in Input items
+			 * \param length Number of input items
+			 * \param out Output buffer for at least length items, may equal in.
+			 * \param predicate Filter callable
+			 * \return Number of items kept
+			 */
+			template<class T, class TPredicate>
+			int filter(const T * in, int length, T * out, TPredicate & predicate)
+			{
+				int count = 0;
+				for (int i = 0; i < length; ++i)
+				{
+					if (predicate(in[i])) out[count++] = in[i];
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Count items satisfying predicate.
+			 * \return Number of matching items
+			 */
+			template<class T, class TPredicate>
+			int count(const T * in, int length, TPredicate & predicate)
+			{
+				int count = 0;
+				for (int i = 0; i < length; ++i)
+				{
+					if (predicate(in[i])) ++count;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Map every item into out.
+			 * \param out Output buffer for at least length items, may equal in.
+			 */
+			template<class T, class TDest, class TFunc>
+			void map(const T * in, int length, TDest * out, TFunc & func)
+			{
+				for (int i = 0; i < length; ++i)
+				{
+					out[i] = func(in[i]);
+				}
+			}
+
+			/**
+			 * \brief Fold items into initial from left to right.
+			 * \return Aggregate value
+			 */
+			template<class T, class TDest, class TFunc>
+			TDest reduce(const T * in, int length, TDest initial, TFunc & func)
+			{
+				TDest accumulator = initial;
+				for (int i = 0; i < length; ++i)
+				{
+					accumulator = func(accumulator, in[i]);
+				}
+				return accumulator;
+			}
+		}
+
+		/**
+		 * \brief Copy items satisfying predicate to out, keeping order.
+		 * \param in Input items
+		 * \param length Number of input items
+		 * \param out Output buffer for at least length items, may equal in.
+		 * \param predicate Filter callable
+		 * \return Number of items kept
+		 */
+		template<class T, class TPredicate>
+		int filter(const T * in, int length, T * out, TPredicate & predicate)
+		{
+			return Reference::filter(in, length, out, predicate);
+		}
+
+		/**
+		 * \brief Count items satisfying predicate.
+		 * \return Number of matching items
+		 */
+		template<class T, class TPredicate>
+		int count(const T * in, int length, TPredicate & predicate)
+		{
+			return Reference::count(in, length, predicate);
+		}
+
+		/**
+		 * \brief Map every item into out.
+		 * \param out Output buffer for at least length items, may equal in.
+		 */
+		template<class T, class TDest, class TFunc>
+		void map(const T * in, int length, TDest * out, TFunc & func)
+		{
+			Reference::map(in, length, out, func);
+		}
+
+		/**
+		 * \brief Fold items into initial from left to right.
+		 * \return Aggregate value
+		 */
+		template<class T, class TDest, class TFunc>
+		TDest reduce(const T * in, int length, TDest initial, TFunc & func)
+		{
+			return Reference::reduce(in, length, initial, func);
+		}
+
+		/**
+		 * \brief Vectorized filter for comparisons against a constant.
+		 */
+		template<class T, Comparison C>
+		typename std::enable_if<IsVectorizable<T>::value, int>::type filter(const T * in, int length, T * out, Compare<T, C> & predicate)
+		{
+			switch (getInstructionSet())
+			{
+#if defined(MYLIST_SIMD_AVX512)
+			case InstructionSetAvx512: return Avx512::filter<C>(in, length, out, predicate.value);
+#endif
+#if defined(MYLIST_SIMD_X86)
+			case InstructionSetAvx2: return Avx2::filter<C>(in, length, out, predicate.value);
+			case InstructionSetSse2: return Sse2::filter<C>(in, length, out, predicate.value);
+#endif
+			default: return Reference::filter(in, length, out, predicate);
+			}
+		}
+
+		/**
+		 * \brief Vectorized count for comparisons against a constant.
+		 */
+		template<class T, Comparison C>
+		typename std::enable_if<IsVectorizable<T>::value, int>::type count(const T * in, int length, Compare<T, C> & predicate)
+		{
+			switch (getInstructionSet())
+			{
+#if defined(MYLIST_SIMD_AVX512)
+			case InstructionSetAvx512: return Avx512::count<C>(in, length, predicate.value);
+#endif
+#if defined(MYLIST_SIMD_X86)
+			case InstructionSetAvx2: return Avx2::count<C>(in, length, predicate.value);
+			case InstructionSetSse2: return Sse2::count<C>(in, length, predicate.value);
+#endif
+			default: return Reference::count(in, length, predicate);
+			}
+		}
+
+		/**
+		 * \brief Vectorized map for arithmetic with a constant.
+		 */
+		template<class T, Arithmetic A>
+		typename std::enable_if<IsVectorizable<T>::value>::type map(const T * in, int length, T * out, Apply<T, A> & func)
+		{
+			switch (getInstructionSet())
+			{
+#if defined(MYLIST_SIMD_AVX512)
+			case InstructionSetAvx512: Avx512::map<A>(in, length, out, func.value); return;
+#endif
+#if defined(MYLIST_SIMD_X86)
+			case InstructionSetAvx2: Avx2::map<A>(in, length, out, func.value); return;
+			case InstructionSetSse2: Sse2::map<A>(in, length, out, func.value); return;
+#endif
+			default: Reference::map(in, length, out, func);
+			}
+		}
+
+		/**
+		 * \brief Vectorized reduction for associative operations.
+		 * Items are combined per lane first, so floating point results may differ from the left to right fold in the last bits.
+		 */
+		template<class T, Arithmetic A>
+		typename std::enable_if<IsVectorizable<T>::value, T>::type reduce(const T * in, int length, T initial, Reduce<T, A> & func)
+		{
+			switch (getInstructionSet())
+			{
+#if defined(MYLIST_SIMD_AVX512)
+			case InstructionSetAvx512: return Avx512::reduce<A>(in, length, initial);
+#endif
+#if defined(MYLIST_SIMD_X86)
+			case InstructionSetAvx2: return Avx2::reduce<A>(in, length, initial);
+			case InstructionSetSse2: return Sse2::reduce<A>(in, length, initial);
+#endif
+			default: return Reference::reduce(in, length, initial, func);
+			}
+		}
+	}
+}
@@ -0,0 +1,160 @@
+/**
+ *  Summary: Callables for filter, map and foldLeft whose operation is known to the vectorized kernels.
+ *  Their scalar operator() is the reference behaviour, so they can be used anywhere a lambda can.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+namespace MyList
+{
+	namespace Simd
+	{
+		/**
+		 * \brief Comparisons a predicate can make against a constant.
+		 */
+		enum Comparison
+		{
+			ComparisonGreater,
+			ComparisonLess,
+			ComparisonEqual
+		};
+
+		/**
+		 * \brief Associative arithmetic operations.
+		 */
+		enum Arithmetic
+		{
+			ArithmeticAdd,
+			ArithmeticMultiply,
+			ArithmeticMin,
+			ArithmeticMax
+		};
+
+		/**
+		 * \brief Scalar reference for a comparison.
+		 * \return a compared to b
+		 */
+		template<Comparison C, class T>
+		inline bool compare(T a, T b)
+		{
+			return C == ComparisonGreater ? a > b : (C == ComparisonLess ? a < b : a == b);
+		}
+
+		/**
+		 * \brief Scalar reference for an arithmetic operation.
+		 * \return a combined with b
+		 */
+		template<Arithmetic A, class T>
+		inline T combine(T a, T b)
+		{
+			switch (A)
+			{
+			case ArithmeticAdd: return a + b;
+			case ArithmeticMultiply: return a * b;
+			case ArithmeticMin: return b < a ? b : a;
+			default: return a < b ? b : a;
+			}
+		}
+
+		/**
+		 * \brief Predicate comparing every item against a constant.
+		 * \tparam T Item type
+		 * \tparam C Comparison
+		 */
+		template<class T, Comparison C>
+		class Compare
+		{
+		public:
+			/**
+			 * \brief Create predicate comparing against value.
+			 * \param value Constant to compare with
+			 */
+			explicit Compare(T value) : value(value){}
+
+			/**
+			 * \brief Compare item with the constant.
+			 * \return True if item satisfies comparison
+			 */
+			bool operator()(T x) const
+			{
+				return compare<C>(x, value);
+			}
+
+			/**
+			 * \brief Constant operand, read by the vector kernels.
+			 */
+			T value;
+		};
+
+		/**
+		 * \brief Map function combining every item with a constant.
+		 * \tparam T Item type
+		 * \tparam A Operation
+		 */
+		template<class T, Arithmetic A>
+		class Apply
+		{
+		public:
+			/**
+			 * \brief Create map function combining with value.
+			 * \param value Constant to combine with
+			 */
+			explicit Apply(T value) : value(value){}
+
+			/**
+			 * \brief Combine item with the constant.
+			 * \return Mapped item
+			 */
+			T operator()(T x) const
+			{
+				return combine<A>(x, value);
+			}
+
+			/**
+			 * \brief Constant operand, read by the vector kernels.
+			 */
+			T value;
+		};
+
+		/**
+		 * \brief Aggregate function for foldLeft, folds items with an associative operation.
+		 * \tparam T Item type
+		 * \tparam A Operation
+		 */
+		template<class T, Arithmetic A>
+		class Reduce
+		{
+		public:
+			T operator()(T accumulator, T x) const
+			{
+				return combine<A>(accumulator, x);
+			}
+		};
+
+		/**
+		 * \brief Aggregate function for foldLeft, counts items.
+		 */
+		class Count
+		{
+		public:
+			template<class TDest, class T>
+			TDest operator()(TDest accumulator, const T &) const
+			{
+				return accumulator + 1;
+			}
+		};
+
+		template<class T> using GreaterThan = Compare < T, ComparisonGreater > ;
+		template<class T> using LessThan = Compare < T, ComparisonLess > ;
+		template<class T> using EqualTo = Compare < T, ComparisonEqual > ;
+
+		template<class T> using Add = Apply < T, ArithmeticAdd > ;
+		template<class T> using Multiply = Apply < T, ArithmeticMultiply > ;
+
+		template<class T> using Sum = Reduce < T, ArithmeticAdd > ;
+		template<class T> using Product = Reduce < T, ArithmeticMultiply > ;
+		template<class T> using Min = Reduce < T, ArithmeticMin > ;
+		template<class T> using Max = Reduce < T, ArithmeticMax > ;
+	}
+}
@@ -0,0 +1,237 @@
+/**
+ *  Summary: SSE2 kernels for filter, count, map and reduce over int, float and double buffers.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+
+#include "CpuFeatures.h"
+#include "Operations.h"
+
+#if defined(MYLIST_SIMD_X86)
+#include <emmintrin.h>
+
+namespace MyList
+{
+	namespace Simd
+	{
+		namespace Sse2
+		{
+			/**
+			 * \brief 128 bit register operations per item type.
+			 * \tparam T Item type
+			 */
+			template<class T>
+			struct Vec;
+
+			template<>
+			struct Vec < int >
+			{
+				typedef __m128i type;
+				enum { Lanes = 4 };
+
+				static MYLIST_TARGET_SSE2 type load(const int * p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+				static MYLIST_TARGET_SSE2 void store(int * p, type v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+				static MYLIST_TARGET_SSE2 type set1(int value) { return _mm_set1_epi32(value); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_SSE2 int mask(type a, type b)
+				{
+					type result = C == ComparisonGreater ? _mm_cmpgt_epi32(a, b) : (C == ComparisonLess ? _mm_cmplt_epi32(a, b) : _mm_cmpeq_epi32(a, b));
+					return _mm_movemask_ps(_mm_castsi128_ps(result));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_SSE2 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm_add_epi32(a, b);
+					case ArithmeticMultiply:
+					{
+						// No 32 bit multiply before SSE4.1, multiply even and odd lanes as 64 bit and keep low halves.
+						type even = _mm_mul_epu32(a, b);
+						type odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+						return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+					}
+					case ArithmeticMin:
+					{
+						type greater = _mm_cmpgt_epi32(a, b);
+						return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+					}
+					default:
+					{
+						type greater = _mm_cmpgt_epi32(a, b);
+						return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+					}
+					}
+				}
+			};
+
+			template<>
+			struct Vec < float >
+			{
+				typedef __m128 type;
+				enum { Lanes = 4 };
+
+				static MYLIST_TARGET_SSE2 type load(const float * p) { return _mm_loadu_ps(p); }
+				static MYLIST_TARGET_SSE2 void store(float * p, type v) { _mm_storeu_ps(p, v); }
+				static MYLIST_TARGET_SSE2 type set1(float value) { return _mm_set1_ps(value); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_SSE2 int mask(type a, type b)
+				{
+					return _mm_movemask_ps(C == ComparisonGreater ? _mm_cmpgt_ps(a, b) : (C == ComparisonLess ? _mm_cmplt_ps(a, b) : _mm_cmpeq_ps(a, b)));
+				}
+
+				/**
+				 * \brief Min and max take b first, they return their second operand on NaN or ±0 ties as the scalar combine returns a.
+				 */
+				template<Arithmetic A>
+				static MYLIST_TARGET_SSE2 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm_add_ps(a, b);
+					case ArithmeticMultiply: return _mm_mul_ps(a, b);
+					case ArithmeticMin: return _mm_min_ps(b, a);
+					default: return _mm_max_ps(b, a);
+					}
+				}
+			};
+
+			template<>
+			struct Vec < double >
+			{
+				typedef __m128d type;
+				enum { Lanes = 2 };
+
+				static MYLIST_TARGET_SSE2 type load(const double * p) { return _mm_loadu_pd(p); }
+				static MYLIST_TARGET_SSE2 void store(double * p, type v) { _mm_storeu_pd(p, v); }
+				static MYLIST_TARGET_SSE2 type set1(double value) { return _mm_set1_pd(value); }
+
+				template<Comparison C>
+				static MYLIST_TARGET_SSE2 int mask(type a, type b)
+				{
+					return _mm_movemask_pd(C == ComparisonGreater ? _mm_cmpgt_pd(a, b) : (C == ComparisonLess ? _mm_cmplt_pd(a, b) : _mm_cmpeq_pd(a, b)));
+				}
+
+				template<Arithmetic A>
+				static MYLIST_TARGET_SSE2 type combine(type a, type b)
+				{
+					switch (A)
+					{
+					case ArithmeticAdd: return _mm_add_pd(a, b);
+					case ArithmeticMultiply: return _mm_mul_pd(a, b);
+					case ArithmeticMin: return _mm_min_pd(b, a);
+					default: return _mm_max_pd(b, a);
+					}
+				}
+			};
+
+			/**
+			 * \brief Copy items satisfying the comparison to out, keeping order. out may equal in.
+			 * Every lane is stored and the output position only advances for kept lanes, so there is no branch per item.
+			 * \return Number of items kept
+			 */
+			template<Comparison C, class T>
+			MYLIST_TARGET_SSE2 int filter(const T * in, int length, T * out, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int count = 0;
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					int mask = V::template mask<C>(V::load(in + i), constant);
+					for (int lane = 0; lane < V::Lanes; ++lane)
+					{
+						out[count] = in[i + lane];
+						count += (mask >> lane) & 1;
+					}
+				}
+				for (; i < length; ++i)
+				{
+					out[count] = in[i];
+					count += compare<C>(in[i], value) ? 1 : 0;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Count items satisfying the comparison.
+			 * \return Number of matching items
+			 */
+			template<Comparison C, class T>
+			MYLIST_TARGET_SSE2 int count(const T * in, int length, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int count = 0;
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					count += popCount(static_cast<unsigned int>(V::template mask<C>(V::load(in + i), constant)));
+				}
+				for (; i < length; ++i)
+				{
+					count += compare<C>(in[i], value) ? 1 : 0;
+				}
+				return count;
+			}
+
+			/**
+			 * \brief Combine every item with a constant. out may equal in.
+			 */
+			template<Arithmetic A, class T>
+			MYLIST_TARGET_SSE2 void map(const T * in, int length, T * out, T value)
+			{
+				typedef Vec<T> V;
+				const typename V::type constant = V::set1(value);
+				int i = 0;
+				for (; i + V::Lanes <= length; i += V::Lanes)
+				{
+					V::store(out + i, V::template combine<A>(V::load(in + i), constant));
+				}
+				for (; i < length; ++i)
+				{
+					out[i] = combine<A>(in[i], value);
+				}
+			}
+
+			/**
+			 * \brief Fold items into initial with an associative operation, one lane accumulator per column.
+			 * \return Reduced value
+			 */
+			template<Arithmetic A, class T>
+			MYLIST_TARGET_SSE2 T reduce(const T * in, int length, T initial)
+			{
+				typedef Vec<T> V;
+				T result = initial;
+				int i = 0;
+				if (length >= V::Lanes)
+				{
+					typename V::type accumulator = V::load(in);
+					for (i = V::Lanes; i + V::Lanes <= length; i += V::Lanes)
+					{
+						accumulator = V::template combine<A>(accumulator, V::load(in + i));
+					}
+
+					T lanes[V::Lanes];
+					V::store(lanes, accumulator);
+					for (int lane = 0; lane < V::Lanes; ++lane)
+					{
+						result = combine<A>(result, lanes[lane]);
+					}
+				}
+				for (; i < length; ++i)
+				{
+					result = combine<A>(result, in[i]);
+				}
+				return result;
+			}
+		}
+	}
+}
+
+#endif
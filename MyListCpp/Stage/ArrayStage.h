@@ -0,0 +1,209 @@
+/**
+ *  Summary: Pipeline source stage over a contiguous, shared buffer.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include "Capability.h"
+#include "../Enumerator/SizeHint.h"
+#include "../Exception/MyExceptions.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline source stage over a contiguous, shared buffer.
+		 * Exposes the unconsumed part of the buffer so terminal operations can run block kernels over it.
+		 * \tparam T Type of item
+		 */
+		template<class T>
+		class ArrayStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef T value_type;
+
+			/**
+			 * \brief Items are read in place
+			 */
+			typedef const T & reference;
+
+			/**
+			 * \brief Type of source stage at the start of the chain
+			 */
+			typedef ArrayStage origin_type;
+
+			/**
+			 * \brief Items lie in one buffer
+			 */
+			typedef ContiguousTag capability_type;
+
+			/**
+			 * \brief Create stage over the first length items of buffer.
+			 * \param buffer Shared buffer, kept alive by the stage.
+			 * \param length Number of items
+			 */
+			ArrayStage(const std::shared_ptr<T> & buffer, int length) : mIndex(-1), mBuffer(buffer), mLength(length){};
+
+			/**
+			 * \brief Create stage over items [begin, end) of buffer.
+			 * \param buffer Shared buffer, kept alive by the stage.
+			 * \param begin Index of first item
+			 * \param end Index one past last item
+			 */
+			ArrayStage(const std::shared_ptr<T> & buffer, int begin, int end) : mIndex(begin - 1), mBuffer(buffer), mLength(end){};
+
+			/**
+			 * \brief Move to stage to next position
+			 * \return False if stage at end of list, Otherwise True
+			 */
+			bool moveNext()
+			{
+				if ((mIndex + 1) >= mLength)
+				{
+					return false;
+				}
+				mIndex++;
+				return true;
+			}
+
+			/**
+			 * \brief Get value at current position.
+			 * \return Reference into the buffer if stage is valid, otherwise throw exception.
+			 */
+			const T & getCurrent()
+			{
+				if (mIndex < 0) throw Exception::InvalidEnumerator();
+				return mBuffer.get()[mIndex];
+			}
+
+			/**
+			 * \brief Push every remaining item to sink as a plain indexed loop.
+			 * \param sink Callable taking T, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				const T * data = mBuffer.get();
+				const int length = mLength;
+				for (int i = mIndex + 1; i < length; ++i)
+				{
+					if (!sink(data[i]))
+					{
+						mIndex = i;
+						return false;
+					}
+				}
+				if (mIndex < length - 1) mIndex = length - 1;
+				return true;
+			}
+
+			/**
+			 * \brief Get number of items left.
+			 * \return Exact SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return Enumerator::SizeHint::exact(getRemaining());
+			}
+
+			/**
+			 * \brief Get source stage at the start of the chain.
+			 * \return Reference to this
+			 */
+			ArrayStage & getOrigin()
+			{
+				return *this;
+			}
+
+			/**
+			 * \brief Prepare to split the unconsumed items between threads.
+			 * \return Number of split units, one per item.
+			 */
+			int split() const
+			{
+				return getRemaining();
+			}
+
+			/**
+			 * \brief Get smallest number of split units worth running as a task.
+			 * \return Grain size
+			 */
+			int getSplitGrain() const
+			{
+				return MIN_SPLIT_ITEMS;
+			}
+
+			/**
+			 * \brief Restrict a copy of the split stage to units [begin, end).
+			 * \param begin First unit
+			 * \param end One past last unit
+			 */
+			void setSplitRange(int begin, int end)
+			{
+				setRange(begin, end);
+			}
+
+			/**
+			 * \brief Get a remaining item without moving the stage.
+			 * \param i Index from the first item not consumed yet, less than getRemaining()
+			 * \return Reference into the buffer
+			 */
+			const T & at(int i) const
+			{
+				return mBuffer.get()[mIndex + 1 + i];
+			}
+
+			/**
+			 * \brief Keep only remaining items [begin, end).
+			 * \param begin Index of first item, from the first item not consumed yet
+			 * \param end Index one past last item
+			 */
+			void setRange(int begin, int end)
+			{
+				int first = mIndex + 1;
+				mIndex = first + begin - 1;
+				mLength = first + end;
+			}
+
+			/**
+			 * \brief Get pointer to the first item not consumed yet.
+			 * \return Pointer into the shared buffer
+			 */
+			const T * getData() const
+			{
+				return mBuffer.get() + mIndex + 1;
+			}
+
+			/**
+			 * \brief Get number of items not consumed yet.
+			 * \return Remaining length
+			 */
+			int getRemaining() const
+			{
+				return mLength - (mIndex + 1);
+			}
+
+			/**
+			 * \brief Consume items without reading them, e.g. after a block kernel processed them.
+			 * \param count Number of items, at most getRemaining()
+			 */
+			void skip(int count)
+			{
+				mIndex += count;
+			}
+
+		private:
+			int mIndex;
+
+			std::shared_ptr<T> mBuffer;
+
+			int mLength;
+		};
+	}
+}
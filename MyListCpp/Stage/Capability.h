@@ -0,0 +1,56 @@
+/**
+ *  Summary: Capability tiers of pipeline stages, from forward only to contiguous. Every stage names its tier as
+ *  capability_type, so a pipeline knows at compile time whether it can be indexed, sliced or reversed without copying.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <type_traits>
+
+#define MIN_SPLIT_ITEMS 4096
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Items can only be visited once, in order (moveNext, getCurrent, forEach).
+		 */
+		struct ForwardTag {};
+
+		/**
+		 * \brief Forward, and the number of items left is known exactly before visiting them (getSizeHint).
+		 */
+		struct SizedTag : ForwardTag {};
+
+		/**
+		 * \brief Sized, and any remaining item can be read in O(1) without moving the stage.
+		 * Adds getRemaining(), at(i) for the i-th remaining item and setRange(begin, end) to keep remaining items [begin, end).
+		 */
+		struct RandomAccessTag : SizedTag {};
+
+		/**
+		 * \brief Random access, and the remaining items lie in one buffer (getData), so block kernels can read them.
+		 */
+		struct ContiguousTag : RandomAccessTag {};
+
+		/**
+		 * \brief Check whether a stage has at least the capabilities of a tier.
+		 * \tparam TStage Stage type
+		 * \tparam TTag Tier
+		 */
+		template<class TStage, class TTag>
+		struct HasCapability : std::is_base_of<TTag, typename TStage::capability_type> {};
+
+		/**
+		 * \brief Tier of a stage computing its items from those of its input, one for one.
+		 * The items no longer lie in a buffer, everything else is kept.
+		 * \tparam TTag Tier of the input stage
+		 */
+		template<class TTag>
+		struct MappedCapability
+		{
+			typedef typename std::conditional<std::is_base_of<RandomAccessTag, TTag>::value, RandomAccessTag, TTag>::type type;
+		};
+	}
+}
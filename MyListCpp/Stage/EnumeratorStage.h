@@ -0,0 +1,114 @@
+/**
+ *  Summary: Pipeline source stage reading a type-erased enumerator, so stages can be reused behind IEnumerable.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <memory>
+#include "Capability.h"
+#include "../Enumerator/IEnumerator.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline source stage reading a type-erased enumerator.
+		 * Copies clone the enumerator, so a StageEnumerator over this stage clones like any other enumerator.
+		 * \tparam T Type of item
+		 */
+		template<class T>
+		class EnumeratorStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef T value_type;
+
+			/**
+			 * \brief Items are read through IEnumerator::getCurrent
+			 */
+			typedef const T & reference;
+
+			/**
+			 * \brief Type of source stage at the start of the chain
+			 */
+			typedef EnumeratorStage origin_type;
+
+			/**
+			 * \brief Enumerators are read one item after the other
+			 */
+			typedef ForwardTag capability_type;
+
+			/**
+			 * \brief Create stage reading an enumerator.
+			 * \param enumerator Enumerator, owned by the stage from now on.
+			 */
+			explicit EnumeratorStage(const std::shared_ptr<Enumerator::IEnumerator<T> > & enumerator) : mEnumerator(enumerator){ }
+
+			/**
+			 * \brief Copy constructor, clones the enumerator and its position.
+			 * \param other EnumeratorStage
+			 */
+			EnumeratorStage(const EnumeratorStage & other) : mEnumerator(other.mEnumerator->clone()){ }
+
+			bool moveNext()
+			{
+				return mEnumerator->moveNext();
+			}
+
+			const T & getCurrent()
+			{
+				return mEnumerator->getCurrent();
+			}
+
+			/**
+			 * \brief Push every remaining item to sink.
+			 * \param sink Callable taking T, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				while (mEnumerator->moveNext())
+				{
+					if (!sink(mEnumerator->getCurrent())) return false;
+				}
+				return true;
+			}
+
+			/**
+			 * \brief Get hint of the enumerator.
+			 * \return SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return mEnumerator->getSizeHint();
+			}
+
+			/**
+			 * \brief Get source stage at the start of the chain.
+			 * \return Reference to this
+			 */
+			EnumeratorStage & getOrigin()
+			{
+				return *this;
+			}
+
+			/**
+			 * \brief Not splittable, an enumerator can only be read in order.
+			 */
+			int split()
+			{
+				static_assert(sizeof(T) == 0, "Enumerators cannot be split, materialize the list to run it in parallel");
+				return 0;
+			}
+
+		private:
+			EnumeratorStage & operator=(const EnumeratorStage & other);
+
+			std::shared_ptr<Enumerator::IEnumerator<T> > mEnumerator;
+		};
+	}
+}
@@ -0,0 +1,127 @@
+/**
+ *  Summary: Pipeline stage that only passes on items of its input stage that satisfy a predicate.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <utility>
+#include "Capability.h"
+#include "../Enumerator/SizeHint.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline stage that only passes on items of its input stage that satisfy a predicate.
+		 * \tparam TInput Input stage type
+		 * \tparam TPredicate Type of predicate callable, stored by value.
+		 */
+		template<class TInput, class TPredicate>
+		class FilterStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef typename TInput::value_type value_type;
+
+			/**
+			 * \brief Items are handed on as the input hands them out
+			 */
+			typedef typename TInput::reference reference;
+
+			/**
+			 * \brief Type of source stage at the start of the chain
+			 */
+			typedef typename TInput::origin_type origin_type;
+
+			/**
+			 * \brief How many items pass is only known after visiting them
+			 */
+			typedef ForwardTag capability_type;
+
+			/**
+			 * \brief Instantiates a new FilterStage from an input stage and predicate
+			 * \param input Input stage, copied.
+			 * \param predicate Filter callable, copied.
+			 */
+			FilterStage(const TInput & input, const TPredicate & predicate) : mInput(input), mPredicate(predicate){ }
+
+			/**
+			 * \brief Move stage to next position in collection that satisfies the filter.
+			 * \return False if stage at end of collection, True otherwise.
+			 */
+			bool moveNext()
+			{
+				bool hasValue = false;
+				while ((hasValue = mInput.moveNext()) && !mPredicate(mInput.getCurrent()));
+				return hasValue;
+			}
+
+			/**
+			 * \brief Gets the current value pointed to.
+			 * \return Value
+			 */
+			reference getCurrent()
+			{
+				return mInput.getCurrent();
+			}
+
+			/**
+			 * \brief Push every remaining item that satisfies the filter to sink.
+			 * \param sink Callable taking value_type, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				return mInput.forEach([this, &sink](reference value){ return !mPredicate(value) || sink(std::forward<reference>(value)); });
+			}
+
+			/**
+			 * \brief Filter may drop any item, so the input hint becomes an upper bound.
+			 * \return SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return mInput.getSizeHint().atMost();
+			}
+
+			/**
+			 * \brief Get source stage at the start of the chain.
+			 * \return Reference to source stage
+			 */
+			origin_type & getOrigin()
+			{
+				return mInput.getOrigin();
+			}
+
+			/**
+			 * \brief Get input stage.
+			 * \return Reference to input stage
+			 */
+			TInput & getInput()
+			{
+				return mInput;
+			}
+
+			/**
+			 * \brief Get predicate callable.
+			 * \return Reference to callable
+			 */
+			TPredicate & getPredicate()
+			{
+				return mPredicate;
+			}
+
+		private:
+			TInput mInput;
+
+			/**
+			 * \brief Predicate filter callable
+			 */
+			TPredicate mPredicate;
+		};
+	}
+}
@@ -0,0 +1,71 @@
+/**
+ *  Summary: Terminal fold over a pipeline stage. Chains reading straight from a buffer with a Simd aggregate
+ *  are folded by a block kernel, every other chain is pushed item by item through forEach.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <utility>
+#include "ArrayStage.h"
+#include "FilterStage.h"
+#include "../Simd/Kernels.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Fold every remaining item of a stage into an accumulator.
+		 * The accumulator is moved into func and back, so folds building strings or containers can append in place.
+		 * \param stage Stage to drain
+		 * \param initial Initial value of accumulator
+		 * \param func Aggregate callable
+		 * \return Aggregate value
+		 */
+		template<class TStage, class TDest, class TFunc>
+		TDest fold(TStage & stage, TDest initial, TFunc & func)
+		{
+			TDest accumulator = std::move(initial);
+			typedef typename TStage::reference reference;
+			stage.forEach([&accumulator, &func](reference value){
+				accumulator = func(std::move(accumulator), std::forward<reference>(value));
+				return true;
+			});
+			return accumulator;
+		}
+
+		/**
+		 * \brief Reduce a buffer with a vector kernel.
+		 */
+		template<class T, Simd::Arithmetic A>
+		T fold(ArrayStage<T> & stage, T initial, Simd::Reduce<T, A> & func)
+		{
+			T result = Simd::reduce(stage.getData(), stage.getRemaining(), initial, func);
+			stage.skip(stage.getRemaining());
+			return result;
+		}
+
+		/**
+		 * \brief Count a buffer without reading it.
+		 */
+		template<class T, class TDest>
+		TDest fold(ArrayStage<T> & stage, TDest initial, Simd::Count &)
+		{
+			TDest result = initial + stage.getRemaining();
+			stage.skip(stage.getRemaining());
+			return result;
+		}
+
+		/**
+		 * \brief Count the items of a buffer satisfying a predicate with a vector kernel.
+		 */
+		template<class T, class TPredicate, class TDest>
+		TDest fold(FilterStage<ArrayStage<T>, TPredicate> & stage, TDest initial, Simd::Count &)
+		{
+			ArrayStage<T> & input = stage.getInput();
+			TDest result = initial + Simd::count(input.getData(), input.getRemaining(), stage.getPredicate());
+			input.skip(input.getRemaining());
+			return result;
+		}
+	}
+}
@@ -0,0 +1,166 @@
+/**
+ *  Summary: Pipeline stage that applies a mapping function to every item of its input stage.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <utility>
+#include "Capability.h"
+#include "../Enumerator/SizeHint.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline stage that applies a mapping function to every item of its input stage.
+		 * Held by value so the whole chain is known at compile time and can be inlined.
+		 * \tparam TInput Input stage type
+		 * \tparam TOut Destination type
+		 * \tparam TFunc Type of mapping callable, stored by value.
+		 */
+		template<class TInput, class TOut, class TFunc>
+		class MapStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef TOut value_type;
+
+			/**
+			 * \brief Source item type
+			 */
+			typedef typename TInput::value_type source_type;
+
+			/**
+			 * \brief Mapped items are computed, they are handed on by value and moved from there
+			 */
+			typedef TOut reference;
+
+			/**
+			 * \brief Type of source stage at the start of the chain
+			 */
+			typedef typename TInput::origin_type origin_type;
+
+			/**
+			 * \brief Tier of the input, except mapped items are never contiguous
+			 */
+			typedef typename MappedCapability<typename TInput::capability_type>::type capability_type;
+
+			/**
+			 * \brief Instantiates new MapStage from an input stage and map function.
+			 * \param input Input stage, copied.
+			 * \param func Mapping callable, copied.
+			 */
+			MapStage(const TInput & input, const TFunc & func) : mInput(input), mFunc(func){ }
+
+			/**
+			 * \brief Move stage to next position.
+			 * \return False if at end of list, True otherwise
+			 */
+			bool moveNext()
+			{
+				return mInput.moveNext();
+			}
+
+			/**
+			 * \brief Apply map function to current value
+			 * \return Mapped value
+			 */
+			TOut getCurrent()
+			{
+				return mFunc(mInput.getCurrent());
+			}
+
+			/**
+			 * \brief Push every remaining mapped item to sink.
+			 * \param sink Callable taking TOut, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				typedef typename TInput::reference input_reference;
+				return mInput.forEach([this, &sink](input_reference value){ return sink(mFunc(std::forward<input_reference>(value))); });
+			}
+
+			/**
+			 * \brief Mapping keeps every item, pass the input hint through.
+			 * \return SizeHint of input
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return mInput.getSizeHint();
+			}
+
+			/**
+			 * \brief Get number of items left, random access inputs only.
+			 * \return Remaining length
+			 */
+			int getRemaining() const
+			{
+				return mInput.getRemaining();
+			}
+
+			/**
+			 * \brief Map a remaining item of a random access input without moving the stage.
+			 * The map callable is called every time, so it must be callable on a const stage.
+			 * \param i Index from the first item not consumed yet
+			 * \return Mapped item
+			 */
+			TOut at(int i) const
+			{
+				return mFunc(mInput.at(i));
+			}
+
+			/**
+			 * \brief Keep only remaining items [begin, end) of a random access input.
+			 * \param begin Index of first item
+			 * \param end Index one past last item
+			 */
+			void setRange(int begin, int end)
+			{
+				mInput.setRange(begin, end);
+			}
+
+			/**
+			 * \brief Get source stage at the start of the chain.
+			 * \return Reference to source stage
+			 */
+			origin_type & getOrigin()
+			{
+				return mInput.getOrigin();
+			}
+
+			/**
+			 * \brief Get input stage.
+			 * \return Reference to input stage
+			 */
+			TInput & getInput()
+			{
+				return mInput;
+			}
+
+			/**
+			 * \brief Get map callable.
+			 * \return Reference to callable
+			 */
+			TFunc & getFunc()
+			{
+				return mFunc;
+			}
+
+		private:
+			/**
+			 * \brief Stage to apply map to
+			 */
+			TInput mInput;
+
+			/**
+			 * \brief Map callable.
+			 */
+			TFunc mFunc;
+		};
+	}
+}
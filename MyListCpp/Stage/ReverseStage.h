@@ -0,0 +1,191 @@
+/**
+ *  Summary: Pipeline stage reading the remaining items of a random access input back to front, without copying them.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include "Capability.h"
+#include "../Enumerator/SizeHint.h"
+#include "../Exception/MyExceptions.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline stage reading the remaining items of a random access input back to front.
+		 * Reads through the input's at(i), so nothing is copied. Indexes its own items, which makes it the
+		 * splittable source of any stage built on top of it.
+		 * \tparam TInput Input stage type, random access.
+		 */
+		template<class TInput>
+		class ReverseStage
+		{
+			static_assert(HasCapability<TInput, RandomAccessTag>::value, "Only random access stages can be reversed without copying");
+
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef typename TInput::value_type value_type;
+
+			/**
+			 * \brief Items are handed on as the input hands them out
+			 */
+			typedef typename TInput::reference reference;
+
+			/**
+			 * \brief The stage splits by index itself
+			 */
+			typedef ReverseStage origin_type;
+
+			/**
+			 * \brief Items are read by index, but back to front
+			 */
+			typedef RandomAccessTag capability_type;
+
+			/**
+			 * \brief Instantiates new ReverseStage over the remaining items of input.
+			 * \param input Input stage, copied. It is never moved, only read by index.
+			 */
+			explicit ReverseStage(const TInput & input) : mInput(input), mCount(input.getRemaining()), mIndex(-1), mLength(mCount){ }
+
+			/**
+			 * \brief Move stage to next position
+			 * \return False if stage at end of list, Otherwise True
+			 */
+			bool moveNext()
+			{
+				if ((mIndex + 1) >= mLength)
+				{
+					return false;
+				}
+				mIndex++;
+				return true;
+			}
+
+			/**
+			 * \brief Get value at current position.
+			 * \return Value if stage is valid, otherwise throw exception.
+			 */
+			reference getCurrent()
+			{
+				if (mIndex < 0) throw Exception::InvalidEnumerator();
+				return mInput.at(mCount - 1 - mIndex);
+			}
+
+			/**
+			 * \brief Push every remaining item to sink as a plain indexed loop.
+			 * \param sink Callable taking value_type, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				const int length = mLength;
+				for (int i = mIndex + 1; i < length; ++i)
+				{
+					if (!sink(mInput.at(mCount - 1 - i)))
+					{
+						mIndex = i;
+						return false;
+					}
+				}
+				if (mIndex < length - 1) mIndex = length - 1;
+				return true;
+			}
+
+			/**
+			 * \brief Get number of items left.
+			 * \return Exact SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return Enumerator::SizeHint::exact(getRemaining());
+			}
+
+			/**
+			 * \brief Get number of items not consumed yet.
+			 * \return Remaining length
+			 */
+			int getRemaining() const
+			{
+				return mLength - (mIndex + 1);
+			}
+
+			/**
+			 * \brief Get a remaining item without moving the stage.
+			 * \param i Index from the first item not consumed yet, less than getRemaining()
+			 * \return Item
+			 */
+			reference at(int i) const
+			{
+				return mInput.at(mCount - 1 - (mIndex + 1 + i));
+			}
+
+			/**
+			 * \brief Keep only remaining items [begin, end).
+			 * \param begin Index of first item, from the first item not consumed yet
+			 * \param end Index one past last item
+			 */
+			void setRange(int begin, int end)
+			{
+				int first = mIndex + 1;
+				mIndex = first + begin - 1;
+				mLength = first + end;
+			}
+
+			/**
+			 * \brief Get source stage at the start of the chain.
+			 * \return Reference to this
+			 */
+			ReverseStage & getOrigin()
+			{
+				return *this;
+			}
+
+			/**
+			 * \brief Prepare to split the unconsumed items between threads.
+			 * \return Number of split units, one per item.
+			 */
+			int split() const
+			{
+				return getRemaining();
+			}
+
+			/**
+			 * \brief Get smallest number of split units worth running as a task.
+			 * \return Grain size
+			 */
+			int getSplitGrain() const
+			{
+				return MIN_SPLIT_ITEMS;
+			}
+
+			/**
+			 * \brief Restrict a copy of the split stage to units [begin, end).
+			 * \param begin First unit
+			 * \param end One past last unit
+			 */
+			void setSplitRange(int begin, int end)
+			{
+				setRange(begin, end);
+			}
+
+		private:
+			/**
+			 * \brief Input stage, left at its initial position.
+			 */
+			TInput mInput;
+
+			/**
+			 * \brief Number of items of the input, item i of this stage is item mCount - 1 - i of the input.
+			 */
+			int mCount;
+
+			int mIndex;
+
+			int mLength;
+		};
+	}
+}
@@ -0,0 +1,172 @@
+/**
+ *  Summary: Pipeline stage that drops the first items of its input stage and passes on the rest.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <type_traits>
+#include "Capability.h"
+#include "../Enumerator/SizeHint.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline stage that drops the first count items of its input stage.
+		 * Random access inputs jump past them in O(1), others are moved past them without reading the dropped items,
+		 * so map stages upstream never evaluate them. Which items pass depends on position, so the stage is its own
+		 * origin and cannot run in parallel.
+		 * \tparam TInput Input stage type
+		 */
+		template<class TInput>
+		class SkipStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef typename TInput::value_type value_type;
+
+			/**
+			 * \brief Items are handed on as the input hands them out
+			 */
+			typedef typename TInput::reference reference;
+
+			/**
+			 * \brief Positional, the chain cannot be split below this stage
+			 */
+			typedef SkipStage origin_type;
+
+			/**
+			 * \brief Tier of the input, items of a random access input are still read by index
+			 */
+			typedef typename MappedCapability<typename TInput::capability_type>::type capability_type;
+
+			/**
+			 * \brief Instantiates a new SkipStage from an input stage.
+			 * \param input Input stage, copied.
+			 * \param count Number of items to drop, negative counts as 0.
+			 */
+			SkipStage(const TInput & input, int count) : mInput(input), mSkip(count > 0 ? count : 0){ }
+
+			/**
+			 * \brief Move stage to next position, dropping items first if that has not happened yet.
+			 * \return False if at end of list, True otherwise
+			 */
+			bool moveNext()
+			{
+				skipAhead();
+				return mInput.moveNext();
+			}
+
+			/**
+			 * \brief Gets the current value pointed to.
+			 * \return Value
+			 */
+			reference getCurrent()
+			{
+				return mInput.getCurrent();
+			}
+
+			/**
+			 * \brief Push every item after the dropped ones to sink.
+			 * \param sink Callable taking value_type, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				skipAhead();
+				return mInput.forEach(sink);
+			}
+
+			/**
+			 * \brief Input hint less the items still to drop.
+			 * \return SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return mInput.getSizeHint().drop(mSkip);
+			}
+
+			/**
+			 * \brief Get number of items left, random access inputs only.
+			 * \return Remaining length
+			 */
+			int getRemaining() const
+			{
+				const int remaining = mInput.getRemaining() - mSkip;
+				return remaining > 0 ? remaining : 0;
+			}
+
+			/**
+			 * \brief Get a remaining item of a random access input without moving the stage.
+			 * \param i Index from the first item not consumed yet, less than getRemaining()
+			 * \return Item
+			 */
+			reference at(int i) const
+			{
+				return mInput.at(mSkip + i);
+			}
+
+			/**
+			 * \brief Keep only remaining items [begin, end) of a random access input.
+			 * \param begin Index of first item
+			 * \param end Index one past last item, at most getRemaining()
+			 */
+			void setRange(int begin, int end)
+			{
+				mInput.setRange(mSkip + begin, mSkip + end);
+				mSkip = 0;
+			}
+
+			/**
+			 * \brief Get source stage, this stage as splitting the input would change which items pass.
+			 * \return Reference to this
+			 */
+			SkipStage & getOrigin()
+			{
+				return *this;
+			}
+
+			/**
+			 * \brief Not splittable, parallel() on a chain holding a skip does not compile.
+			 */
+			int split()
+			{
+				static_assert(sizeof(TInput) == 0, "skip() depends on position, run it after the parallel part of the chain");
+				return 0;
+			}
+
+		private:
+			/**
+			 * \brief Drop the items once, on first use.
+			 */
+			void skipAhead()
+			{
+				if (mSkip == 0) return;
+				skipAhead(typename HasCapability<TInput, RandomAccessTag>::type());
+				mSkip = 0;
+			}
+
+			void skipAhead(std::true_type)
+			{
+				const int remaining = mInput.getRemaining();
+				mInput.setRange(mSkip < remaining ? mSkip : remaining, remaining);
+			}
+
+			void skipAhead(std::false_type)
+			{
+				while (mSkip > 0 && mInput.moveNext()) --mSkip;
+			}
+
+			TInput mInput;
+
+			/**
+			 * \brief Number of items still to drop.
+			 */
+			int mSkip;
+		};
+	}
+}
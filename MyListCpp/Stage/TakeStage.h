@@ -0,0 +1,166 @@
+/**
+ *  Summary: Pipeline stage that passes on the first items of its input stage and then stops pulling it.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <utility>
+#include "Capability.h"
+#include "../Enumerator/SizeHint.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline stage that passes on the first count items of its input stage.
+		 * Once count items have passed the input is never moved again, so upstream stages stop evaluating.
+		 * Which items pass depends on position, so the stage is its own origin and cannot run in parallel.
+		 * \tparam TInput Input stage type
+		 */
+		template<class TInput>
+		class TakeStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef typename TInput::value_type value_type;
+
+			/**
+			 * \brief Items are handed on as the input hands them out
+			 */
+			typedef typename TInput::reference reference;
+
+			/**
+			 * \brief Positional, the chain cannot be split below this stage
+			 */
+			typedef TakeStage origin_type;
+
+			/**
+			 * \brief Tier of the input, items of a random access input are still read by index
+			 */
+			typedef typename MappedCapability<typename TInput::capability_type>::type capability_type;
+
+			/**
+			 * \brief Instantiates a new TakeStage from an input stage.
+			 * \param input Input stage, copied.
+			 * \param count Maximum number of items to pass on, negative counts as 0.
+			 */
+			TakeStage(const TInput & input, int count) : mInput(input), mLeft(count > 0 ? count : 0){ }
+
+			/**
+			 * \brief Move stage to next position, without touching the input once count items have passed.
+			 * \return False if at end of list, True otherwise
+			 */
+			bool moveNext()
+			{
+				if (mLeft <= 0) return false;
+				if (!mInput.moveNext())
+				{
+					mLeft = 0;
+					return false;
+				}
+				--mLeft;
+				return true;
+			}
+
+			/**
+			 * \brief Gets the current value pointed to.
+			 * \return Value
+			 */
+			reference getCurrent()
+			{
+				return mInput.getCurrent();
+			}
+
+			/**
+			 * \brief Push up to the remaining count of items to sink, then stop the input.
+			 * \param sink Callable taking value_type, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				if (mLeft <= 0) return true;
+				bool stopped = false;
+				mInput.forEach([this, &sink, &stopped](reference value){
+					--mLeft;
+					if (!sink(std::forward<reference>(value)))
+					{
+						stopped = true;
+						return false;
+					}
+					return mLeft > 0;
+				});
+				return !stopped;
+			}
+
+			/**
+			 * \brief Input hint capped at the remaining count.
+			 * \return SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return mInput.getSizeHint().limit(mLeft);
+			}
+
+			/**
+			 * \brief Get number of items left, random access inputs only.
+			 * \return Remaining length
+			 */
+			int getRemaining() const
+			{
+				const int remaining = mInput.getRemaining();
+				return remaining < mLeft ? remaining : mLeft;
+			}
+
+			/**
+			 * \brief Get a remaining item of a random access input without moving the stage.
+			 * \param i Index from the first item not consumed yet, less than getRemaining()
+			 * \return Item
+			 */
+			reference at(int i) const
+			{
+				return mInput.at(i);
+			}
+
+			/**
+			 * \brief Keep only remaining items [begin, end) of a random access input.
+			 * \param begin Index of first item
+			 * \param end Index one past last item, at most getRemaining()
+			 */
+			void setRange(int begin, int end)
+			{
+				mInput.setRange(begin, end);
+				mLeft = end - begin;
+			}
+
+			/**
+			 * \brief Get source stage, this stage as splitting the input would change which items pass.
+			 * \return Reference to this
+			 */
+			TakeStage & getOrigin()
+			{
+				return *this;
+			}
+
+			/**
+			 * \brief Not splittable, parallel() on a chain holding a take does not compile.
+			 */
+			int split()
+			{
+				static_assert(sizeof(TInput) == 0, "take() depends on position, run it after the parallel part of the chain");
+				return 0;
+			}
+
+		private:
+			TInput mInput;
+
+			/**
+			 * \brief Number of items still to pass on.
+			 */
+			int mLeft;
+		};
+	}
+}
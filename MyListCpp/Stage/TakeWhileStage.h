@@ -0,0 +1,138 @@
+/**
+ *  Summary: Pipeline stage that passes on items of its input stage until one fails a predicate, then stops pulling it.
+ *  Author: Brian Cullen (brianshan@gmail.com)
+ */
+
+#pragma once
+#include <utility>
+#include "Capability.h"
+#include "../Enumerator/SizeHint.h"
+
+namespace MyList
+{
+	namespace Stage
+	{
+		/**
+		 * \brief Pipeline stage that passes on items of its input stage until one fails a predicate.
+		 * The input is never moved past the first failing item. Which items pass depends on position,
+		 * so the stage is its own origin and cannot run in parallel.
+		 * \tparam TInput Input stage type
+		 * \tparam TPredicate Type of predicate callable, stored by value.
+		 */
+		template<class TInput, class TPredicate>
+		class TakeWhileStage
+		{
+		public:
+			/**
+			 * \brief Type of items produced by this stage
+			 */
+			typedef typename TInput::value_type value_type;
+
+			/**
+			 * \brief Items are handed on as the input hands them out
+			 */
+			typedef typename TInput::reference reference;
+
+			/**
+			 * \brief Positional, the chain cannot be split below this stage
+			 */
+			typedef TakeWhileStage origin_type;
+
+			/**
+			 * \brief Where the items end is only known after visiting them
+			 */
+			typedef ForwardTag capability_type;
+
+			/**
+			 * \brief Instantiates a new TakeWhileStage from an input stage and predicate
+			 * \param input Input stage, copied.
+			 * \param predicate Callable taking value_type, copied.
+			 */
+			TakeWhileStage(const TInput & input, const TPredicate & predicate) : mInput(input), mPredicate(predicate), mDone(false){ }
+
+			/**
+			 * \brief Move stage to next position while items satisfy the predicate.
+			 * \return False if at end of list or the next item fails, True otherwise
+			 */
+			bool moveNext()
+			{
+				if (mDone) return false;
+				if (mInput.moveNext() && mPredicate(mInput.getCurrent())) return true;
+				mDone = true;
+				return false;
+			}
+
+			/**
+			 * \brief Gets the current value pointed to.
+			 * \return Value
+			 */
+			reference getCurrent()
+			{
+				return mInput.getCurrent();
+			}
+
+			/**
+			 * \brief Push items to sink until one fails the predicate.
+			 * \param sink Callable taking value_type, returns False to stop.
+			 * \return False if sink stopped early, True otherwise.
+			 */
+			template<class TSink>
+			bool forEach(TSink sink)
+			{
+				if (mDone) return true;
+				bool stopped = false;
+				mInput.forEach([this, &sink, &stopped](reference value){
+					if (!mPredicate(value))
+					{
+						mDone = true;
+						return false;
+					}
+					if (!sink(std::forward<reference>(value)))
+					{
+						stopped = true;
+						return false;
+					}
+					return true;
+				});
+				return !stopped;
+			}
+
+			/**
+			 * \brief Any item may fail, so the input hint becomes an upper bound.
+			 * \return SizeHint
+			 */
+			Enumerator::SizeHint getSizeHint() const
+			{
+				return mDone ? Enumerator::SizeHint::exact(0) : mInput.getSizeHint().atMost();
+			}
+
+			/**
+			 * \brief Get source stage, this stage as splitting the input would change which items pass.
+			 * \return Reference to this
+			 */
+			TakeWhileStage & getOrigin()
+			{
+				return *this;
+			}
+
+			/**
+			 * \brief Not splittable, parallel() on a chain holding a takeWhile does not compile.
+			 */
+			int split()
+			{
+				static_assert(sizeof(TInput) == 0, "takeWhile() depends on position, run it after the parallel part of the chain");
+				return 0;
+			}
+
+		private:
+			TInput mInput;
+
+			TPredicate mPredicate;
+
+			/**
+			 * \brief Set once an item failed the predicate or the input ended.
+			 */
+			bool mDone;
+		};
+	}
+}
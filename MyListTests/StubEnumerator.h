@@ -12,7 +12,7 @@ namespace MyListTests
 		T getCurrentReturnValue;
 		StubEnumerator(bool moveReturnValue, T currentValue) : moveReturnValue(moveReturnValue), getCurrentReturnValue(currentValue){}
 		bool moveNext() override { return moveReturnValue; }
-		T getCurrent() override { return getCurrentReturnValue; };
+		const T & getCurrent() override { return getCurrentReturnValue; };
 		std::shared_ptr<IEnumerator<int>> clone() override { return std::shared_ptr<IEnumerator<T>>(this); }
 	};
 }
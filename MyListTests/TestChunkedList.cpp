@@ -0,0 +1,174 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "..\MyListCpp\ChunkedList.h"
+#include "..\MyListCpp\MutableList.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestChunkedList)
+	{
+	public:
+
+		TEST_METHOD(TestEmptyThrowsException)
+		{
+			ChunkedList<int> list;
+			Assert::ExpectException<Exception::EmptyListException>([list] { return list.getHead(); });
+
+			Assert::AreEqual(0, list.getLength());
+			Assert::AreEqual(0, list.getTail().getLength());
+			Assert::IsFalse(list.getEnumerator()->moveNext());
+		}
+
+		TEST_METHOD(TestEnumeratorAcrossChunks)
+		{
+			int input[1000];
+			for (int i = 0; i < 1000; ++i) input[i] = i;
+			ChunkedList<int> list(input, 1000);
+			Assert::AreEqual(1000, list.getLength());
+
+			auto enumerator = list.getEnumerator();
+			int expected = 0;
+			while (enumerator->moveNext())
+			{
+				Assert::AreEqual(expected++, enumerator->getCurrent());
+			}
+			Assert::AreEqual(1000, expected);
+
+			// Should still point to end of list.
+			Assert::AreEqual(999, enumerator->getCurrent());
+		}
+
+		TEST_METHOD(TestEnumeratorBatch)
+		{
+			int input[200];
+			for (int i = 0; i < 200; ++i) input[i] = i;
+			ChunkedList<int> list(input, 200);
+
+			auto enumerator = list.getEnumerator();
+			int batch[150];
+			Assert::AreEqual(0, enumerator->nextBatch(batch, 0));
+			Assert::AreEqual(150, enumerator->nextBatch(batch, 150));
+			Assert::AreEqual(149, batch[149]);
+
+			// moveNext goes on after the last item copied.
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(150, enumerator->getCurrent());
+			Assert::AreEqual(49, enumerator->nextBatch(batch, 150));
+			Assert::AreEqual(151, batch[0]);
+			Assert::AreEqual(199, batch[48]);
+			Assert::AreEqual(0, enumerator->nextBatch(batch, 150));
+		}
+
+		TEST_METHOD(TestTailAcrossChunks)
+		{
+			int input[300];
+			for (int i = 0; i < 300; ++i) input[i] = i;
+			ChunkedList<int> list(input, 300);
+
+			for (int i = 0; i < 300; ++i)
+			{
+				Assert::AreEqual(i, list.getHead());
+				Assert::AreEqual(300 - i, list.getLength());
+				list = list.getTail();
+			}
+			Assert::AreEqual(0, list.getLength());
+		}
+
+		TEST_METHOD(TestPrependSharesTail)
+		{
+			int input[] = { 1, 2 };
+			ChunkedList<int> list(input, 2);
+			auto first = list.prepend(3);
+			auto second = list.prepend(4);
+
+			// The slot in front of list went to first, second needs its own chunk.
+			Assert::AreEqual(3, first.getHead());
+			Assert::AreEqual(4, second.getHead());
+			Assert::AreEqual(1, first.getTail().getHead());
+			Assert::AreEqual(1, second.getTail().getHead());
+			Assert::AreEqual(6, first.foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::AreEqual(7, second.foldLeft<int>(0, [](int a, int x){return a + x; }));
+
+			// Check had no effect on old list
+			Assert::AreEqual(1, list.getHead());
+			Assert::AreEqual(2, list.getLength());
+		}
+
+		TEST_METHOD(TestReverse)
+		{
+			int input[100];
+			for (int i = 0; i < 100; ++i) input[i] = i;
+			ChunkedList<int> list(input, 100);
+
+			auto reversed = list.reverse();
+			Assert::AreEqual(100, reversed.getLength());
+			auto enumerator = reversed.getEnumerator();
+			int expected = 99;
+			while (enumerator->moveNext())
+			{
+				Assert::AreEqual(expected--, enumerator->getCurrent());
+			}
+			Assert::AreEqual(-1, expected);
+		}
+
+		TEST_METHOD(TestPipeline)
+		{
+			int input[] = { 1, 2, 3, 4, 5, 6 };
+			ChunkedList<int> list(input, 6);
+
+			auto evens = list.filter([](int x){return (x % 2) == 0; }).toMutableList();
+			Assert::AreEqual(3, evens.getLength());
+			Assert::AreEqual(2, evens[0]);
+
+			auto doubled = list.map<int>([](int x){return x * 2; }).toImmutableList();
+			Assert::AreEqual(6, doubled.getLength());
+			Assert::AreEqual(2, doubled.getHead());
+		}
+
+		TEST_METHOD(TestFromEnumerable)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> source(input, 3);
+			ChunkedList<int> list(&source);
+
+			Assert::AreEqual(3, list.getLength());
+			Assert::AreEqual(1, list.getHead());
+			Assert::AreEqual(3, list.getTail().getTail().getHead());
+
+			// A filter only bounds its length.
+			LazyList<int> odd = source.filter([](int x){return x % 2 == 1; }).toLazyList();
+			ChunkedList<int> filtered(&odd);
+			Assert::AreEqual(2, filtered.getLength());
+			Assert::AreEqual(3, filtered.getTail().getHead());
+		}
+
+		TEST_METHOD(TestStrings)
+		{
+			std::string input[] = { "a", "b", "c" };
+			ChunkedList<std::string> list(input, 3);
+			auto longer = list.prepend("z");
+
+			Assert::AreEqual(std::string("z"), longer.getHead());
+			Assert::AreEqual(std::string("zabc"), longer.foldLeft<std::string>("", [](std::string a, std::string x){return a + x; }));
+		}
+
+		TEST_METHOD(TestDestroyLongChain)
+		{
+			ChunkedList<int> tail;
+			for (int i = 0; i < 1000000; ++i)
+			{
+				tail = tail.prepend(i);
+			}
+			{
+				ChunkedList<int> list = tail.prepend(-1).prepend(-2);
+				Assert::AreEqual(1000002, list.getLength());
+			}
+			Assert::AreEqual(999999, tail.getHead());
+		}
+	};
+}
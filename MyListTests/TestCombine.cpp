@@ -0,0 +1,141 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <string>
+#include <utility>
+
+#include "../MyListCpp/MutableList.h"
+#include "../MyListCpp/ImmutableList.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestCombine)
+	{
+	public:
+
+		TEST_METHOD(TestZip)
+		{
+			int numbers[] = { 1, 2, 3, 4 };
+			MutableList<int> left(numbers, 4);
+			double halves[] = { 0.5, 1.5, 2.5 };
+			ImmutableList<double> right(halves, 3);
+
+			LazyList<std::pair<int, double> > zipped = left.zip(right);
+			Assert::AreEqual(3, zipped.getEnumerator()->getSizeHint().getCount());
+			MutableList<std::pair<int, double> > pairs = zipped.toMutableList();
+			Assert::AreEqual(3, pairs.getLength());
+			Assert::AreEqual(3, pairs.at(2).first);
+			Assert::AreEqual(2.5, pairs.at(2).second);
+
+			// Lazy sources on either side are read in step, the shorter one ends the zip.
+			LazyList<int> evens = left.filter([](int x){return x % 2 == 0; }).toLazyList();
+			Assert::AreEqual(10, left.zip(evens).foldLeft<int>(0, [](int a, const std::pair<int, int> & p){return a + p.first * p.second; }));
+			Assert::IsTrue(left.zip(evens).getEnumerator()->getSizeHint().getKind() == Enumerator::SizeHint::UpperBound);
+
+			// A clone goes on from the same pair.
+			auto enumerator = left.zip(right).getEnumerator();
+			Assert::IsTrue(enumerator->moveNext());
+			auto clone = enumerator->clone();
+			Assert::AreEqual(1, clone->getCurrent().first);
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(2, clone->getCurrent().first);
+			Assert::AreEqual(1.5, clone->getCurrent().second);
+			Assert::AreEqual(1, enumerator->getCurrent().first);
+		}
+
+		TEST_METHOD(TestConcat)
+		{
+			int first[] = { 1, 2, 3 };
+			MutableList<int> head(first, 3);
+			ImmutableList<int> tail(first, 2);
+
+			LazyList<int> all = head.concat(tail);
+			Assert::AreEqual(5, all.getEnumerator()->getSizeHint().getCount());
+			MutableList<int> list = all.toMutableList();
+			Assert::AreEqual(5, list.getLength());
+			Assert::AreEqual(3, list.at(2));
+			Assert::AreEqual(1, list.at(3));
+			Assert::AreEqual(9, all.foldLeft<int>(0, [](int a, int x){return a + x; }));
+
+			// Reading item by item gives the same items.
+			auto enumerator = all.getEnumerator();
+			int count = 0;
+			while (enumerator->moveNext()) ++count;
+			Assert::AreEqual(5, count);
+
+			// A clone taken in the second input goes on in it.
+			enumerator = head.concat(tail).getEnumerator();
+			for (int i = 0; i < 4; ++i) enumerator->moveNext();
+			auto clone = enumerator->clone();
+			Assert::AreEqual(1, clone->getCurrent());
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(2, clone->getCurrent());
+			Assert::IsFalse(clone->moveNext());
+			Assert::AreEqual(3, MutableList<int>().concat(head).toMutableList().getLength());
+		}
+
+		TEST_METHOD(TestFlatMap)
+		{
+			int input[] = { 0, 3, 1, 0, 2 };
+			MutableList<int> list(input, 5);
+
+			// Every item expands to that many copies of itself, lazily.
+			LazyList<int> expanded = list.flatMap<int>([](int x){
+				MutableList<int> copies;
+				for (int i = 0; i < x; ++i) copies.append(x);
+				return copies;
+			});
+			MutableList<int> items = expanded.toMutableList();
+			Assert::AreEqual(6, items.getLength());
+			Assert::AreEqual(3, items.at(0));
+			Assert::AreEqual(1, items.at(3));
+			Assert::AreEqual(2, items.at(5));
+			Assert::AreEqual(14, expanded.foldLeft<int>(0, [](int a, int x){return a + x; }));
+
+			Assert::IsFalse(MutableList<int>().flatMap<int>([](int x){return MutableList<int>(); }).getEnumerator()->moveNext());
+
+			// A clone taken inside an expansion goes on with the rest of it, then the items after.
+			auto enumerator = expanded.getEnumerator();
+			for (int i = 0; i < 2; ++i) enumerator->moveNext();
+			auto clone = enumerator->clone();
+			int rest = 0;
+			while (clone->moveNext()) rest = rest * 10 + clone->getCurrent();
+			Assert::AreEqual(3122, rest);
+			Assert::AreEqual(3, enumerator->getCurrent());
+		}
+
+		TEST_METHOD(TestEnumerate)
+		{
+			std::string words[] = { "a", "b", "c" };
+			MutableList<std::string> list(words, 3);
+
+			MutableList<std::pair<int, std::string> > numbered = list.enumerate().toMutableList();
+			Assert::AreEqual(3, numbered.getLength());
+			Assert::AreEqual(2, numbered.at(2).first);
+			Assert::AreEqual(std::string("c"), numbered.at(2).second);
+			Assert::AreEqual(3, list.enumerate().getEnumerator()->getSizeHint().getCount());
+
+			auto enumerator = list.enumerate().getEnumerator();
+			Assert::ExpectException<Exception::InvalidEnumerator>([&enumerator] { enumerator->getCurrent(); });
+
+			// A clone counts on from the same position, over a list that keeps its position too.
+			for (int i = 0; i < 2; ++i) enumerator->moveNext();
+			auto clone = enumerator->clone();
+			Assert::AreEqual(1, clone->getCurrent().first);
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(2, clone->getCurrent().first);
+			Assert::AreEqual(std::string("c"), clone->getCurrent().second);
+
+			auto lazy = ImmutableList<std::string>(words, 3).enumerate().getEnumerator();
+			lazy->moveNext();
+			auto lazyClone = lazy->clone();
+			Assert::IsTrue(lazyClone->moveNext());
+			Assert::AreEqual(1, lazyClone->getCurrent().first);
+			Assert::AreEqual(std::string("b"), lazyClone->getCurrent().second);
+		}
+	};
+}
@@ -0,0 +1,74 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "../MyListCpp/MutableList.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestConcurrentEnumerator)
+	{
+	public:
+		TEST_METHOD(TestBatches)
+		{
+			int input[] = { 1, 2, 3, 4, 5 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+			auto enumerator = list.getConcurrentEnumerator();
+
+			int batch[2];
+			Assert::AreEqual(2, enumerator->tryGetBatch(batch, 2));
+			Assert::AreEqual(1, batch[0]);
+			Assert::AreEqual(2, batch[1]);
+			Assert::AreEqual(2, enumerator->tryGetBatch(batch, 2));
+			Assert::AreEqual(1, enumerator->tryGetBatch(batch, 2));
+			Assert::AreEqual(5, batch[0]);
+			Assert::AreEqual(0, enumerator->tryGetBatch(batch, 2));
+		}
+
+		TEST_METHOD(TestTryGetNext)
+		{
+			int input[] = { 1, 2 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+			auto enumerator = list.getConcurrentEnumerator();
+
+			int value = 0;
+			Assert::AreEqual(true, enumerator->tryGetNext(value));
+			Assert::AreEqual(1, value);
+			Assert::AreEqual(true, enumerator->tryGetNext(value));
+			Assert::AreEqual(2, value);
+			Assert::AreEqual(false, enumerator->tryGetNext(value));
+		}
+
+		TEST_METHOD(TestSharedBetweenThreads)
+		{
+			MutableList<int> list;
+			for (int i = 1; i <= 10000; ++i) list.append(i);
+			auto enumerator = list.getConcurrentEnumerator();
+
+			std::atomic<long long> total(0);
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+			{
+				threads.push_back(std::thread([&enumerator, &total](){
+					int batch[64];
+					int count;
+					long long sum = 0;
+					while ((count = enumerator->tryGetBatch(batch, 64)) > 0)
+					{
+						for (int i = 0; i < count; ++i) sum += batch[i];
+					}
+					total += sum;
+				}));
+			}
+			for (auto & thread : threads) thread.join();
+
+			Assert::AreEqual(50005000LL, total.load());
+		}
+	};
+}
@@ -0,0 +1,126 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../MyListCpp/MutableList.h"
+#include "../MyListCpp/Enumerator/FileEnumerator.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestFileEnumerator)
+	{
+	public:
+
+		TEST_METHOD(TestRecords)
+		{
+			{
+				std::ofstream file("TestRecords.bin", std::ios::binary);
+				for (int i = 0; i < 100000; ++i) file.write(reinterpret_cast<const char *>(&i), sizeof(i));
+			}
+
+			// Small blocks, so items are read across many of them.
+			LazyList<int> list(std::make_shared<FileEnumerator<int> >("TestRecords.bin", 0, 4096, 3));
+			Assert::AreEqual(100000, list.getEnumerator()->getSizeHint().getCount());
+			Assert::AreEqual(4999950000LL, list.foldLeft<long long>(0, [](long long a, int x){return a + x; }));
+			Assert::AreEqual(50000, list.filter([](int x){return x % 2 == 0; }).toMutableList().getLength());
+
+			MutableList<int> copy = list.toMutableList();
+			Assert::AreEqual(100000, copy.getLength());
+			Assert::AreEqual(99999, copy.at(99999));
+
+			// Start past a header.
+			LazyList<int> tail(std::make_shared<FileEnumerator<int> >("TestRecords.bin", 99990 * sizeof(int)));
+			Assert::AreEqual(99990, tail.first());
+			Assert::AreEqual(10, tail.getEnumerator()->getSizeHint().getCount());
+
+			std::remove("TestRecords.bin");
+		}
+
+		TEST_METHOD(TestRecordsClone)
+		{
+			{
+				std::ofstream file("TestRecordsClone.bin", std::ios::binary);
+				for (short i = 0; i < 5000; ++i) file.write(reinterpret_cast<const char *>(&i), sizeof(i));
+			}
+
+			FileEnumerator<short> enumerator("TestRecordsClone.bin", 0, 1000, 2);
+			for (int i = 0; i < 3000; ++i) enumerator.moveNext();
+			auto clone = enumerator.clone();
+			Assert::AreEqual(static_cast<short>(2999), clone->getCurrent());
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(static_cast<short>(3000), clone->getCurrent());
+			Assert::AreEqual(1999, clone->getSizeHint().getCount());
+			Assert::AreEqual(static_cast<short>(2999), enumerator.getCurrent());
+
+			// A batch leaves no current item, moveNext goes on after its last.
+			short batch[100];
+			Assert::AreEqual(100, enumerator.nextBatch(batch, 100));
+			Assert::AreEqual(static_cast<short>(3099), batch[99]);
+			Assert::ExpectException<Exception::InvalidEnumerator>([&enumerator] { enumerator.getCurrent(); });
+			Assert::IsTrue(enumerator.moveNext());
+			Assert::AreEqual(static_cast<short>(3100), enumerator.getCurrent());
+
+			std::remove("TestRecordsClone.bin");
+		}
+
+		TEST_METHOD(TestRecordsTruncated)
+		{
+			{
+				std::ofstream file("TestRecordsTruncated.bin", std::ios::binary);
+				int value = 7;
+				file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+				file.write("ab", 2);
+			}
+
+			FileEnumerator<int> enumerator("TestRecordsTruncated.bin");
+			Assert::IsTrue(enumerator.moveNext());
+			Assert::AreEqual(7, enumerator.getCurrent());
+			Assert::ExpectException<Exception::InvalidFileFormat>([&enumerator] { enumerator.moveNext(); });
+
+			std::remove("TestRecordsTruncated.bin");
+			Assert::ExpectException<Exception::FileException>([] { FileEnumerator<int> missing("TestRecordsTruncated.bin"); });
+		}
+
+		TEST_METHOD(TestLines)
+		{
+			{
+				std::ofstream file("TestLines.txt", std::ios::binary);
+				file << "first\r\n\nthird line is longer than a block\nlast";
+			}
+
+			typedef FileEnumerator<std::string, LineFormat> Lines;
+			LazyList<std::string> lines(std::make_shared<Lines>("TestLines.txt", 0, 8, 2));
+			MutableList<std::string> all = lines.toMutableList();
+			Assert::AreEqual(4, all.getLength());
+			Assert::AreEqual(std::string("first"), all.at(0));
+			Assert::AreEqual(std::string(), all.at(1));
+			Assert::AreEqual(std::string("third line is longer than a block"), all.at(2));
+			Assert::AreEqual(std::string("last"), all.at(3));
+			Assert::AreEqual(2, lines.filter([](const std::string & line){return line.size() > 4; }).toMutableList().getLength());
+
+			std::remove("TestLines.txt");
+		}
+
+		TEST_METHOD(TestAbandonedEnumeration)
+		{
+			{
+				std::ofstream file("TestAbandonedEnumeration.bin", std::ios::binary);
+				for (int i = 0; i < 100000; ++i) file.write(reinterpret_cast<const char *>(&i), sizeof(i));
+			}
+
+			// Stopping early stops the reader thread with whatever it has read ahead.
+			LazyList<int> list(std::make_shared<FileEnumerator<int> >("TestAbandonedEnumeration.bin", 0, 4096, 4));
+			Assert::IsTrue(list.any([](int x){return x == 10; }));
+			Assert::AreEqual(0, list.first());
+
+			std::remove("TestAbandonedEnumeration.bin");
+		}
+	};
+}
@@ -32,6 +32,18 @@ namespace MyListTests
 
 			Assert::AreEqual(false, filter.moveNext());
 		}
+
+		TEST_METHOD(TestSizeHintIsUpperBound)
+		{
+			int input[] = { 1, 2, 3, 4 };
+			ImmutableList<int> list(input, sizeof(input) / sizeof(int));
+			FilterEnumerator<int> filter(list.getEnumerator(), [](int x){return (x % 2) == 0; });
+
+			Assert::IsTrue(filter.getSizeHint().getKind() == Enumerator::SizeHint::UpperBound);
+			Assert::AreEqual(4, filter.getSizeHint().getCount());
+			filter.moveNext();
+			Assert::AreEqual(2, filter.getSizeHint().getCount());
+		}
 	};
 
 	TEST_CLASS(TestFilter)
@@ -57,6 +69,31 @@ namespace MyListTests
 			Assert::AreEqual(4, enumerator->getCurrent());
 		}
 
+		TEST_METHOD(TestFilterCapturingLambda)
+		{
+			int input[] = { 1, 2, 3, 4 };
+			LazyList<int> list = ImmutableList<int>(input, sizeof(input) / sizeof(int)).map<int>([](int x){return x; });
+			int threshold = 3;
+			auto filter = list.filter([threshold](int x){return x >= threshold; });
+
+			Assert::AreEqual(7, filter.foldLeft<int>(0, [](int a, int x){return a + x; }));
+		}
+
+		TEST_METHOD(TestFilterBatchCompacts)
+		{
+			int input[] = { 1, 2, 3, 4, 5, 6 };
+			LazyList<int> list = ImmutableList<int>(input, sizeof(input) / sizeof(int)).map<int>([](int x){return x; });
+			auto enumerator = list.filter([](int x){return (x % 2) == 0; }).getEnumerator();
+
+			int batch[2];
+			Assert::AreEqual(2, enumerator->nextBatch(batch, 2));
+			Assert::AreEqual(2, batch[0]);
+			Assert::AreEqual(4, batch[1]);
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(6, enumerator->getCurrent());
+			Assert::AreEqual(0, enumerator->nextBatch(batch, 2));
+		}
+
 		TEST_METHOD(TestEmptyListFilter)
 		{
 			ImmutableList<int> list;
@@ -0,0 +1,107 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <string>
+
+#include "../MyListCpp/HashMap.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestHashMap)
+	{
+	public:
+
+		TEST_METHOD(TestInsertAndLookup)
+		{
+			HashMap<int, int> map;
+			for (int i = 0; i < 10000; ++i) map[i * 1024] = i;
+
+			// Keys that are multiples of a power of two still spread out.
+			Assert::AreEqual(10000, map.getLength());
+			Assert::AreEqual(5000, map.at(5000 * 1024));
+			Assert::IsTrue(map.contains(0));
+			Assert::IsFalse(map.contains(1));
+			Assert::ExpectException<Exception::KeyNotFound>([&map] { map.at(1); });
+
+			map[1024] += 5;
+			Assert::AreEqual(6, map.at(1024));
+			Assert::AreEqual(10000, map.getLength());
+		}
+
+		TEST_METHOD(TestInsertionOrder)
+		{
+			HashMap<std::string, int> map(4);
+			map["pear"] = 1;
+			map["apple"] = 2;
+			map["fig"] = 3;
+			map["apple"] = 4;
+
+			auto enumerator = map.getEnumerator();
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(std::string("pear"), enumerator->getCurrent().first);
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(4, enumerator->getCurrent().second);
+
+			// The enumerator reads a snapshot.
+			map["fig"] = 30;
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(3, enumerator->getCurrent().second);
+			Assert::AreEqual(30, map.at("fig"));
+			Assert::AreEqual(3, map.getEntries().getLength());
+		}
+
+		TEST_METHOD(TestGroupBy)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 100; ++i) list.append(i);
+
+			HashMap<int, MutableList<int> > groups = list.groupBy<int>([](int x){return x % 3; }, 3);
+			Assert::AreEqual(3, groups.getLength());
+			Assert::AreEqual(34, groups.at(0).getLength());
+			Assert::AreEqual(33, groups.at(2).getLength());
+			Assert::AreEqual(97, groups.at(1).at(32));
+
+			// Keys come out in the order they were first met.
+			Assert::AreEqual(0, groups.getEntries().at(0).first);
+			Assert::AreEqual(2, groups.getEntries().at(2).first);
+		}
+
+		TEST_METHOD(TestCountBy)
+		{
+			std::string words[] = { "a", "bb", "cc", "d", "eee", "ff" };
+			MutableList<std::string> list(words, 6);
+
+			HashMap<size_t, int> counts = list.countBy<size_t>([](const std::string & word){return word.size(); });
+			Assert::AreEqual(3, counts.getLength());
+			Assert::AreEqual(2, counts.at(1));
+			Assert::AreEqual(3, counts.at(2));
+			Assert::AreEqual(1, counts.at(3));
+
+			// Works on lazy lists, and the result is itself enumerable.
+			LazyList<std::string> longWords = list.filter([](const std::string & word){return word.size() > 1; }).toLazyList();
+			Assert::AreEqual(4, longWords.countBy<size_t>([](const std::string & word){return word.size(); })
+				.foldLeft<int>(0, [](int a, const std::pair<size_t, int> & entry){return a + entry.second; }));
+		}
+
+		TEST_METHOD(TestDistinct)
+		{
+			int input[] = { 3, 1, 3, 2, 1, 3 };
+			MutableList<int> list(input, 6);
+
+			MutableList<int> distinct = list.distinct();
+			Assert::AreEqual(3, distinct.getLength());
+			Assert::AreEqual(3, distinct.at(0));
+			Assert::AreEqual(1, distinct.at(1));
+			Assert::AreEqual(2, distinct.at(2));
+
+			MutableList<int> many;
+			for (int i = 0; i < 50000; ++i) many.append(i % 777);
+			Assert::AreEqual(777, many.distinct(1000).getLength());
+			Assert::AreEqual(0, MutableList<int>().distinct().getLength());
+		}
+	};
+}
@@ -52,6 +52,21 @@ namespace MyListTests
 			Assert::AreEqual(input[1], enumerator->getCurrent());
 		}
 
+		TEST_METHOD(TestEnumeratorBatch)
+		{
+			int input[] = { 1, 2, 3 };
+			ImmutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			auto enumerator = list.getEnumerator();
+			int batch[4];
+			Assert::AreEqual(2, enumerator->nextBatch(batch, 2));
+			Assert::AreEqual(1, batch[0]);
+			Assert::AreEqual(2, batch[1]);
+			Assert::AreEqual(1, enumerator->nextBatch(batch, 4));
+			Assert::AreEqual(3, batch[0]);
+			Assert::AreEqual(0, enumerator->nextBatch(batch, 4));
+		}
+
 		TEST_METHOD(TestReverse)
 		{
 			int input[] = { 1, 2 };
@@ -105,5 +120,105 @@ namespace MyListTests
 
 			Assert::AreEqual(0, filteredList.getLength());
 		}
+
+		TEST_METHOD(TestDestroyLongChain)
+		{
+			// Nested destructors would need one stack frame per node.
+			{
+				ImmutableList<int> list;
+				for (int i = 0; i < 2000000; ++i)
+				{
+					list = list.prepend(i);
+				}
+				Assert::AreEqual(2000000, list.getLength());
+			}
+		}
+
+		TEST_METHOD(TestDestroyKeepsSharedTail)
+		{
+			ImmutableList<int> tail;
+			for (int i = 0; i < 100000; ++i)
+			{
+				tail = tail.prepend(i);
+			}
+			{
+				ImmutableList<int> list = tail.prepend(-1).prepend(-2);
+				Assert::AreEqual(100002, list.getLength());
+			}
+
+			Assert::AreEqual(99999, tail.getHead());
+			Assert::AreEqual(100000, tail.foldLeft<int>(0, [](int a, int){return a + 1; }));
+		}
+
+		TEST_METHOD(TestDestroyInBackground)
+		{
+			Memory::Reclaimer::getDefault().setInlineLimit(1000);
+			{
+				ImmutableList<int> list;
+				for (int i = 0; i < 500000; ++i)
+				{
+					list = list.prepend(i);
+				}
+			}
+			Memory::Reclaimer::getDefault().drain();
+			Memory::Reclaimer::getDefault().setInlineLimit(0);
+
+			ImmutableList<int> list;
+			list = list.prepend(1);
+			Assert::AreEqual(1, list.getHead());
+		}
+
+		TEST_METHOD(TestLocalCountList)
+		{
+			int input[] = { 1, 2, 3, 4 };
+			ImmutableList<int, Memory::LocalCount> list(input, sizeof(input) / sizeof(int));
+			ImmutableList<int, Memory::LocalCount> longer = list.prepend(0);
+
+			Assert::AreEqual(5, longer.getLength());
+			Assert::AreEqual(0, longer.getHead());
+			Assert::AreEqual(1, longer.getTail().getHead());
+			Assert::AreEqual(10, list.foldLeft<int>(0, [](int a, int x){return a + x; }));
+
+			auto enumerator = longer.getEnumerator();
+			int expected = 0;
+			while (enumerator->moveNext())
+			{
+				Assert::AreEqual(expected++, enumerator->getCurrent());
+			}
+			Assert::AreEqual(5, expected);
+
+			ImmutableList<int> evens = longer.filter([](int x){return (x % 2) == 0; }).toImmutableList();
+			Assert::AreEqual(3, evens.getLength());
+		}
+
+		TEST_METHOD(TestLocalCountDestroyLongChain)
+		{
+			ImmutableList<int, Memory::LocalCount> tail;
+			for (int i = 0; i < 1000000; ++i)
+			{
+				tail = tail.prepend(i);
+			}
+			{
+				ImmutableList<int, Memory::LocalCount> list = tail.prepend(-1);
+				Assert::AreEqual(1000001, list.getLength());
+			}
+			Assert::AreEqual(999999, tail.getHead());
+		}
+
+		TEST_METHOD(TestEnumeratorOutlivesList)
+		{
+			std::shared_ptr<IEnumerator<int> > enumerator;
+			{
+				int input[] = { 7, 8 };
+				ImmutableList<int> list(input, 2);
+				enumerator = list.getEnumerator();
+			}
+
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(7, enumerator->getCurrent());
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(8, enumerator->getCurrent());
+			Assert::IsFalse(enumerator->moveNext());
+		}
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <string>
+#include <utility>
+
+#include "../MyListCpp/MutableList.h"
+#include "../MyListCpp/ImmutableList.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestJoin)
+	{
+	public:
+
+		TEST_METHOD(TestHashJoin)
+		{
+			int events[] = { 3, 1, 4, 1, 5, 9, 2, 6 };
+			MutableList<int> left(events, 8);
+			std::pair<int, std::string> names[] = { std::make_pair(1, "one"), std::make_pair(2, "two"), std::make_pair(1, "uno"),
+				std::make_pair(9, "nine"), std::make_pair(7, "seven") };
+			ImmutableList<std::pair<int, std::string> > right(names, 5);
+
+			LazyList<std::string> joined = left.join<std::string, int>(right, [](int x){return x; },
+				[](const std::pair<int, std::string> & entry){return entry.first; },
+				[](int x, const std::pair<int, std::string> & entry){return std::to_string(x) + entry.second; });
+
+			// Order of this list, then order of the other list within a key; keys without a match drop out.
+			MutableList<std::string> items = joined.toMutableList();
+			Assert::AreEqual(6, items.getLength());
+			Assert::AreEqual(std::string("1one"), items.at(0));
+			Assert::AreEqual(std::string("1uno"), items.at(1));
+			Assert::AreEqual(std::string("1one"), items.at(2));
+			Assert::AreEqual(std::string("1uno"), items.at(3));
+			Assert::AreEqual(std::string("9nine"), items.at(4));
+			Assert::AreEqual(std::string("2two"), items.at(5));
+
+			// Every enumeration and clone joins the same items, over one shared table.
+			auto enumerator = joined.getEnumerator();
+			auto clone = enumerator->clone();
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(std::string("1one"), clone->getCurrent());
+			Assert::AreEqual(std::string("1uno"), enumerator->getCurrent());
+			Assert::AreEqual(6, joined.foldLeft<int>(0, [](int a, const std::string &){return a + 1; }));
+		}
+
+		TEST_METHOD(TestHashJoinLarge)
+		{
+			MutableList<int> left;
+			for (int i = 0; i < 20000; ++i) left.append(i);
+			MutableList<int> right;
+			for (int i = 0; i < 30000; i += 3) right.append(i * 2);
+
+			// Every third even number of left is in right.
+			LazyList<int> joined = left.join<int, int>(right, [](int x){return x; }, [](int x){return x; }, [](int x, int y){return x + y; });
+			Assert::AreEqual(3334, joined.foldLeft<int>(0, [](int a, int){return a + 1; }));
+			Assert::AreEqual(24, joined.toMutableList().at(2));
+
+			auto empty = left.join<int, int>(MutableList<int>(), [](int x){return x; }, [](int x){return x; }, [](int x, int y){return x; });
+			Assert::IsFalse(empty.getEnumerator()->moveNext());
+			Assert::ExpectException<Exception::InvalidEnumerator>([&empty] { empty.getEnumerator()->getCurrent(); });
+		}
+
+		TEST_METHOD(TestMergeJoin)
+		{
+			int events[] = { 1, 1, 2, 4, 5, 5, 8 };
+			MutableList<int> left(events, 7);
+			std::pair<int, char> codes[] = { std::make_pair(0, 'z'), std::make_pair(1, 'a'), std::make_pair(1, 'b'),
+				std::make_pair(3, 'c'), std::make_pair(5, 'd'), std::make_pair(6, 'e') };
+			MutableList<std::pair<int, char> > right(codes, 6);
+
+			LazyList<std::string> joined = left.mergeJoin<std::string, int>(right, [](int x){return x; },
+				[](const std::pair<int, char> & entry){return entry.first; },
+				[](int x, const std::pair<int, char> & entry){return std::to_string(x) + entry.second; });
+
+			// Same items as the hash join on sorted lists.
+			MutableList<std::string> items = joined.toMutableList();
+			Assert::AreEqual(6, items.getLength());
+			Assert::AreEqual(std::string("1a"), items.at(0));
+			Assert::AreEqual(std::string("1b"), items.at(1));
+			Assert::AreEqual(std::string("1a"), items.at(2));
+			Assert::AreEqual(std::string("1b"), items.at(3));
+			Assert::AreEqual(std::string("5d"), items.at(4));
+			Assert::AreEqual(std::string("5d"), items.at(5));
+
+			auto hashed = left.join<std::string, int>(right, [](int x){return x; },
+				[](const std::pair<int, char> & entry){return entry.first; },
+				[](int x, const std::pair<int, char> & entry){return std::to_string(x) + entry.second; }).toMutableList();
+			Assert::AreEqual(items.getLength(), hashed.getLength());
+			for (int i = 0; i < items.getLength(); ++i) Assert::AreEqual(items.at(i), hashed.at(i));
+
+			auto enumerator = joined.getEnumerator();
+			auto clone = enumerator->clone();
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(std::string("1a"), clone->getCurrent());
+			Assert::AreEqual(std::string("1b"), enumerator->getCurrent());
+		}
+
+		TEST_METHOD(TestJoinCloneMidStream)
+		{
+			int events[] = { 1, 2, 2, 3 };
+			ImmutableList<int> left(events, 4);
+			std::pair<int, char> codes[] = { std::make_pair(1, 'a'), std::make_pair(2, 'b'), std::make_pair(2, 'c'), std::make_pair(3, 'd') };
+			ImmutableList<std::pair<int, char> > right(codes, 4);
+
+			auto key = [](const std::pair<int, char> & entry){return entry.first; };
+			auto combine = [](int x, const std::pair<int, char> & entry){return std::to_string(x) + entry.second; };
+			LazyList<std::string> joins[] = { left.join<std::string, int>(right, [](int x){return x; }, key, combine),
+				left.mergeJoin<std::string, int>(right, [](int x){return x; }, key, combine) };
+
+			// A clone taken part way goes on from the same match as the original, both to the end.
+			for (int j = 0; j < 2; ++j)
+			{
+				auto enumerator = joins[j].getEnumerator();
+				Assert::IsTrue(enumerator->moveNext());
+				Assert::IsTrue(enumerator->moveNext());
+				auto clone = enumerator->clone();
+				Assert::AreEqual(std::string("2b"), clone->getCurrent());
+
+				std::string rest;
+				while (clone->moveNext()) rest += clone->getCurrent();
+				Assert::AreEqual(std::string("2c2b2c3d"), rest);
+
+				Assert::AreEqual(std::string("2b"), enumerator->getCurrent());
+				rest.clear();
+				while (enumerator->moveNext()) rest += enumerator->getCurrent();
+				Assert::AreEqual(std::string("2c2b2c3d"), rest);
+			}
+		}
+
+		TEST_METHOD(TestMergeJoinUnsorted)
+		{
+			int sorted[] = { 1, 2, 3 };
+			int unsorted[] = { 1, 3, 2 };
+			MutableList<int> good(sorted, 3);
+			MutableList<int> bad(unsorted, 3);
+
+			auto id = [](int x){return x; };
+			auto add = [](int x, int y){return x + y; };
+			Assert::AreEqual(3, good.mergeJoin<int, int>(good, id, id, add).toMutableList().getLength());
+			Assert::ExpectException<Exception::UnsortedInput>([&] { bad.mergeJoin<int, int>(good, id, id, add).toMutableList(); });
+			Assert::ExpectException<Exception::UnsortedInput>([&] { good.mergeJoin<int, int>(bad, id, id, add).toMutableList(); });
+			Assert::IsFalse(good.mergeJoin<int, int>(MutableList<int>(), id, id, add).getEnumerator()->moveNext());
+		}
+	};
+}
@@ -0,0 +1,218 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../MyListCpp/MutableList.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestLazyList)
+	{
+	public:
+
+		TEST_METHOD(TestEveryEnumerationReevaluates)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, 3);
+			int calls = 0;
+			LazyList<int> lazy = list.map<int>([&calls](int x){++calls; return x * 2; });
+
+			lazy.foldLeft<int>(0, [](int a, int x){return a + x; });
+			lazy.foldLeft<int>(0, [](int a, int x){return a + x; });
+			Assert::AreEqual(6, calls);
+		}
+
+		TEST_METHOD(TestShortCircuitTerminals)
+		{
+			int input[] = { 1, 2, 3, 4, 5 };
+			MutableList<int> list(input, 5);
+			int calls = 0;
+			LazyList<int> lazy = list.map<int>([&calls](int x){++calls; return x; });
+
+			Assert::IsTrue(lazy.any([](int x){return x == 2; }));
+			Assert::AreEqual(2, calls);
+			Assert::IsFalse(lazy.all([](int x){return x < 3; }));
+			int found = 0;
+			Assert::IsTrue(lazy.find([](int x){return x > 3; }, found));
+			Assert::AreEqual(4, found);
+			Assert::IsFalse(lazy.find([](int x){return x > 5; }, found));
+			Assert::AreEqual(1, lazy.first());
+
+			LazyList<int> empty = lazy.skip(5);
+			Assert::ExpectException<Exception::EmptyListException>([&empty] { return empty.first(); });
+		}
+
+		TEST_METHOD(TestTakeSkipTakeWhile)
+		{
+			int input[] = { 1, 2, 3, 4, 5, 6 };
+			MutableList<int> list(input, 6);
+			int calls = 0;
+			LazyList<int> lazy = list.map<int>([&calls](int x){++calls; return x; });
+
+			LazyList<int> taken = lazy.take(2);
+			Assert::AreEqual(3, taken.foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::AreEqual(2, calls);
+			Assert::AreEqual(2, taken.getEnumerator()->getSizeHint().getCount());
+
+			Assert::AreEqual(11, lazy.skip(4).foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::AreEqual(6, lazy.takeWhile([](int x){return x < 4; }).foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::AreEqual(2, lazy.skip(1).take(1).first());
+
+			// Clones enumerate independently.
+			auto first = taken.getEnumerator();
+			first->moveNext();
+			auto second = first->clone();
+			Assert::IsTrue(second->moveNext());
+			Assert::AreEqual(2, second->getCurrent());
+			Assert::AreEqual(1, first->getCurrent());
+		}
+
+		TEST_METHOD(TestTakeSkipTakeWhileClones)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 10; ++i) list.append(i);
+			LazyList<int> lazy(list.getEnumerator());
+
+			// Clones go on from the same position, with the counters of the stage where they were.
+			auto skipped = lazy.skip(3).getEnumerator();
+			skipped->moveNext();
+			auto clone = skipped->clone();
+			Assert::AreEqual(3, clone->getCurrent());
+			int sum = 0;
+			while (clone->moveNext()) sum += clone->getCurrent();
+			Assert::AreEqual(39, sum);
+
+			auto taken = lazy.take(3).getEnumerator();
+			taken->moveNext();
+			taken->moveNext();
+			clone = taken->clone();
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(2, clone->getCurrent());
+			Assert::IsFalse(clone->moveNext());
+
+			auto prefix = lazy.takeWhile([](int x){return x < 3; }).getEnumerator();
+			while (prefix->moveNext());
+			Assert::IsFalse(prefix->clone()->moveNext());
+			prefix = lazy.takeWhile([](int x){return x < 3; }).getEnumerator();
+			prefix->moveNext();
+			clone = prefix->clone();
+			int count = 0;
+			while (clone->moveNext()) ++count;
+			Assert::AreEqual(2, count);
+		}
+
+		TEST_METHOD(TestCachedEvaluatesOnce)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 3000; ++i) list.append(i);
+			int calls = 0;
+			LazyList<int> cached = list.map<int>([&calls](int x){++calls; return x * 2; }).toLazyList().cached();
+
+			for (int pass = 0; pass < 3; ++pass)
+			{
+				Assert::AreEqual(2999 * 3000, cached.foldLeft<int>(0, [](int a, int x){return a + x; }));
+			}
+			Assert::AreEqual(3000, calls);
+
+			auto copy = cached.toMutableList();
+			Assert::AreEqual(3000, copy.getLength());
+			Assert::AreEqual(5998, copy[2999]);
+			Assert::AreEqual(3000, calls);
+		}
+
+		TEST_METHOD(TestCachedEvaluatesOnlyWhatIsRead)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 3000; ++i) list.append(i);
+			int calls = 0;
+			LazyList<int> cached = list.map<int>([&calls](int x){++calls; return x; }).toLazyList().cached();
+
+			auto first = cached.getEnumerator();
+			Assert::IsTrue(first->moveNext());
+			Assert::AreEqual(0, first->getCurrent());
+			Assert::AreEqual(1, calls);
+
+			// Short-circuiting terminals stop evaluating too.
+			int firstCalls = 0;
+			LazyList<int> other = list.map<int>([&firstCalls](int x){++firstCalls; return x; }).toLazyList().cached();
+			Assert::AreEqual(0, other.first());
+			Assert::AreEqual(1, firstCalls);
+
+			// A second enumerator reads the recording, then continues past it.
+			auto second = cached.getEnumerator();
+			int expected = 0;
+			while (second->moveNext())
+			{
+				Assert::AreEqual(expected++, second->getCurrent());
+			}
+			Assert::AreEqual(3000, expected);
+			Assert::AreEqual(3000, calls);
+			Assert::IsTrue(first->moveNext());
+			Assert::AreEqual(1, first->getCurrent());
+		}
+
+		TEST_METHOD(TestCachedReleasesInputWhenExhausted)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, 3);
+			auto token = std::make_shared<int>(0);
+			LazyList<int> cached = list.map<int>([token](int x){return x; }).toLazyList().cached();
+			Assert::IsTrue(token.use_count() > 1);
+
+			auto enumerator = cached.getEnumerator();
+			Assert::IsTrue(enumerator->getSizeHint().getKind() == Enumerator::SizeHint::Exact);
+			Assert::AreEqual(3, enumerator->getSizeHint().getCount());
+			while (enumerator->moveNext());
+
+			Assert::AreEqual(1L, token.use_count());
+			Assert::AreEqual(6, cached.foldLeft<int>(0, [](int a, int x){return a + x; }));
+		}
+
+		TEST_METHOD(TestCachedBoundedLength)
+		{
+			int input[] = { 1, 2, 3, 4, 5 };
+			MutableList<int> list(input, 5);
+			LazyList<int> cached = list.filter([](int x){return x > 2; }).toLazyList().cached();
+
+			auto enumerator = cached.getEnumerator();
+			Assert::IsTrue(enumerator->getSizeHint().getKind() == Enumerator::SizeHint::UpperBound);
+			Assert::AreEqual(5, enumerator->getSizeHint().getCount());
+
+			// Once the input is exhausted the recording knows the length.
+			Assert::AreEqual(12, cached.foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::IsTrue(enumerator->getSizeHint().getKind() == Enumerator::SizeHint::Exact);
+			Assert::AreEqual(3, enumerator->getSizeHint().getCount());
+		}
+
+		TEST_METHOD(TestCachedConcurrentEnumerations)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 100000; ++i) list.append(i);
+			std::atomic<int> calls(0);
+			LazyList<int> cached = list.map<int>([&calls](int x){++calls; return x % 7; }).toLazyList().cached();
+
+			std::vector<long long> sums(4);
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+			{
+				threads.push_back(std::thread([&cached, &sums, t]{
+					sums[t] = cached.foldLeft<long long>(0, [](long long a, int x){return a + x; });
+				}));
+			}
+			for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+
+			long long expected = 0;
+			for (int i = 0; i < 100000; ++i) expected += i % 7;
+			for (int t = 0; t < 4; ++t) Assert::AreEqual(expected, sums[t]);
+			Assert::AreEqual(100000, calls.load());
+		}
+	};
+}
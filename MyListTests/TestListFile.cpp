@@ -0,0 +1,124 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "../MyListCpp/MutableList.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestListFile)
+	{
+	public:
+
+		TEST_METHOD(TestSaveAndMap)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 10000; ++i) list.append(i);
+			list.save("TestSaveAndMap.bin");
+
+			MutableList<int> mapped = MutableList<int>::mapFile("TestSaveAndMap.bin", true);
+			Assert::IsTrue(mapped.isFileMapped());
+			Assert::AreEqual(10000, mapped.getLength());
+			Assert::AreEqual(1234, mapped.at(1234));
+
+			// Pipelines and enumerators read the mapping.
+			Assert::AreEqual(9999 * 10000 / 2, mapped.foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::AreEqual(5000, mapped.filter([](int x){return x % 2 == 0; }).toMutableList().getLength());
+			Assert::AreEqual(6, mapped.map<int>([](int x){return x * 2; }).at(3));
+			auto enumerator = mapped.getEnumerator();
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(0, enumerator->getCurrent());
+			Assert::IsTrue(mapped.isFileMapped());
+
+			std::remove("TestSaveAndMap.bin");
+		}
+
+		TEST_METHOD(TestMappedCopiesOnFirstChange)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int>(input, 3).save("TestMappedCopiesOnFirstChange.bin");
+
+			MutableList<int> mapped = MutableList<int>::mapFile("TestMappedCopiesOnFirstChange.bin");
+			auto snapshot = mapped.getEnumerator();
+			mapped[0] = 10;
+			Assert::IsFalse(mapped.isFileMapped());
+			mapped.append(4);
+			Assert::AreEqual(4, mapped.getLength());
+			Assert::AreEqual(10, mapped.at(0));
+
+			// Neither the snapshot nor the file see the change.
+			snapshot->moveNext();
+			Assert::AreEqual(1, snapshot->getCurrent());
+			MutableList<int> again = MutableList<int>::mapFile("TestMappedCopiesOnFirstChange.bin");
+			Assert::AreEqual(1, again.at(0));
+			Assert::AreEqual(3, again.pop());
+			Assert::IsFalse(again.isFileMapped());
+
+			std::remove("TestMappedCopiesOnFirstChange.bin");
+		}
+
+		TEST_METHOD(TestMappedRemapGrowth)
+		{
+			MutableList<int, Memory::RemapGrowth<> > list;
+			for (int i = 0; i < 1000000; ++i) list.append(i);
+			list.save("TestMappedRemapGrowth.bin");
+
+			// A file mapping is copied to a buffer of the list's own before growing, never remapped.
+			MutableList<int, Memory::RemapGrowth<> > mapped = MutableList<int, Memory::RemapGrowth<> >::mapFile("TestMappedRemapGrowth.bin");
+			mapped.append(1000000);
+			Assert::IsFalse(mapped.isFileMapped());
+			for (int i = 0; i < 1000000; ++i) mapped.append(i);
+			Assert::AreEqual(2000001, mapped.getLength());
+			Assert::AreEqual(999999, mapped.at(999999));
+			Assert::AreEqual(1000000, mapped.at(1000000));
+
+			std::remove("TestMappedRemapGrowth.bin");
+		}
+
+		TEST_METHOD(TestMapEmptyFile)
+		{
+			MutableList<double>().save("TestMapEmptyFile.bin");
+			MutableList<double> mapped = MutableList<double>::mapFile("TestMapEmptyFile.bin", true);
+			Assert::AreEqual(0, mapped.getLength());
+			mapped.append(1.5);
+			Assert::AreEqual(1.5, mapped.at(0));
+
+			std::remove("TestMapEmptyFile.bin");
+		}
+
+		TEST_METHOD(TestMapRejectsBadFiles)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 100; ++i) list.append(i);
+			list.save("TestMapRejectsBadFiles.bin");
+
+			Assert::ExpectException<Exception::InvalidFileFormat>([] { MutableList<double>::mapFile("TestMapRejectsBadFiles.bin"); });
+			Assert::ExpectException<Exception::FileException>([] { MutableList<int>::mapFile("TestMapRejectsBadFiles.missing"); });
+
+			// Damage one item, only verifying notices.
+			{
+				std::fstream file("TestMapRejectsBadFiles.bin", std::ios::binary | std::ios::in | std::ios::out);
+				file.seekp(-1, std::ios::end);
+				file.put(7);
+			}
+			Assert::AreEqual(100, MutableList<int>::mapFile("TestMapRejectsBadFiles.bin").getLength());
+			Assert::ExpectException<Exception::InvalidFileFormat>([] { MutableList<int>::mapFile("TestMapRejectsBadFiles.bin", true); });
+
+			// Truncate the payload.
+			{
+				std::ofstream file("TestMapRejectsBadFiles.bin", std::ios::binary | std::ios::trunc);
+				const char header[64] = {};
+				file.write(header, sizeof(header));
+			}
+			Assert::ExpectException<Exception::InvalidFileFormat>([] { MutableList<int>::mapFile("TestMapRejectsBadFiles.bin"); });
+
+			std::remove("TestMapRejectsBadFiles.bin");
+		}
+	};
+}
@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "CppUnitTest.h"
 
+#include <string>
+
 #include "..\MyListCpp\ImmutableList.h"
 #include "StubEnumerator.h"
 
@@ -31,6 +33,54 @@ namespace MyListTests
 			Assert::AreEqual(false, map.moveNext());
 			Assert::AreEqual('2', map.getCurrent());
 		}
+
+		TEST_METHOD(TestSizeHintPassedThrough)
+		{
+			int input[] = { 1, 2, 3 };
+			ImmutableList<int> list(input, sizeof(input) / sizeof(int));
+			MapEnumerator<int, char> map(list.getEnumerator(), [](int x){return static_cast<char>(x + '0'); });
+
+			Assert::IsTrue(map.getSizeHint().getKind() == Enumerator::SizeHint::Exact);
+			Assert::AreEqual(3, map.getSizeHint().getCount());
+			map.moveNext();
+			Assert::AreEqual(2, map.getSizeHint().getCount());
+
+			auto stub = std::make_shared<StubEnumerator<int>>(true, 2);
+			MapEnumerator<int, char> unknown(stub, [](int x){return static_cast<char>(x + '0'); });
+			Assert::IsTrue(unknown.getSizeHint().getKind() == Enumerator::SizeHint::Unknown);
+		}
+
+		TEST_METHOD(TestCloneMapsFromItsInput)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+			MapEnumerator<int, int> map(list.getEnumerator(), [](int x){return x * 10 + 1; });
+			map.moveNext();
+			map.moveNext();
+			Assert::AreEqual(21, map.getCurrent());
+
+			// The clone goes on from the same item and maps it again.
+			auto clone = map.clone();
+			Assert::AreEqual(21, clone->getCurrent());
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(31, clone->getCurrent());
+			Assert::AreEqual(21, map.getCurrent());
+		}
+	};
+
+	/**
+	 * \brief Items without a default constructor, one trivially copyable and one not.
+	 */
+	struct Point
+	{
+		explicit Point(int x) : x(x){}
+		int x;
+	};
+
+	struct Label
+	{
+		explicit Label(const std::string & text) : text(text){}
+		std::string text;
 	};
 
 	TEST_CLASS(TestMap)
@@ -56,6 +106,74 @@ namespace MyListTests
 			Assert::AreEqual(input[1] * 3, enumerator->getCurrent());
 		}
 
+		TEST_METHOD(TestMapFunctor)
+		{
+			struct Scale
+			{
+				int factor;
+				int operator()(int x) const { return x * factor; }
+			};
+
+			int input[] = { 1, 2 };
+			LazyList<int> list = ImmutableList<int>(input, sizeof(input) / sizeof(int)).map<int>([](int x){return x; });
+			Scale scale = { 5 };
+			auto map = list.map<int>(scale);
+
+			auto enumerator = map.getEnumerator();
+			Assert::AreEqual(true, enumerator->moveNext());
+			Assert::AreEqual(5, enumerator->getCurrent());
+			Assert::AreEqual(true, enumerator->moveNext());
+			Assert::AreEqual(10, enumerator->getCurrent());
+		}
+
+		TEST_METHOD(TestMapBatch)
+		{
+			int input[] = { 1, 2, 3 };
+			LazyList<int> list = ImmutableList<int>(input, sizeof(input) / sizeof(int)).map<int>([](int x){return x; });
+			auto enumerator = list.map<int>([](int x){return x * 3; }).getEnumerator();
+
+			int batch[4];
+			Assert::AreEqual(3, enumerator->nextBatch(batch, 4));
+			Assert::AreEqual(3, batch[0]);
+			Assert::AreEqual(9, batch[2]);
+			Assert::AreEqual(0, enumerator->nextBatch(batch, 4));
+		}
+
+		TEST_METHOD(TestMapOncePerPosition)
+		{
+			int input[] = { 1, 2 };
+			ImmutableList<int> list(input, 2);
+			int calls = 0;
+			auto func = [&calls](int x){++calls; return x * 3; };
+			MapEnumerator<int, int, decltype(func)> map(list.getEnumerator(), func);
+
+			map.moveNext();
+			Assert::AreEqual(3, map.getCurrent());
+			Assert::AreEqual(3, map.getCurrent());
+			Assert::AreEqual(1, calls);
+			map.moveNext();
+			Assert::AreEqual(6, map.getCurrent());
+			Assert::AreEqual(2, calls);
+		}
+
+		TEST_METHOD(TestMapNoDefaultConstructor)
+		{
+			Point points[] = { Point(1), Point(2), Point(3) };
+			ImmutableList<Point> list(points, 3);
+			IEnumerable<Point> & enumerable = list;
+			LazyList<Point> doubled = enumerable.map<Point>([](const Point & p){return Point(p.x * 2); });
+			Assert::AreEqual(12, doubled.map<int>([](const Point & p){return p.x; }).foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::AreEqual(4, doubled.toImmutableList().getTail().getHead().x);
+
+			Label labels[] = { Label("a"), Label("bc") };
+			ImmutableList<Label> names(labels, 2);
+			IEnumerable<Label> & named = names;
+			LazyList<Label> upper = named.map<Label>([](const Label & l){return Label(l.text + "!"); });
+			Assert::AreEqual(std::string("bc!"), upper.toImmutableList().getTail().getHead().text);
+			Assert::AreEqual(5, upper.map<int>([](const Label & l){return static_cast<int>(l.text.size()); })
+				.foldLeft<int>(0, [](int a, int x){return a + x; }));
+		}
+
 		TEST_METHOD(TestMapEmptyList)
 		{
 			ImmutableList<int> list;
@@ -1,6 +1,10 @@
 #include "stdafx.h"
 #include "CppUnitTest.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "../MyListCpp/MutableList.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -9,6 +13,59 @@ using namespace MyList;
 
 namespace MyListTests
 {
+	/**
+	 * \brief Item counting its constructions and destructions.
+	 */
+	struct Counted
+	{
+		static int constructed;
+		static int destroyed;
+
+		Counted(){ ++constructed; }
+		Counted(const Counted &){ ++constructed; }
+		~Counted(){ ++destroyed; }
+	};
+
+	int Counted::constructed = 0;
+	int Counted::destroyed = 0;
+
+	/**
+	 * \brief Item counting its copies and moves.
+	 */
+	struct Tracked
+	{
+		static int copies;
+		static int moves;
+
+		explicit Tracked(int value = 0) : value(value){}
+		Tracked(const Tracked & other) : value(other.value){ ++copies; }
+		Tracked(Tracked && other) : value(other.value){ ++moves; }
+		Tracked & operator=(const Tracked & other){ value = other.value; ++copies; return *this; }
+		Tracked & operator=(Tracked && other){ value = other.value; ++moves; return *this; }
+
+		int value;
+	};
+
+	int Tracked::copies = 0;
+	int Tracked::moves = 0;
+
+	/**
+	 * \brief Item without a default constructor, counting its copies.
+	 */
+	struct Named
+	{
+		static int copies;
+
+		explicit Named(const std::string & text) : text(text){}
+		Named(const Named & other) : text(other.text){ ++copies; }
+		Named(Named && other) : text(std::move(other.text)){}
+		Named & operator=(const Named & other){ text = other.text; ++copies; return *this; }
+
+		std::string text;
+	};
+
+	int Named::copies = 0;
+
 	TEST_CLASS(TestMutableList)
 	{
 	public:
@@ -45,6 +102,40 @@ namespace MyListTests
 			Assert::AreEqual(input[1], enumerator->getCurrent());
 		}
 
+		TEST_METHOD(TestEnumeratorBatch)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			auto enumerator = list.getEnumerator();
+			int batch[2];
+			Assert::AreEqual(2, enumerator->nextBatch(batch, 2));
+			Assert::AreEqual(1, batch[0]);
+			Assert::AreEqual(2, batch[1]);
+
+			Assert::AreEqual(true, enumerator->moveNext());
+			Assert::AreEqual(3, enumerator->getCurrent());
+			Assert::AreEqual(0, enumerator->nextBatch(batch, 2));
+		}
+
+		TEST_METHOD(TestEnumeratorClone)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			// A clone goes on from the same position, then moves on its own.
+			auto enumerator = list.getEnumerator();
+			enumerator->moveNext();
+			enumerator->moveNext();
+			auto clone = enumerator->clone();
+			Assert::AreEqual(2, clone->getCurrent());
+			Assert::AreEqual(1, clone->getSizeHint().getCount());
+			Assert::IsTrue(clone->moveNext());
+			Assert::AreEqual(3, clone->getCurrent());
+			Assert::IsFalse(clone->moveNext());
+			Assert::AreEqual(2, enumerator->getCurrent());
+		}
+
 		TEST_METHOD(TestReverse)
 		{
 			int input[] = { 1, 2 };
@@ -123,6 +214,18 @@ namespace MyListTests
 			Assert::AreEqual(2, filteredList.getLength());
 		}
 
+		TEST_METHOD(TestLargeToMutableList)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 1000; ++i) list.append(i);
+
+			LazyList<int> lazyList = list.map<int>([](int x){return x; });
+			auto copy = lazyList.filter([](int x){return (x % 3) == 0; }).toMutableList();
+
+			Assert::AreEqual(334, copy.getLength());
+			Assert::AreEqual(999, copy[333]);
+		}
+
 		TEST_METHOD(TestImmutableListToMutable)
 		{
 			int input[] = { 1, 2, 3, 4 };
@@ -139,5 +242,456 @@ namespace MyListTests
 
 			Assert::AreEqual(0, filteredList.getLength());
 		}
+		TEST_METHOD(TestPop)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, 3);
+
+			Assert::AreEqual(3, list.pop());
+			Assert::AreEqual(2, list.pop());
+			Assert::AreEqual(1, list.getLength());
+			Assert::AreEqual(1, list.pop());
+			Assert::ExpectException<Exception::EmptyListException>([&list] { return list.pop(); });
+		}
+
+		TEST_METHOD(TestMoveLeavesEmptyList)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, 3);
+			MutableList<int> moved(std::move(list));
+
+			Assert::AreEqual(3, moved.getLength());
+			Assert::AreEqual(0, list.getLength());
+
+			// Moved from list is still usable.
+			list.append(7);
+			Assert::AreEqual(7, list[0]);
+			Assert::AreEqual(1, moved[0]);
+		}
+
+		TEST_METHOD(TestStrings)
+		{
+			MutableList<std::string> list(1);
+			for (int i = 0; i < 100; ++i) list.append(std::to_string(i));
+
+			// Append own item while growing.
+			list.append(list[0]);
+
+			MutableList<std::string> copy(list);
+			copy[0] = "changed";
+
+			Assert::AreEqual(101, list.getLength());
+			Assert::AreEqual(std::string("0"), list[0]);
+			Assert::AreEqual(std::string("99"), list[99]);
+			Assert::AreEqual(std::string("0"), list[100]);
+			Assert::AreEqual(std::string("changed"), copy[0]);
+			Assert::AreEqual(std::string("0"), copy.pop());
+
+			list = copy;
+			Assert::AreEqual(100, list.getLength());
+			Assert::AreEqual(std::string("changed"), list[0]);
+
+			auto longer = list.filter([](const std::string & x){return x.size() == 2; }).toMutableList();
+			Assert::AreEqual(90, longer.getLength());
+			Assert::AreEqual(std::string("10"), longer[0]);
+		}
+
+		TEST_METHOD(TestEnumeratorKeepsItemsWhileListGrows)
+		{
+			MutableList<std::string> list(2);
+			list.append("a");
+			list.append("b");
+			auto enumerator = list.getEnumerator();
+
+			// Growth and pop must leave the buffer read by the enumerator intact.
+			list.append("c");
+			list.pop();
+			list.pop();
+
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(std::string("a"), enumerator->getCurrent());
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(std::string("b"), enumerator->getCurrent());
+			Assert::IsFalse(enumerator->moveNext());
+		}
+
+		TEST_METHOD(TestCapacityConstructsNothing)
+		{
+			Counted::constructed = 0;
+			Counted::destroyed = 0;
+			{
+				MutableList<Counted> list(100);
+				Assert::AreEqual(0, Counted::constructed);
+
+				list.append(Counted());
+				list.append(Counted());
+			}
+			Assert::AreEqual(Counted::constructed, Counted::destroyed);
+		}
+		TEST_METHOD(TestFactorGrowth)
+		{
+			MutableList<int, Memory::FactorGrowth<3, 2> > list(2);
+			for (int i = 0; i < 3; ++i) list.append(i);
+			Assert::AreEqual(3, list.getCapacity());
+			list.append(3);
+			Assert::AreEqual(4, list.getCapacity());
+			list.append(4);
+			Assert::AreEqual(6, list.getCapacity());
+			Assert::AreEqual(4, list[4]);
+		}
+
+		TEST_METHOD(TestIncrementGrowth)
+		{
+			MutableList<int, Memory::IncrementGrowth<10> > list(1);
+			for (int i = 0; i < 12; ++i) list.append(i);
+			Assert::AreEqual(21, list.getCapacity());
+			Assert::AreEqual(11, list[11]);
+		}
+
+		TEST_METHOD(TestPageGrowth)
+		{
+			MutableList<int, Memory::PageGrowth<4096> > list(1);
+			list.append(1);
+			list.append(2);
+			Assert::AreEqual(1024, list.getCapacity());
+			for (int i = 2; i < 1025; ++i) list.append(i + 1);
+			Assert::AreEqual(2048, list.getCapacity());
+			Assert::AreEqual(1025, list[1024]);
+		}
+
+		TEST_METHOD(TestRemapGrowth)
+		{
+			MutableList<int, Memory::RemapGrowth<> > list;
+			for (int i = 0; i < 4000000; ++i) list.append(i);
+
+			// An enumerator keeps the old buffer, growth then copies.
+			auto enumerator = list.getEnumerator();
+			for (int i = 4000000; i < 5000000; ++i) list.append(i);
+
+			Assert::AreEqual(5000000, list.getLength());
+			long long sum = list.foldLeft<long long>(0, [](long long a, int x){return a + x; });
+			Assert::IsTrue(sum == 5000000LL * 4999999LL / 2);
+			Assert::AreEqual(4999999, list.pop());
+
+			int count = 0;
+			while (enumerator->moveNext())
+			{
+				if (enumerator->getCurrent() != count) break;
+				++count;
+			}
+			Assert::AreEqual(4000000, count);
+
+			MutableList<std::string, Memory::RemapGrowth<> > strings;
+			for (int i = 0; i < 100; ++i) strings.append(std::to_string(i));
+			Assert::AreEqual(std::string("99"), strings[99]);
+		}
+		TEST_METHOD(TestInlineItems)
+		{
+			typedef MutableList<std::string, Memory::DoublingGrowth, 4> SmallList;
+			SmallList list;
+			Assert::AreEqual(4, list.getCapacity());
+			for (int i = 0; i < 4; ++i) list.append(std::to_string(i));
+			Assert::AreEqual(4, list.getCapacity());
+
+			SmallList copy(list);
+			SmallList moved(std::move(copy));
+			Assert::AreEqual(0, copy.getLength());
+			Assert::AreEqual(std::string("3"), moved[3]);
+			Assert::AreEqual(std::string("3"), moved.pop());
+
+			// Spill to the heap, then back into the inline slots.
+			list.append("4");
+			Assert::AreEqual(8, list.getCapacity());
+			Assert::AreEqual(std::string("4"), list[4]);
+			list.pop();
+			list.setCapacity(4);
+			Assert::AreEqual(4, list.getCapacity());
+			Assert::AreEqual(std::string("0"), list[0]);
+			Assert::AreEqual(std::string("3"), list[3]);
+
+			list = moved;
+			Assert::AreEqual(3, list.getLength());
+			Assert::AreEqual(std::string("012"), list.foldLeft<std::string>("", [](std::string a, const std::string & x){return a + x; }));
+		}
+
+		TEST_METHOD(TestInlineItemsOutliveList)
+		{
+			typedef MutableList<int, Memory::DoublingGrowth, 4> SmallList;
+			std::shared_ptr<IEnumerator<int> > enumerator;
+			auto evens = [](){
+				SmallList list;
+				for (int i = 0; i < 4; ++i) list.append(i);
+				return list.filter([](int x){return (x % 2) == 0; });
+			}();
+			{
+				SmallList list;
+				list.append(7);
+				enumerator = list.getEnumerator();
+			}
+
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(7, enumerator->getCurrent());
+			Assert::IsFalse(enumerator->moveNext());
+
+			auto result = evens.toMutableList();
+			Assert::AreEqual(2, result.getLength());
+			Assert::AreEqual(2, result[1]);
+		}
+		TEST_METHOD(TestEmplaceAndMoveAppend)
+		{
+			MutableList<Tracked> list(4);
+			Tracked::copies = 0;
+			Tracked::moves = 0;
+
+			list.emplaceBack(1);
+			list.append(Tracked(2));
+			Assert::AreEqual(0, Tracked::copies);
+			Assert::AreEqual(1, Tracked::moves);
+
+			std::string text("moved");
+			MutableList<std::string> strings;
+			strings.append(std::move(text));
+			strings.emplaceBack(3, 'x');
+			Assert::IsTrue(text.empty());
+			Assert::AreEqual(std::string("moved"), strings[0]);
+			Assert::AreEqual(std::string("xxx"), strings[1]);
+
+			// Emplace from an own item while growing.
+			MutableList<std::string> full(1);
+			full.append("a");
+			full.emplaceBack(full[0]);
+			Assert::AreEqual(std::string("a"), full[1]);
+		}
+
+		TEST_METHOD(TestAppendRange)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(2);
+			list.appendRange(input, 3);
+			Assert::AreEqual(3, list.getLength());
+			Assert::AreEqual(4, list.getCapacity());
+
+			// Append own items while growing.
+			list.appendRange(&list[0], 3);
+			Assert::AreEqual(6, list.getLength());
+			Assert::AreEqual(1, list[3]);
+			Assert::AreEqual(3, list[5]);
+		}
+
+		TEST_METHOD(TestAppendAll)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, 3);
+			ImmutableList<int> immutable(input, 3);
+
+			list.appendAll(list);
+			list.appendAll(immutable);
+			Assert::AreEqual(9, list.getLength());
+			Assert::AreEqual(18, list.foldLeft<int>(0, [](int a, int x){return a + x; }));
+
+			MutableList<std::string> strings;
+			std::string words[] = { "a", "b" };
+			strings.appendAll(ImmutableList<std::string>(words, 2));
+			strings.appendAll(strings);
+			Assert::AreEqual(4, strings.getLength());
+			Assert::AreEqual(std::string("b"), strings[3]);
+		}
+
+		TEST_METHOD(TestAppendAllConstructsOnce)
+		{
+			Named names[] = { Named("a"), Named("b"), Named("c") };
+			ImmutableList<Named> source(names, 3);
+
+			// Every item is copied once into its slot, nothing is default constructed first.
+			Named::copies = 0;
+			MutableList<Named> list(&source);
+			Assert::AreEqual(3, Named::copies);
+			Assert::AreEqual(std::string("c"), list.at(2).text);
+
+			MutableList<Named> twice;
+			twice.reserve(6);
+			twice.appendAll(source);
+			twice.appendAll(source);
+			Assert::AreEqual(9, Named::copies);
+			Assert::AreEqual(6, twice.getLength());
+			Assert::AreEqual(std::string("a"), twice.at(3).text);
+		}
+
+		TEST_METHOD(TestBoundedSourceGrows)
+		{
+			MutableList<int> big;
+			MutableList<std::string> words;
+			for (int i = 0; i < 100000; ++i) big.append(i);
+			for (int i = 0; i < 1000; ++i) words.append(std::to_string(i));
+
+			// A filter only bounds its length, a selective one must not leave the list sized for the whole source.
+			LazyList<int> few = big.filter([](int x){return x < 10; }).toLazyList();
+			MutableList<int> appended;
+			appended.appendAll(few);
+			Assert::AreEqual(10, appended.getLength());
+			Assert::IsTrue(appended.getCapacity() < 100);
+
+			MutableList<int> constructed(&few);
+			Assert::AreEqual(10, constructed.getLength());
+			Assert::IsTrue(constructed.getCapacity() < 100);
+
+			MutableList<std::string> shortWords = words.filter([](const std::string & w){return w.size() == 1; }).toMutableList();
+			Assert::AreEqual(10, shortWords.getLength());
+			Assert::IsTrue(shortWords.getCapacity() < 100);
+		}
+
+		TEST_METHOD(TestFindCopiesOnlyTheMatch)
+		{
+			MutableList<Tracked> list;
+			for (int i = 0; i < 10; ++i) list.emplaceBack(i);
+
+			IEnumerable<Tracked> & enumerable = list;
+			Tracked found;
+			Tracked::copies = 0;
+			Assert::IsTrue(enumerable.find([](const Tracked & item){return item.value == 7; }, found));
+			Assert::AreEqual(7, found.value);
+			Assert::AreEqual(1, Tracked::copies);
+		}
+
+		TEST_METHOD(TestReserveAndShrink)
+		{
+			MutableList<int> list(2);
+			list.reserve(100);
+			Assert::AreEqual(100, list.getCapacity());
+			list.reserve(10);
+			Assert::AreEqual(100, list.getCapacity());
+
+			for (int i = 0; i < 5; ++i) list.append(i);
+			list.shrinkToFit();
+			Assert::AreEqual(5, list.getCapacity());
+			Assert::AreEqual(4, list[4]);
+
+			MutableList<std::string, Memory::DoublingGrowth, 4> small;
+			small.reserve(32);
+			small.append("x");
+			small.shrinkToFit();
+			Assert::AreEqual(4, small.getCapacity());
+			Assert::AreEqual(std::string("x"), small[0]);
+		}
+		TEST_METHOD(TestSnapshotIgnoresWrites)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, 3);
+			auto enumerator = list.getEnumerator();
+			auto doubled = list.map<int>([](int x){return x * 2; });
+
+			list[0] = 10;
+			list.append(4);
+			list.pop();
+			list.pop();
+
+			Assert::AreEqual(10, list[0]);
+			Assert::AreEqual(2, list.getLength());
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(1, enumerator->getCurrent());
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::IsTrue(enumerator->moveNext());
+			Assert::AreEqual(3, enumerator->getCurrent());
+			Assert::IsFalse(enumerator->moveNext());
+			Assert::AreEqual(12, doubled.foldLeft<int>(0, [](int a, int x){return a + x; }));
+		}
+
+		TEST_METHOD(TestSnapshotReadOnOtherThreads)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 100000; ++i) list.append(i);
+			const long long expected = 100000LL * 99999LL / 2;
+
+			std::vector<long long> sums(4, 0);
+			std::vector<std::thread> readers;
+			for (int t = 0; t < 4; ++t)
+			{
+				std::shared_ptr<IEnumerator<int> > enumerator = list.getEnumerator();
+				readers.push_back(std::thread([enumerator, &sums, t](){
+					while (enumerator->moveNext()) sums[t] += enumerator->getCurrent();
+				}));
+			}
+
+			// Writes go to a copy while the snapshots are alive.
+			for (int i = 0; i < 100000; i += 7) list[i] = -1;
+			for (int i = 0; i < 1000; ++i) list.append(i);
+
+			for (size_t t = 0; t < readers.size(); ++t) readers[t].join();
+			for (size_t t = 0; t < sums.size(); ++t) Assert::IsTrue(sums[t] == expected);
+			Assert::AreEqual(-1, list[7]);
+		}
+
+		TEST_METHOD(TestPipelineMovesComputedItems)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 10; ++i) list.append(i);
+			Tracked::copies = 0;
+
+			auto mapped = list.map<Tracked>([](int x){return Tracked(x); })
+				.filter([](const Tracked & x){return x.value % 2 == 0; })
+				.map<Tracked>([](Tracked x){x.value *= 10; return x; })
+				.toMutableList();
+			auto immutable = list.map<Tracked>([](int x){return Tracked(x); }).toImmutableList();
+
+			Assert::AreEqual(0, Tracked::copies);
+			Assert::AreEqual(5, mapped.getLength());
+			Assert::AreEqual(80, mapped[4].value);
+			Assert::AreEqual(10, immutable.getLength());
+		}
+
+		TEST_METHOD(TestFoldsMoveAccumulator)
+		{
+			MutableList<std::string> words;
+			for (int i = 0; i < 100; ++i) words.append("ab");
+			MutableList<Tracked> items(10);
+			for (int i = 0; i < 10; ++i) items.emplaceBack(i);
+			Tracked::copies = 0;
+
+			// Accumulator and items are never copied, through a pipeline or a type-erased LazyList.
+			auto sum = [](Tracked a, const Tracked & x){a.value += x.value; return a; };
+			Assert::AreEqual(45, items.foldLeft<Tracked>(Tracked(), sum).value);
+			LazyList<Tracked> lazy = items.filter([](const Tracked & x){return x.value > 4; });
+			Assert::AreEqual(35, lazy.foldLeft<Tracked>(Tracked(), sum).value);
+			Assert::AreEqual(0, Tracked::copies);
+
+			std::string joined = words.foldLeft<std::string>(std::string(), [](std::string a, const std::string & x){return a.append(x); });
+			Assert::AreEqual(static_cast<size_t>(200), joined.size());
+		}
+
+		TEST_METHOD(TestEnumeratorReadsInPlace)
+		{
+			std::string input[] = { "a", "b" };
+			MutableList<std::string> list(input, 2);
+			auto enumerator = list.getEnumerator();
+			enumerator->moveNext();
+
+			const std::string & first = enumerator->getCurrent();
+			Assert::IsTrue(&first == &enumerator->getCurrent());
+			Assert::AreEqual(std::string("a"), first);
+		}
+
+		TEST_METHOD(TestMoveIntoImmutableList)
+		{
+			MutableList<Tracked> list;
+			for (int i = 0; i < 20; ++i) list.emplaceBack(i);
+			Tracked::copies = 0;
+
+			ImmutableList<Tracked> immutable(std::move(list));
+			Assert::AreEqual(0, Tracked::copies);
+			Assert::AreEqual(0, list.getLength());
+			Assert::AreEqual(20, immutable.getLength());
+			Assert::AreEqual(0, immutable.getHead().value);
+
+			// Items a snapshot reads are copied, the snapshot keeps its values.
+			MutableList<Tracked> shared;
+			for (int i = 0; i < 20; ++i) shared.emplaceBack(i);
+			auto snapshot = shared.getEnumerator();
+			Tracked::copies = 0;
+			ImmutableList<Tracked> copied(std::move(shared));
+			Assert::AreEqual(20, Tracked::copies);
+			snapshot->moveNext();
+			Assert::AreEqual(0, snapshot->getCurrent().value);
+			Assert::AreEqual(20, copied.getLength());
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../MyListCpp/ImmutableList.h"
+#include "../MyListCpp/MutableList.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestParallel)
+	{
+	public:
+		TEST_METHOD(TestReduceMatchesFoldLeft)
+		{
+			MutableList<int> list(200000);
+			for (int i = 0; i < 200000; ++i)
+			{
+				list.append(i % 1000);
+			}
+			Parallel::ThreadPool pool(4);
+
+			int sum = list.reduce(0, [](int a, int b){return a + b; }, pool);
+			int simdSum = list.reduce(0, Simd::Sum<int>(), pool);
+
+			Assert::AreEqual(list.foldLeft<int>(0, [](int a, int x){return a + x; }), sum);
+			Assert::AreEqual(sum, simdSum);
+		}
+
+		TEST_METHOD(TestParallelFoldDifferentType)
+		{
+			MutableList<int> list(100000);
+			for (int i = 0; i < 100000; ++i)
+			{
+				list.append(i);
+			}
+			Parallel::ThreadPool pool(3);
+
+			long long sum = list.parallelFold<long long>(0, [](long long a, int x){return a + x; }, [](long long a, long long b){return a + b; }, pool);
+
+			Assert::AreEqual(4999950000LL, sum);
+		}
+
+		TEST_METHOD(TestParallelFoldIsReproducible)
+		{
+			MutableList<double> list(100000);
+			for (int i = 0; i < 100000; ++i)
+			{
+				list.append(1.0 / (i + 1));
+			}
+			Parallel::ThreadPool pool(8);
+			auto add = [](double a, double b){return a + b; };
+
+			double first = list.reduce(0.0, add, pool);
+			for (int run = 0; run < 5; ++run)
+			{
+				Assert::AreEqual(first, list.reduce(0.0, add, pool));
+			}
+		}
+
+		TEST_METHOD(TestEmptyReturnsIdentity)
+		{
+			MutableList<int> list;
+			Parallel::ThreadPool pool(2);
+
+			Assert::AreEqual(7, list.reduce(7, [](int a, int b){return a + b; }, pool));
+		}
+
+		TEST_METHOD(TestExceptionPropagates)
+		{
+			MutableList<int> list(50000);
+			for (int i = 0; i < 50000; ++i)
+			{
+				list.append(i);
+			}
+			Parallel::ThreadPool pool(4);
+
+			bool thrown = false;
+			try
+			{
+				list.reduce(0, [](int a, int b) -> int { if (b == 40000) throw std::runtime_error("fail"); return a + b; }, pool);
+			}
+			catch (const std::runtime_error &)
+			{
+				thrown = true;
+			}
+
+			Assert::IsTrue(thrown);
+			// Pool is still usable after a failed batch.
+			Assert::AreEqual(49999, list.reduce(0, Simd::Max<int>(), pool));
+		}
+
+		TEST_METHOD(TestParallelPipelineKeepsOrder)
+		{
+			MutableList<int> list(100000);
+			for (int i = 0; i < 100000; ++i)
+			{
+				list.append(i);
+			}
+			Parallel::ThreadPool pool(4);
+
+			MutableList<int> expected = list.filter([](int x){return x % 3 == 0; }).map<int>([](int x){return x * 2; }).toMutableList();
+			MutableList<int> actual = list.parallel(pool).filter([](int x){return x % 3 == 0; }).map<int>([](int x){return x * 2; }).toMutableList();
+
+			Assert::AreEqual(expected.getLength(), actual.getLength());
+			for (int i = 0; i < expected.getLength(); ++i)
+			{
+				Assert::AreEqual(expected.at(i), actual.at(i));
+			}
+		}
+
+		TEST_METHOD(TestParallelOverReversedView)
+		{
+			MutableList<int> list(100000);
+			for (int i = 0; i < 100000; ++i)
+			{
+				list.append(i);
+			}
+			Parallel::ThreadPool pool(4);
+
+			MutableList<int> actual = list.map<int>([](int x){return x * 2; }).reverse().parallel(pool).filter([](int x){return x % 3 == 0; }).toMutableList();
+
+			Assert::AreEqual(33334, actual.getLength());
+			for (int i = 0; i < actual.getLength(); ++i)
+			{
+				Assert::AreEqual(2 * (99999 - 3 * i), actual.at(i));
+			}
+		}
+
+		TEST_METHOD(TestParallelPipelineUnordered)
+		{
+			MutableList<int> list(50000);
+			for (int i = 0; i < 50000; ++i)
+			{
+				list.append(i);
+			}
+			Parallel::ThreadPool pool(4);
+
+			MutableList<int> result = list.filter(Simd::GreaterThan<int>(999)).parallel(pool).toUnorderedMutableList();
+
+			std::vector<int> values;
+			for (int i = 0; i < result.getLength(); ++i)
+			{
+				values.push_back(result.at(i));
+			}
+			std::sort(values.begin(), values.end());
+			Assert::AreEqual(49000, static_cast<int>(values.size()));
+			for (int i = 0; i < 49000; ++i)
+			{
+				Assert::AreEqual(1000 + i, values[i]);
+			}
+		}
+
+		TEST_METHOD(TestParallelImmutableListSegments)
+		{
+			std::vector<int> input(10000);
+			for (int i = 0; i < 10000; ++i)
+			{
+				input[i] = i;
+			}
+			ImmutableList<int> list(input.data(), 10000);
+			Parallel::ThreadPool pool(3);
+
+			MutableList<int> result = list.parallel(pool).map<int>([](int x){return x + 1; }).filter([](int x){return x % 2 == 0; }).toMutableList();
+
+			Assert::AreEqual(5000, result.getLength());
+			for (int i = 0; i < 5000; ++i)
+			{
+				Assert::AreEqual(2 * (i + 1), result.at(i));
+			}
+		}
+
+		TEST_METHOD(TestParallelEmptyList)
+		{
+			MutableList<int> list;
+			ImmutableList<int> immutable;
+			Parallel::ThreadPool pool(2);
+
+			Assert::AreEqual(0, list.parallel(pool).map<int>([](int x){return x; }).toMutableList().getLength());
+			Assert::AreEqual(0, immutable.parallel(pool).toUnorderedMutableList().getLength());
+		}
+	};
+}
@@ -0,0 +1,255 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "..\MyListCpp\ImmutableList.h"
+#include "../MyListCpp/MutableList.h"
+#include "../MyListCpp/ChunkedList.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	TEST_CLASS(TestPipeline)
+	{
+	public:
+		TEST_METHOD(TestImmutableFilterMapFold)
+		{
+			int input[] = { 1, 2, 3, 4 };
+			ImmutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			int sum = list.filter([](int x){return (x % 2) == 0; })
+				.map<int>([](int x){return x * 10; })
+				.foldLeft<int>(0, [](int a, int x){return a + x; });
+
+			Assert::AreEqual(60, sum);
+		}
+
+		TEST_METHOD(TestMutableFilterMapFold)
+		{
+			int input[] = { 1, 2, 3, 4 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			int sum = list.filter([](int x){return (x % 2) == 1; })
+				.map<int>([](int x){return x * 10; })
+				.foldLeft<int>(0, [](int a, int x){return a + x; });
+
+			Assert::AreEqual(40, sum);
+		}
+
+		TEST_METHOD(TestToMutableListKeepsOrder)
+		{
+			int input[] = { 1, 2, 3, 4, 5 };
+			ImmutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			auto result = list.map<int>([](int x){return x * x; }).toMutableList();
+
+			Assert::AreEqual(5, result.getLength());
+			Assert::AreEqual(1, result[0]);
+			Assert::AreEqual(25, result[4]);
+		}
+
+		TEST_METHOD(TestToImmutableListKeepsOrder)
+		{
+			int input[] = { 1, 2, 3, 4, 5 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			auto result = list.filter([](int x){return x > 2; }).toImmutableList();
+
+			Assert::AreEqual(3, result.getLength());
+			Assert::AreEqual(3, result.getHead());
+			Assert::AreEqual(5, result.reverse().getHead());
+		}
+
+		TEST_METHOD(TestConvertToLazyList)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+
+			LazyList<int> lazy = list.map<int>([](int x){return x + 1; });
+			auto enumerator = lazy.getEnumerator();
+
+			Assert::AreEqual(true, enumerator->moveNext());
+			Assert::AreEqual(2, enumerator->getCurrent());
+			Assert::AreEqual(true, enumerator->moveNext());
+			Assert::AreEqual(true, enumerator->moveNext());
+			Assert::AreEqual(4, enumerator->getCurrent());
+			Assert::AreEqual(false, enumerator->moveNext());
+
+			// Should still point to end of list.
+			Assert::AreEqual(4, enumerator->getCurrent());
+		}
+
+		TEST_METHOD(TestMapOverMutableListRandomAccess)
+		{
+			int input[] = { 1, 2, 3, 4, 5 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+			int calls = 0;
+			auto squares = list.map<int>([&calls](int x){++calls; return x * x; });
+
+			Assert::AreEqual(5, squares.getLength());
+			Assert::AreEqual(16, squares.at(3));
+			Assert::AreEqual(1, calls);
+			Assert::ExpectException<Exception::IndexOutOfBounds>([squares] { return squares.at(5); });
+
+			auto middle = squares.slice(1, 4);
+			Assert::AreEqual(3, middle.getLength());
+			Assert::AreEqual(4, middle.at(0));
+			Assert::AreEqual(29, middle.foldLeft<int>(0, [](int a, int x){return a + x; }));
+
+			auto reversed = squares.reverse();
+			Assert::AreEqual(25, reversed.at(0));
+			Assert::AreEqual(1, reversed.at(4));
+			auto result = reversed.slice(1, 3).toMutableList();
+			Assert::AreEqual(2, result.getLength());
+			Assert::AreEqual(16, result[0]);
+			Assert::AreEqual(9, result[1]);
+			Assert::AreEqual(1, reversed.reverse().at(0));
+			Assert::AreEqual(25, reversed.reverse().at(4));
+		}
+
+		TEST_METHOD(TestReverseIsSnapshot)
+		{
+			int input[] = { 1, 2, 3 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+			auto reversed = list.map<int>([](int x){return x; }).reverse();
+			list[0] = 10;
+
+			Assert::AreEqual(1, reversed.at(2));
+			Assert::AreEqual(3, reversed.toMutableList()[0]);
+		}
+
+		TEST_METHOD(TestShortCircuitTerminals)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 1000; ++i) list.append(i);
+			int calls = 0;
+			auto squares = list.map<int>([&calls](int x){++calls; return x * x; });
+
+			Assert::IsTrue(squares.any([](int x){return x > 100; }));
+			Assert::AreEqual(12, calls);
+
+			calls = 0;
+			Assert::IsFalse(squares.all([](int x){return x < 100; }));
+			Assert::AreEqual(11, calls);
+
+			calls = 0;
+			int found = 0;
+			Assert::IsTrue(squares.find([](int x){return x % 7 == 1 && x > 1; }, found));
+			Assert::AreEqual(36, found);
+			Assert::AreEqual(7, calls);
+			Assert::IsFalse(squares.filter([](int x){return x < 0; }).find([](int){return true; }, found));
+			Assert::AreEqual(36, found);
+
+			calls = 0;
+			Assert::AreEqual(0, squares.first());
+			Assert::AreEqual(1, calls);
+
+			Assert::IsFalse(MutableList<int>().filter([](int x){return x > 0; }).any([](int){return true; }));
+			Assert::IsTrue(MutableList<int>().filter([](int x){return x > 0; }).all([](int){return false; }));
+			Assert::ExpectException<Exception::EmptyListException>([] { return MutableList<int>().map<int>([](int x){return x; }).first(); });
+		}
+
+		TEST_METHOD(TestTakeSkipTakeWhile)
+		{
+			ImmutableList<int> list;
+			for (int i = 99; i >= 0; --i) list = list.prepend(i);
+			int calls = 0;
+			auto counted = list.map<int>([&calls](int x){++calls; return x; });
+
+			auto firstThree = counted.take(3).toMutableList();
+			Assert::AreEqual(3, firstThree.getLength());
+			Assert::AreEqual(2, firstThree[2]);
+			Assert::AreEqual(3, calls);
+			Assert::AreEqual(3, firstThree.getCapacity());
+
+			calls = 0;
+			auto middle = counted.skip(10).take(5).toMutableList();
+			Assert::AreEqual(5, middle.getLength());
+			Assert::AreEqual(10, middle[0]);
+			Assert::AreEqual(5, calls);
+
+			calls = 0;
+			Assert::AreEqual(10, counted.takeWhile([](int x){return x < 10; }).foldLeft<int>(0, [](int a, int){return a + 1; }));
+			Assert::AreEqual(11, calls);
+			Assert::AreEqual(3, list.takeWhile([](int x){return x < 3; }).toMutableList().getLength());
+
+			Assert::AreEqual(0, list.take(0).toMutableList().getLength());
+			Assert::AreEqual(0, list.skip(200).toMutableList().getLength());
+			Assert::AreEqual(100, list.take(200).toMutableList().getLength());
+			Assert::AreEqual(99, list.skip(99).first());
+		}
+
+		TEST_METHOD(TestTakeSkipKeepRandomAccess)
+		{
+			MutableList<int> list;
+			for (int i = 0; i < 100; ++i) list.append(i);
+			auto window = list.map<int>([](int x){return x * 2; }).skip(10).take(20);
+
+			Assert::AreEqual(20, window.getLength());
+			Assert::AreEqual(20, window.at(0));
+			Assert::AreEqual(58, window.at(19));
+			Assert::AreEqual(58, window.reverse().first());
+			Assert::AreEqual(5, window.slice(5, 10).getLength());
+			Assert::AreEqual(30, window.slice(5, 10).first());
+			Assert::AreEqual(90, list.skip(90).take(3).reverse().at(2));
+		}
+
+		TEST_METHOD(TestToMutableListPresized)
+		{
+			ImmutableList<int> list;
+			for (int i = 0; i < 1000; ++i) list = list.prepend(i);
+
+			// Exact hints allocate once at the final length, filters start small and grow.
+			auto mapped = list.map<int>([](int x){return x + 1; }).toMutableList();
+			Assert::AreEqual(1000, mapped.getCapacity());
+
+			LazyList<int> lazy = list.map<int>([](int x){return x + 1; });
+			auto materialized = lazy.toMutableList();
+			Assert::AreEqual(1000, materialized.getLength());
+			Assert::AreEqual(1000, materialized.getCapacity());
+
+			auto filtered = list.filter([](int x){return x < 10; }).toMutableList();
+			Assert::AreEqual(10, filtered.getLength());
+			Assert::IsTrue(filtered.getCapacity() < 1000);
+
+			ChunkedList<int> chunked(&materialized);
+			Assert::AreEqual(1000, MutableList<int>(&chunked).getCapacity());
+		}
+
+		TEST_METHOD(TestPipelineIsReusable)
+		{
+			int input[] = { 1, 2, 3 };
+			ImmutableList<int> list(input, sizeof(input) / sizeof(int));
+			auto pipeline = list.map<int>([](int x){return x * 2; });
+
+			Assert::AreEqual(12, pipeline.foldLeft<int>(0, [](int a, int x){return a + x; }));
+			Assert::AreEqual(12, pipeline.foldLeft<int>(0, [](int a, int x){return a + x; }));
+		}
+
+		TEST_METHOD(TestCapturingLambdas)
+		{
+			int input[] = { 1, 2, 3, 4 };
+			MutableList<int> list(input, sizeof(input) / sizeof(int));
+			int threshold = 2;
+			int lookup[] = { 0, 10, 20, 30, 40 };
+
+			int sum = list.filter([threshold](int x){return x > threshold; })
+				.map<int>([&lookup](int x){return lookup[x]; })
+				.foldLeft<int>(0, [](int a, int x){return a + x; });
+
+			Assert::AreEqual(70, sum);
+		}
+
+		TEST_METHOD(TestEmptyPipeline)
+		{
+			MutableList<int> list;
+			auto result = list.filter([](int x){return (x % 2) == 0; })
+				.map<int>([](int x){return x * 2; })
+				.toImmutableList();
+
+			Assert::AreEqual(0, result.getLength());
+		}
+	};
+}
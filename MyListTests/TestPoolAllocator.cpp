@@ -0,0 +1,134 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../MyListCpp/ImmutableList.h"
+#include "../MyListCpp/Memory/PoolAllocator.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	struct PoolItem
+	{
+		double value;
+		void * link;
+	};
+
+	/**
+	 * \brief Item of a size no other test allocates, so it has a pool of its own.
+	 */
+	struct ChurnItem
+	{
+		double values[5];
+	};
+
+	TEST_CLASS(TestPoolAllocator)
+	{
+	public:
+		TEST_METHOD(TestConsecutiveAllocationsAreAdjacent)
+		{
+			Memory::PoolAllocator<PoolItem> allocator;
+			std::vector<PoolItem *> items;
+			for (int i = 0; i < 8; ++i)
+			{
+				items.push_back(allocator.allocate(1));
+			}
+
+			int adjacent = 0;
+			for (int i = 1; i < 8; ++i)
+			{
+				if (items[i] == items[i - 1] + 1) ++adjacent;
+			}
+			for (int i = 0; i < 8; ++i)
+			{
+				allocator.deallocate(items[i], 1);
+			}
+
+			// A batch boundary may fall between two of them, at most once.
+			Assert::IsTrue(adjacent >= 6);
+		}
+
+		TEST_METHOD(TestFreeOnOtherThread)
+		{
+			Memory::PoolAllocator<PoolItem> allocator;
+			std::vector<PoolItem *> items;
+			for (int i = 0; i < 5000; ++i)
+			{
+				PoolItem * item = allocator.allocate(1);
+				item->value = i;
+				items.push_back(item);
+			}
+
+			std::thread consumer([&items, &allocator](){
+				for (size_t i = 0; i < items.size(); ++i)
+				{
+					allocator.deallocate(items[i], 1);
+				}
+			});
+			consumer.join();
+
+			PoolItem * item = allocator.allocate(1);
+			item->value = 1.5;
+			Assert::AreEqual(1.5, item->value);
+			allocator.deallocate(item, 1);
+		}
+
+		TEST_METHOD(TestExitingThreadHandsCacheBack)
+		{
+			Memory::PoolAllocator<ChurnItem> allocator;
+			std::vector<ChurnItem *> items;
+			for (int i = 0; i < 300; ++i)
+			{
+				items.push_back(allocator.allocate(1));
+			}
+
+			// Fewer than two batches, so the worker keeps every block in its cache until it exits.
+			std::thread worker([&allocator, &items]()
+			{
+				for (size_t i = 0; i < items.size(); ++i)
+				{
+					allocator.deallocate(items[i], 1);
+				}
+			});
+			worker.join();
+
+			std::set<ChurnItem *> freed(items.begin(), items.end());
+			std::vector<ChurnItem *> again;
+			bool reused = false;
+			for (int i = 0; i < 2 * POOL_BATCH_SIZE; ++i)
+			{
+				again.push_back(allocator.allocate(1));
+				if (freed.count(again.back())) reused = true;
+			}
+			for (size_t i = 0; i < again.size(); ++i)
+			{
+				allocator.deallocate(again[i], 1);
+			}
+			Assert::IsTrue(reused);
+		}
+
+		TEST_METHOD(TestLargeImmutableListFromPool)
+		{
+			// Kept short enough for a node by node teardown to fit in a 1 MB stack.
+			std::vector<int> input(4096);
+			for (int i = 0; i < 4096; ++i)
+			{
+				input[i] = i;
+			}
+
+			ImmutableList<int> list(input.data(), 4096);
+			ImmutableList<int> longer = list.prepend(-1);
+
+			Assert::AreEqual(4097, longer.getLength());
+			Assert::AreEqual(-1, longer.getHead());
+			long long sum = list.foldLeft<long long>(0, [](long long a, int x){return a + x; });
+			Assert::AreEqual(8386560LL, sum);
+		}
+	};
+}
@@ -0,0 +1,186 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "../MyListCpp/MutableList.h"
+#include "../MyListCpp/Simd/Kernels.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace MyList;
+
+namespace MyListTests
+{
+	/**
+	 * \brief Build input with values both sides of the comparison constants, length not a multiple of any lane count.
+	 */
+	static std::vector<int> makeInput(int length)
+	{
+		std::vector<int> input(length);
+		for (int i = 0; i < length; ++i)
+		{
+			input[i] = ((i * 37) % 23) - 11;
+		}
+		return input;
+	}
+
+	TEST_CLASS(TestSimd)
+	{
+	public:
+		TEST_METHOD_CLEANUP(RestoreInstructionSet)
+		{
+			Simd::limitInstructionSet(Simd::InstructionSetAvx512);
+		}
+
+		TEST_METHOD(TestFilterMatchesReference)
+		{
+			Simd::GreaterThan<int> predicate(2);
+			for (int level = Simd::InstructionSetScalar; level <= Simd::InstructionSetAvx512; ++level)
+			{
+				Simd::limitInstructionSet(static_cast<Simd::InstructionSet>(level));
+				for (int length = 0; length < 70; ++length)
+				{
+					std::vector<int> input = makeInput(length);
+					std::vector<int> expected(length + 1), actual(length + 1);
+					int expectedCount = Simd::Reference::filter(input.data(), length, expected.data(), predicate);
+					int actualCount = Simd::filter(input.data(), length, actual.data(), predicate);
+
+					Assert::AreEqual(expectedCount, actualCount);
+					for (int i = 0; i < expectedCount; ++i)
+					{
+						Assert::AreEqual(expected[i], actual[i]);
+					}
+					Assert::AreEqual(expectedCount, Simd::count(input.data(), length, predicate));
+				}
+			}
+		}
+
+		TEST_METHOD(TestFilterInPlace)
+		{
+			Simd::LessThan<int> predicate(0);
+			std::vector<int> input = makeInput(53);
+			std::vector<int> expected(53);
+			int expectedCount = Simd::Reference::filter(input.data(), 53, expected.data(), predicate);
+
+			int count = Simd::filter(input.data(), 53, input.data(), predicate);
+
+			Assert::AreEqual(expectedCount, count);
+			for (int i = 0; i < count; ++i)
+			{
+				Assert::AreEqual(expected[i], input[i]);
+			}
+		}
+
+		TEST_METHOD(TestMapAndReduceMatchReference)
+		{
+			Simd::Multiply<int> multiply(3);
+			Simd::Sum<int> sum;
+			Simd::Min<int> min;
+			Simd::Max<int> max;
+			for (int level = Simd::InstructionSetScalar; level <= Simd::InstructionSetAvx512; ++level)
+			{
+				Simd::limitInstructionSet(static_cast<Simd::InstructionSet>(level));
+				for (int length = 0; length < 70; ++length)
+				{
+					std::vector<int> input = makeInput(length);
+					std::vector<int> expected(length + 1), actual(length + 1);
+					Simd::Reference::map(input.data(), length, expected.data(), multiply);
+					Simd::map(input.data(), length, actual.data(), multiply);
+					for (int i = 0; i < length; ++i)
+					{
+						Assert::AreEqual(expected[i], actual[i]);
+					}
+
+					Assert::AreEqual(Simd::Reference::reduce(input.data(), length, 5, sum), Simd::reduce(input.data(), length, 5, sum));
+					Assert::AreEqual(Simd::Reference::reduce(input.data(), length, 0, min), Simd::reduce(input.data(), length, 0, min));
+					Assert::AreEqual(Simd::Reference::reduce(input.data(), length, 0, max), Simd::reduce(input.data(), length, 0, max));
+				}
+			}
+		}
+
+		TEST_METHOD(TestMinMaxMatchReferenceOnNanAndZero)
+		{
+			// Every tier must keep NaN and the sign of zero exactly as the scalar reference does, in lanes and tail alike.
+			const float nan = std::numeric_limits<float>::quiet_NaN();
+			std::vector<float> input(37);
+			for (int i = 0; i < 37; ++i)
+			{
+				input[i] = i % 3 == 0 ? nan : (i % 3 == 1 ? -0.0f : 0.5f * (i % 5) - 1.0f);
+			}
+			std::vector<double> wide(input.begin(), input.end());
+
+			Simd::Apply<float, Simd::ArithmeticMin> min(0.0f);
+			Simd::Apply<float, Simd::ArithmeticMax> max(-0.0f);
+			Simd::Apply<double, Simd::ArithmeticMin> wideMin(0.0);
+			for (int level = Simd::InstructionSetScalar; level <= Simd::InstructionSetAvx512; ++level)
+			{
+				Simd::limitInstructionSet(static_cast<Simd::InstructionSet>(level));
+				std::vector<float> expected(37), actual(37);
+				Simd::Reference::map(input.data(), 37, expected.data(), min);
+				Simd::map(input.data(), 37, actual.data(), min);
+				Assert::IsTrue(std::memcmp(expected.data(), actual.data(), 37 * sizeof(float)) == 0);
+
+				Simd::Reference::map(input.data(), 37, expected.data(), max);
+				Simd::map(input.data(), 37, actual.data(), max);
+				Assert::IsTrue(std::memcmp(expected.data(), actual.data(), 37 * sizeof(float)) == 0);
+
+				std::vector<double> wideExpected(37), wideActual(37);
+				Simd::Reference::map(wide.data(), 37, wideExpected.data(), wideMin);
+				Simd::map(wide.data(), 37, wideActual.data(), wideMin);
+				Assert::IsTrue(std::memcmp(wideExpected.data(), wideActual.data(), 37 * sizeof(double)) == 0);
+			}
+		}
+
+		TEST_METHOD(TestDoubleFilterAndMax)
+		{
+			std::vector<double> input(29);
+			for (int i = 0; i < 29; ++i)
+			{
+				input[i] = (i % 7) * 0.5;
+			}
+
+			std::vector<double> output(29);
+			Simd::GreaterThan<double> predicate(1.0);
+			int count = Simd::filter(input.data(), 29, output.data(), predicate);
+
+			Assert::AreEqual(Simd::Reference::count(input.data(), 29, predicate), count);
+			Simd::Max<double> max;
+			Assert::AreEqual(3.0, Simd::reduce(input.data(), 29, -1.0, max));
+		}
+
+		TEST_METHOD(TestMutableListPipelineKernels)
+		{
+			std::vector<int> input = makeInput(101);
+			MutableList<int> list(input.data(), 101);
+
+			MutableList<int> filtered = list.filter(Simd::GreaterThan<int>(2)).toMutableList();
+			MutableList<int> expected = list.filter([](int x){return x > 2; }).toMutableList();
+			Assert::AreEqual(expected.getLength(), filtered.getLength());
+			for (int i = 0; i < expected.getLength(); ++i)
+			{
+				Assert::AreEqual(expected.at(i), filtered.at(i));
+			}
+
+			MutableList<int> mapped = list.map<int>(Simd::Add<int>(4)).toMutableList();
+			Assert::AreEqual(101, mapped.getLength());
+			Assert::AreEqual(input[100] + 4, mapped.at(100));
+
+			int sum = list.foldLeft<int>(0, Simd::Sum<int>());
+			Assert::AreEqual(list.foldLeft<int>(0, [](int a, int x){return a + x; }), sum);
+
+			int count = list.filter(Simd::GreaterThan<int>(2)).foldLeft<int>(0, Simd::Count());
+			Assert::AreEqual(expected.getLength(), count);
+
+			// A selective filter gives back the buffer it compacted into.
+			MutableList<int> big;
+			for (int i = 0; i < 100000; ++i) big.append(i);
+			MutableList<int> few = big.filter(Simd::LessThan<int>(10)).toMutableList();
+			Assert::AreEqual(10, few.getLength());
+			Assert::AreEqual(10, few.getCapacity());
+			Assert::AreEqual(10, big.filter([](int x){return x < 10; }).toMutableList().getCapacity());
+		}
+	};
+}